@@ -0,0 +1,162 @@
+/**
+ * Rapid-prototyping protection schemes with IEC 61850
+ *
+ * Copyright (c) 2014 Steven Blair
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef BER_INTEGER_H
+#define BER_INTEGER_H
+
+#ifdef __cplusplus /* If this is a C++ compiler, use C linkage */
+extern "C" {
+#endif
+
+#include <string.h>
+#include "ctypes.h"
+#include "netOrder.h"
+
+// Width-specialised BER integer codecs. The minimal number of content octets is found with a single count-leading-zeros
+// operation, and the octets are written with a single byte swap, rather than scanning an endian buffer byte by byte.
+// Unsigned values with the most significant bit set are prefixed with a 0x00 octet, as required by X.690.
+
+#if defined(__GNUC__)
+#define BER_CLZ64(x)			__builtin_clzll(x)
+#else
+#define BER_CLZ64(x)			ber_clz64(x)
+
+// x must be non-zero
+NET_INLINE int ber_clz64(unsigned long long x) {
+	int n = 0;
+
+	if ((x & 0xFFFFFFFF00000000ULL) == 0) {n += 32; x <<= 32;}
+	if ((x & 0xFFFF000000000000ULL) == 0) {n += 16; x <<= 16;}
+	if ((x & 0xFF00000000000000ULL) == 0) {n += 8; x <<= 8;}
+	if ((x & 0xF000000000000000ULL) == 0) {n += 4; x <<= 4;}
+	if ((x & 0xC000000000000000ULL) == 0) {n += 2; x <<= 2;}
+	if ((x & 0x8000000000000000ULL) == 0) {n += 1;}
+
+	return n;
+}
+#endif
+
+// returns the number of content octets needed for a two's complement value with magnitude bits, plus one sign bit
+NET_INLINE int ber_integer_length_magnitude(unsigned long long magnitude) {
+	return (64 - BER_CLZ64((magnitude << 1) | 1) + 7) >> 3;
+}
+
+NET_INLINE int ber_integer_length_signed(long long value) {
+	return ber_integer_length_magnitude((unsigned long long) (value ^ (value >> 63)));
+}
+
+// writes the least significant "length" octets of value, in big-endian order; length must be between 1 and 8
+NET_INLINE void ber_store_integer(unsigned char *buf, unsigned long long value, int length) {
+	unsigned long long bigEndian = NET_ORDER64(value << (64 - 8 * length));
+	memcpy(buf, &bigEndian, length);
+}
+
+// reads a big-endian integer of "length" octets, sign-extended if isSigned is non-zero
+NET_INLINE unsigned long long ber_load_integer(const unsigned char *buf, int length, int isSigned) {
+	unsigned long long value = (isSigned && length > 0 && (buf[0] & 0x80)) ? ~0ULL : 0ULL;
+	int i = 0;
+
+	for (i = 0; i < length; i++) {
+		value = (value << 8) | buf[i];
+	}
+
+	return value;
+}
+
+/**
+ * Returns the number of BER content octets needed to encode value.
+ */
+NET_INLINE int ber_integer_length_int8(CTYPE_INT8 value) {return ber_integer_length_signed((signed char) value);}
+NET_INLINE int ber_integer_length_int16(CTYPE_INT16 value) {return ber_integer_length_signed(value);}
+NET_INLINE int ber_integer_length_int32(CTYPE_INT32 value) {return ber_integer_length_signed(value);}
+NET_INLINE int ber_integer_length_int64(long long value) {return ber_integer_length_signed(value);}
+NET_INLINE int ber_integer_length_int8u(CTYPE_INT8U value) {return ber_integer_length_magnitude(value);}
+NET_INLINE int ber_integer_length_int16u(CTYPE_INT16U value) {return ber_integer_length_magnitude(value);}
+NET_INLINE int ber_integer_length_int32u(CTYPE_INT32U value) {return ber_integer_length_magnitude(value);}
+NET_INLINE int ber_integer_length_int64u(unsigned long long value) {return (value >> 63) ? 9 : ber_integer_length_magnitude(value);}
+
+/**
+ * Encodes the BER content octets of value, and returns the number of octets written.
+ */
+NET_INLINE int ber_encode_integer_int8(unsigned char *buf, CTYPE_INT8 value) {
+	int length = ber_integer_length_int8(value);
+	ber_store_integer(buf, (unsigned long long) (long long) (signed char) value, length);
+	return length;
+}
+NET_INLINE int ber_encode_integer_int16(unsigned char *buf, CTYPE_INT16 value) {
+	int length = ber_integer_length_int16(value);
+	ber_store_integer(buf, (unsigned long long) (long long) value, length);
+	return length;
+}
+NET_INLINE int ber_encode_integer_int32(unsigned char *buf, CTYPE_INT32 value) {
+	int length = ber_integer_length_int32(value);
+	ber_store_integer(buf, (unsigned long long) (long long) value, length);
+	return length;
+}
+NET_INLINE int ber_encode_integer_int64(unsigned char *buf, long long value) {
+	int length = ber_integer_length_int64(value);
+	ber_store_integer(buf, (unsigned long long) value, length);
+	return length;
+}
+NET_INLINE int ber_encode_integer_int8u(unsigned char *buf, CTYPE_INT8U value) {
+	int length = ber_integer_length_int8u(value);
+	ber_store_integer(buf, value, length);
+	return length;
+}
+NET_INLINE int ber_encode_integer_int16u(unsigned char *buf, CTYPE_INT16U value) {
+	int length = ber_integer_length_int16u(value);
+	ber_store_integer(buf, value, length);
+	return length;
+}
+NET_INLINE int ber_encode_integer_int32u(unsigned char *buf, CTYPE_INT32U value) {
+	int length = ber_integer_length_int32u(value);
+	ber_store_integer(buf, value, length);
+	return length;
+}
+NET_INLINE int ber_encode_integer_int64u(unsigned char *buf, unsigned long long value) {
+	if (value >> 63) {
+		buf[0] = 0x00;
+		ber_store_integer(&buf[1], value, 8);
+		return 9;
+	}
+	else {
+		int length = ber_integer_length_magnitude(value);
+		ber_store_integer(buf, value, length);
+		return length;
+	}
+}
+
+/**
+ * Decodes "length" BER content octets. Octets which do not fit in the destination type are discarded.
+ */
+NET_INLINE CTYPE_INT8 ber_decode_integer_int8(const unsigned char *buf, int length) {return (CTYPE_INT8) ber_load_integer(buf, length, 1);}
+NET_INLINE CTYPE_INT16 ber_decode_integer_int16(const unsigned char *buf, int length) {return (CTYPE_INT16) ber_load_integer(buf, length, 1);}
+NET_INLINE CTYPE_INT32 ber_decode_integer_int32(const unsigned char *buf, int length) {return (CTYPE_INT32) ber_load_integer(buf, length, 1);}
+NET_INLINE long long ber_decode_integer_int64(const unsigned char *buf, int length) {return (long long) ber_load_integer(buf, length, 1);}
+NET_INLINE CTYPE_INT8U ber_decode_integer_int8u(const unsigned char *buf, int length) {return (CTYPE_INT8U) ber_load_integer(buf, length, 0);}
+NET_INLINE CTYPE_INT16U ber_decode_integer_int16u(const unsigned char *buf, int length) {return (CTYPE_INT16U) ber_load_integer(buf, length, 0);}
+NET_INLINE CTYPE_INT32U ber_decode_integer_int32u(const unsigned char *buf, int length) {return (CTYPE_INT32U) ber_load_integer(buf, length, 0);}
+NET_INLINE unsigned long long ber_decode_integer_int64u(const unsigned char *buf, int length) {return ber_load_integer(buf, length, 0);}
+
+#ifdef __cplusplus /* If this is a C++ compiler, end C linkage */
+}
+#endif
+
+#endif
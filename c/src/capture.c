@@ -0,0 +1,340 @@
+/**
+ * Rapid-prototyping protection schemes with IEC 61850
+ *
+ * Copyright (c) 2014 Steven Blair
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+
+#include "capture.h"
+
+#if CAPTURE_SUPPORTED == 1 && !defined(_WIN32)
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+#define CAPTURE_ROTATING			0xFFFFFFFFU		// write offset while the next file is being prepared
+#define CAPTURE_STOPPED				0xFFFFFFFEU		// write offset while no capture is open
+#define CAPTURE_BLOCK_SHB			0x0A0D0D0A
+#define CAPTURE_BLOCK_IDB			0x00000001
+#define CAPTURE_BLOCK_EPB			0x00000006
+#define CAPTURE_BYTE_ORDER_MAGIC	0x1A2B3C4D
+#define CAPTURE_LINKTYPE_ETHERNET	1
+#define CAPTURE_OPTION_FLAGS		2
+#define CAPTURE_OPTION_TSRESOL		9
+#define CAPTURE_SHB_LENGTH			28
+#define CAPTURE_IDB_LENGTH			32
+#define CAPTURE_HEADER_LENGTH		(CAPTURE_SHB_LENGTH + CAPTURE_IDB_LENGTH)
+#define CAPTURE_EPB_LENGTH(len)		(44 + (((CTYPE_INT32U) (len) + 3) & ~3U))	// 28 header, data, 8 epb_flags, 4 opt_endofopt, 4 length
+
+struct captureFile {
+	int fd;
+	unsigned char *map;
+	volatile CTYPE_INT32U pending;		// writers which may be copying into the file
+};
+
+static struct captureFile files[CAPTURE_MAX_FILES];
+static volatile int fileCount = 0;		// zero while no files are open
+static CTYPE_INT32U fileSize = 0;
+static struct captureStats stats;
+
+// number of files filled (the generation) in the top 32 bits, and the next write offset in the bottom 32 bits
+static volatile unsigned long long captureState = CAPTURE_STOPPED;
+
+// CLOCK_REALTIME receive time, in ns, of the frame being processed by the calling thread, or 0 if the backend has none
+static __thread unsigned long long receiveTime = 0;
+
+// pcapng files are written in host byte order, which readers detect from the byte-order magic
+static void capture_put16(unsigned char *buf, CTYPE_INT16U value) {
+	memcpy(buf, &value, 2);
+}
+
+static void capture_put32(unsigned char *buf, CTYPE_INT32U value) {
+	memcpy(buf, &value, 4);
+}
+
+static void capture_write_headers(unsigned char *map) {
+	// section header block, with an unknown section length
+	capture_put32(&map[0], CAPTURE_BLOCK_SHB);
+	capture_put32(&map[4], CAPTURE_SHB_LENGTH);
+	capture_put32(&map[8], CAPTURE_BYTE_ORDER_MAGIC);
+	capture_put16(&map[12], 1);
+	capture_put16(&map[14], 0);
+	capture_put32(&map[16], 0xFFFFFFFF);
+	capture_put32(&map[20], 0xFFFFFFFF);
+	capture_put32(&map[24], CAPTURE_SHB_LENGTH);
+
+	// interface description block, with nanosecond timestamps
+	map = &map[CAPTURE_SHB_LENGTH];
+	capture_put32(&map[0], CAPTURE_BLOCK_IDB);
+	capture_put32(&map[4], CAPTURE_IDB_LENGTH);
+	capture_put16(&map[8], CAPTURE_LINKTYPE_ETHERNET);
+	capture_put16(&map[10], 0);
+	capture_put32(&map[12], 0);
+	capture_put16(&map[16], CAPTURE_OPTION_TSRESOL);
+	capture_put16(&map[18], 1);
+	map[20] = 9;						// if_tsresol value, and padding
+	map[21] = 0;
+	map[22] = 0;
+	map[23] = 0;
+	capture_put32(&map[24], 0);
+	capture_put32(&map[28], CAPTURE_IDB_LENGTH);
+}
+
+// the file is extended with zeros, so padding never needs to be written
+static int capture_prepare_file(struct captureFile *file) {
+	// truncating to zero first discards the frames from the previous use of the file
+	if (ftruncate(file->fd, 0) != 0 || ftruncate(file->fd, fileSize) != 0) {
+		return -1;
+	}
+#ifdef MADV_POPULATE_WRITE
+	madvise(file->map, fileSize, MADV_POPULATE_WRITE);		// avoids page faults while frames are recorded
+#endif
+
+	capture_write_headers(file->map);
+
+	return 0;
+}
+
+static void capture_write_block(unsigned char *block, const unsigned char *buf, int len, CTYPE_INT32U blockLength, enum captureDirection direction, unsigned long long ns) {
+	CTYPE_INT32U dataLength = ((CTYPE_INT32U) len + 3) & ~3U;
+
+	capture_put32(&block[0], CAPTURE_BLOCK_EPB);
+	capture_put32(&block[4], blockLength);
+	capture_put32(&block[8], 0);
+	capture_put32(&block[12], (CTYPE_INT32U) (ns >> 32));
+	capture_put32(&block[16], (CTYPE_INT32U) ns);
+	capture_put32(&block[20], (CTYPE_INT32U) len);
+	capture_put32(&block[24], (CTYPE_INT32U) len);
+	memcpy(&block[28], buf, len);
+
+	block = &block[28 + dataLength];
+	capture_put16(&block[0], CAPTURE_OPTION_FLAGS);
+	capture_put16(&block[2], 4);
+	capture_put32(&block[4], (CTYPE_INT32U) direction);
+	capture_put32(&block[8], 0);
+	capture_put32(&block[12], blockLength);
+}
+
+// called by the one writer which found the file full, while the state is CAPTURE_ROTATING
+static void capture_rotate(CTYPE_INT32U generation, CTYPE_INT32U length) {
+	struct captureFile *full = &files[generation % fileCount];
+	struct captureFile *next = &files[(generation + 1) % fileCount];
+
+	// waits for writers which reserved space before the file was found to be full
+	while (full->pending != 0) {
+	}
+
+	// the unused end of the file is removed, so that the file is valid pcapng
+	if (ftruncate(full->fd, length) != 0) {
+		perror("capture");
+	}
+
+	stats.rotations++;
+	if (capture_prepare_file(next) != 0) {
+		perror("capture");
+		__sync_synchronize();
+		captureState = ((unsigned long long) (generation + 1) << 32) | CAPTURE_STOPPED;
+		return;
+	}
+
+	__sync_synchronize();		// the file is prepared before it is published
+	captureState = ((unsigned long long) (generation + 1) << 32) | CAPTURE_HEADER_LENGTH;
+}
+
+static unsigned long long capture_now() {
+	struct timespec ts;
+
+	clock_gettime(CLOCK_REALTIME, &ts);
+	return (unsigned long long) ts.tv_sec * 1000000000ULL + (unsigned long long) ts.tv_nsec;
+}
+
+static void capture_record(const unsigned char *buf, int len, enum captureDirection direction, unsigned long long ns) {
+	CTYPE_INT32U blockLength = CAPTURE_EPB_LENGTH(len);
+	unsigned long long state = 0;
+	CTYPE_INT32U generation = 0;
+	CTYPE_INT32U offset = 0;
+	int count = 0;
+	struct captureFile *file = NULL;
+
+	while (1) {
+		state = captureState;
+		generation = (CTYPE_INT32U) (state >> 32);
+		offset = (CTYPE_INT32U) state;
+		count = fileCount;		// read once, as capture_close() may unmap the files since the state was read
+
+		if (offset == CAPTURE_STOPPED || count == 0 || blockLength > fileSize - CAPTURE_HEADER_LENGTH) {
+			__sync_fetch_and_add(&stats.drops, 1);
+			return;
+		}
+		if (offset == CAPTURE_ROTATING) {
+			continue;		// another writer is preparing the next file, which only takes a few system calls
+		}
+
+		// the file cannot be truncated by capture_rotate() while pending is non-zero
+		file = &files[generation % count];
+		__sync_fetch_and_add(&file->pending, 1);
+
+		if (offset + blockLength > fileSize) {
+			__sync_fetch_and_sub(&file->pending, 1);
+
+			// the first writer to find the file full prepares the next one
+			if (__sync_bool_compare_and_swap(&captureState, state, ((unsigned long long) generation << 32) | CAPTURE_ROTATING)) {
+				capture_rotate(generation, offset);
+			}
+			continue;
+		}
+
+		if (__sync_bool_compare_and_swap(&captureState, state, state + blockLength)) {
+			capture_write_block(&file->map[offset], buf, len, blockLength, direction, ns);
+			__sync_fetch_and_sub(&file->pending, 1);
+			__sync_fetch_and_add(&stats.frames, 1);
+			__sync_fetch_and_add(&stats.bytes, (unsigned long long) len);
+			return;
+		}
+
+		__sync_fetch_and_sub(&file->pending, 1);
+	}
+}
+
+void capture_frame(const unsigned char *buf, int len, enum captureDirection direction) {
+	capture_record(buf, len, direction, capture_now());
+}
+
+void capture_receive_time(unsigned long long ns) {
+	receiveTime = ns;
+}
+
+void capture_received_frame(const unsigned char *buf, int len) {
+	unsigned long long ns = receiveTime;
+
+	// frames from backends without receive timestamps are timed here, which is still before they are decoded
+	if (ns == 0) {
+		ns = capture_now();
+	}
+	receiveTime = 0;
+
+	capture_record(buf, len, CAPTURE_RECEIVED, ns);
+}
+
+static void capture_unmap_files() {
+	int i = 0;
+
+	for (i = 0; i < CAPTURE_MAX_FILES; i++) {
+		if (files[i].map != NULL) {
+			munmap(files[i].map, fileSize);
+			files[i].map = NULL;
+		}
+		if (files[i].fd >= 0) {
+			close(files[i].fd);
+			files[i].fd = -1;
+		}
+	}
+
+	fileCount = 0;
+}
+
+int capture_open(const char *prefix, unsigned int size, int count) {
+	char name[1024];
+	int i = 0;
+
+	if ((CTYPE_INT32U) captureState != CAPTURE_STOPPED || fileCount > 0 || count < 1 || count > CAPTURE_MAX_FILES || size < CAPTURE_HEADER_LENGTH + CAPTURE_EPB_LENGTH(0) || size >= CAPTURE_STOPPED) {
+		return -1;
+	}
+
+	memset(files, 0, sizeof(files));
+	for (i = 0; i < CAPTURE_MAX_FILES; i++) {
+		files[i].fd = -1;
+	}
+	memset(&stats, 0, sizeof(stats));
+	fileCount = count;
+	fileSize = size & ~3U;		// blocks are 32-bit aligned
+
+	// all files are mapped in advance, so that rotation does not need to map memory
+	for (i = 0; i < count; i++) {
+		snprintf(name, sizeof(name), "%s.%d.pcapng", prefix, i);
+		files[i].fd = open(name, O_RDWR | O_CREAT | O_TRUNC, 0644);
+		if (files[i].fd < 0) {
+			perror(name);
+			capture_unmap_files();
+			return -1;
+		}
+
+		files[i].map = (unsigned char *) mmap(NULL, fileSize, PROT_READ | PROT_WRITE, MAP_SHARED, files[i].fd, 0);
+		if (files[i].map == MAP_FAILED) {
+			files[i].map = NULL;
+			perror(name);
+			capture_unmap_files();
+			return -1;
+		}
+	}
+
+	if (capture_prepare_file(&files[0]) != 0) {
+		perror("capture");
+		capture_unmap_files();
+		return -1;
+	}
+
+	__sync_synchronize();
+	captureState = CAPTURE_HEADER_LENGTH;
+
+	return 0;
+}
+
+void capture_close() {
+	unsigned long long state = 0;
+	CTYPE_INT32U offset = 0;
+
+	// stops further reservations, after any rotation in progress
+	while (1) {
+		state = captureState;
+		offset = (CTYPE_INT32U) state;
+
+		if (offset == CAPTURE_STOPPED) {
+			break;
+		}
+		if (offset != CAPTURE_ROTATING && __sync_bool_compare_and_swap(&captureState, state, (state & 0xFFFFFFFF00000000ULL) | CAPTURE_STOPPED)) {
+			break;
+		}
+	}
+
+	if (fileCount == 0) {
+		return;
+	}
+
+	if (offset != CAPTURE_STOPPED) {
+		struct captureFile *file = &files[(CTYPE_INT32U) (state >> 32) % fileCount];
+
+		while (file->pending != 0) {
+		}
+		if (ftruncate(file->fd, offset) != 0) {
+			perror("capture");
+		}
+	}
+
+	capture_unmap_files();
+	captureState = CAPTURE_STOPPED;
+}
+
+void capture_get_stats(struct captureStats *captureStats) {
+	*captureStats = stats;
+}
+
+#endif
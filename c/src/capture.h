@@ -0,0 +1,102 @@
+/**
+ * Rapid-prototyping protection schemes with IEC 61850
+ *
+ * Copyright (c) 2014 Steven Blair
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+
+#ifndef CAPTURE_H
+#define CAPTURE_H
+
+#ifdef __cplusplus /* If this is a C++ compiler, use C linkage */
+extern "C" {
+#endif
+
+#include "ctypes.h"
+
+// In-process recorder of every GOOSE and SV frame sent (through net_backend_send()) and received (through
+// gse_sv_packet_filter()), for post-fault analysis without running a separate capture process. Frames are appended to
+// a rotating set of memory-mapped pcapng files, named <prefix>.<n>.pcapng. Space for each block is reserved with a
+// single compare-and-swap, so frames can be recorded from several threads without locks, and recording a frame costs
+// one memcpy() plus a few stores. When a file is full it is truncated to the data written, and the oldest file in the
+// set is reused.
+
+#if CAPTURE_SUPPORTED == 1 && !defined(_WIN32)
+
+#define CAPTURE_MAX_FILES			64
+#define CAPTURE_DEFAULT_FILE_SIZE	(64 * 1024 * 1024)
+#define CAPTURE_DEFAULT_FILES		8
+
+enum captureDirection {
+	CAPTURE_RECEIVED = 1,		// values of the pcapng epb_flags direction bits
+	CAPTURE_SENT = 2
+};
+
+struct captureStats {
+	unsigned long long frames;		// frames recorded
+	unsigned long long bytes;		// frame bytes recorded
+	unsigned long long drops;		// frames which were larger than a file, or were recorded while no capture was open
+	unsigned long long rotations;	// files filled
+};
+
+/**
+ * Starts recording, to fileCount files of fileSize bytes each. Any existing files with the same names are replaced.
+ * Returns 0 on success, or -1 on failure.
+ */
+int capture_open(const char *prefix, unsigned int fileSize, int fileCount);
+
+/**
+ * Stops recording, and truncates the present file to the data written.
+ */
+void capture_close();
+
+/**
+ * Records a frame, with the present time.
+ */
+void capture_frame(const unsigned char *buf, int len, enum captureDirection direction);
+
+/**
+ * Sets the CLOCK_REALTIME receive time, in ns, of the next frame which the calling thread passes to
+ * gse_sv_packet_filter(), from the network backend's timestamp (e.g., from pcap_pkthdr or the packet ring).
+ */
+void capture_receive_time(unsigned long long ns);
+
+/**
+ * Records a received frame, with the time given to capture_receive_time(), or with the present time if the backend
+ * did not give one. Called by gse_sv_packet_filter() before the frame is decoded.
+ */
+void capture_received_frame(const unsigned char *buf, int len);
+
+void capture_get_stats(struct captureStats *stats);
+
+#define CAPTURE_FRAME(buf, len, direction)		capture_frame(buf, len, direction)
+#define CAPTURE_RECEIVE_TIME(ns)				capture_receive_time(ns)
+#define CAPTURE_RECEIVED_FRAME(buf, len)		capture_received_frame(buf, len)
+
+#else
+
+#define CAPTURE_FRAME(buf, len, direction)
+#define CAPTURE_RECEIVE_TIME(ns)
+#define CAPTURE_RECEIVED_FRAME(buf, len)
+
+#endif
+
+#ifdef __cplusplus /* If this is a C++ compiler, end C linkage */
+}
+#endif
+
+#endif
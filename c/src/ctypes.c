@@ -21,6 +21,9 @@
 #include "ctypes.h"
 #include "gse.h"
 #include "sv.h"
+#include "latency.h"
+#include "netOrder.h"
+#include "capture.h"
 #if TIMESTAMP_SUPPORTED == 1
 #include <sys\time.h>
 #endif
@@ -29,6 +32,7 @@
 
 unsigned char	LOCAL_MAC_ADDRESS[] = LOCAL_MAC_ADDRESS_VALUE;
 
+// generic BER integer functions; berInteger.h has faster versions for each integer width
 int ber_integer_length(void *value, int maxLength) {
 	unsigned char	endian_buf[ENDIAN_BUFFER_SIZE] = {0};
 	netmemcpy(endian_buf, value, maxLength);	// ensure bytes are in big-endian order
@@ -167,8 +171,8 @@ void setTimestamp(CTYPE_TIMESTAMP *dest) {
 	gettimeofday(&tv, NULL);
 	frac = (CTYPE_INT32U) ((float) tv.tv_usec * 4294.967296);	// * 2^32 / 1000000;
 
-	netmemcpy(&buf[0], &tv.tv_sec, 4);
-	netmemcpy(&buf[4], &frac, 4);
+	net_store32(&buf[0], (CTYPE_INT32U) tv.tv_sec);
+	net_store32(&buf[4], frac);
 
 	buf[7] = 0x18;	// quality: 24 bits of accuracy
 #endif
@@ -176,13 +180,19 @@ void setTimestamp(CTYPE_TIMESTAMP *dest) {
 
 // if the recommended MAC address ranges are used, this function filters GOOSE and SV packets
 void gse_sv_packet_filter(unsigned char *buf, int len) {
+	LATENCY_FRAME_DISPATCHED();
+
 	if (buf[0] == 0x01 && buf[1] == 0x0C && buf[2] == 0xCD) {
+		// frames are recorded before decoding, with the backend's receive time, so that the recorded time does not
+		// include decoding or datasetDecodeDone()
 		if (buf[3] == 0x01) {
 			//GOOSE: 01-0C-CD-01-00-00 to 01-0C-CD-01-01-FF
+			CAPTURE_RECEIVED_FRAME(buf, len);
 			gseDecode(buf, len);
 		}
 		else if (buf[3] == 0x04) {
 			//SV: 01-0C-CD-04-00-00 to 01-0C-CD-04-01-FF
+			CAPTURE_RECEIVED_FRAME(buf, len);
 			svDecode(buf, len);
 		}
 	}
@@ -190,7 +200,7 @@ void gse_sv_packet_filter(unsigned char *buf, int len) {
 
 // copies bytes to network format (big-endian)
 void netmemcpy(void *dst, const void *src, unsigned int len) {
-#ifdef PLATFORM_LITTLE_ENDIAN
+#if PLATFORM_LITTLE_ENDIAN == 1
 	reversememcpy((unsigned char *) dst, (const unsigned char *) src, len);
 #else
 	memcpy((unsigned char *) dst, (const unsigned char *) src, len);
@@ -199,7 +209,7 @@ void netmemcpy(void *dst, const void *src, unsigned int len) {
 
 // copies bytes to host format (little-endian)
 void hostmemcpy(void *dst, const void *src, unsigned int len) {
-#ifdef PLATFORM_LITTLE_ENDIAN
+#if PLATFORM_LITTLE_ENDIAN == 1
 	memcpy((unsigned char *) dst, (const unsigned char *) src, len);
 #else
 	reversememcpy((unsigned char *) dst, (const unsigned char *) src, len);
@@ -27,13 +27,26 @@ extern "C" {
 
 #include <string.h>
 
+#ifndef PLATFORM_LITTLE_ENDIAN				// define as 0 or 1 to override detection of the target byte order
+#if (defined(__BYTE_ORDER__) && defined(__ORDER_BIG_ENDIAN__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__) || defined(__BIG_ENDIAN__) || defined(__ARMEB__) || defined(__MIPSEB__)
+#define PLATFORM_LITTLE_ENDIAN	0
+#else
 #define PLATFORM_LITTLE_ENDIAN	1
+#endif
+#endif
 #define TIMESTAMP_SUPPORTED		0
 #define GOOSE_FIXED_SIZE		0	// set to 1 to enable fixed-sized GOOSE encoding, which is slightly more efficient to encode.
 #define HIGH_LEVEL_INTERFACE	0	//
 #define JSON_INTERFACE			1	// set to 1 to enable the JSON-based web interface over HTTP
+#define LATENCY_STATS_SUPPORTED	0	// set to 1 to record per-control-block latency histograms, using kernel timestamps on Linux
+#define PACKET_RING_SUPPORTED	0	// set to 1 to allow receiving with a TPACKET_V3 memory-mapped ring on Linux (see packetRing.h)
+#define INPUT_SEQLOCK_SUPPORTED	0	// set to 1 to publish each subscribed dataset atomically, for consistent snapshots from other threads
+#define EVENT_QUEUE_SUPPORTED	0	// set to 1 to allow decoded GSE and SV events to be queued for application threads (see eventQueue.h)
+#define REALTIME_PROFILE_SUPPORTED	0	// set to 1 for memory locking, CPU pinning, SCHED_FIFO and busy-polling receive on Linux (see realtime.h)
+#define CAPTURE_SUPPORTED		0	// set to 1 to allow recording of all sent and received GOOSE and SV frames to pcapng files (see capture.h)
 
-#define LOCAL_MAC_ADDRESS_VALUE	{0x01, 0x0C, 0xCD, 0x01, 0x00, 0x02}
+#define LOCAL_MAC_ADDRESS_BYTES	0x01, 0x0C, 0xCD, 0x01, 0x00, 0x02
+#define LOCAL_MAC_ADDRESS_VALUE	{LOCAL_MAC_ADDRESS_BYTES}
 
 // platform-specific data types to conform to SV type sizes (Table 14 in IEC 61850-9-2)
 #define CTYPE_BOOLEAN		unsigned char
@@ -92,19 +105,19 @@ extern "C" {
 #define BER_GET_LENGTH_CTYPE_QUALITY(x)			(3)
 #define BER_GET_LENGTH_CTYPE_DBPOS(x)			(SV_GET_LENGTH_DBPOS)
 #else
-// BER datatype sizes, which are dependent on the actual data
+// BER datatype sizes, which are dependent on the actual data (see berInteger.h)
 #define BER_GET_LENGTH_CTYPE_FLOAT32(x)			(SV_GET_LENGTH_FLOAT32 + 1)		// + 1 byte for number of exponent bits
 #define BER_GET_LENGTH_CTYPE_FLOAT64(x)			(SV_GET_LENGTH_FLOAT64 + 1)		// + 1 byte for number of exponent bits
 #define BER_GET_LENGTH_CTYPE_TIMESTAMP(x)		(SV_GET_LENGTH_TIMESTAMP)
-#define BER_GET_LENGTH_CTYPE_INT8(x)			(ber_integer_length((x), SV_GET_LENGTH_INT8))
-#define BER_GET_LENGTH_CTYPE_INT16(x)			(ber_integer_length((x), SV_GET_LENGTH_INT16))
-#define BER_GET_LENGTH_CTYPE_INT32(x)			(ber_integer_length((x), SV_GET_LENGTH_INT32))
-#define BER_GET_LENGTH_CTYPE_INT8U(x)			(ber_integer_length((x), SV_GET_LENGTH_INT8U))
-#define BER_GET_LENGTH_CTYPE_INT16U(x)			(ber_integer_length((x), SV_GET_LENGTH_INT16U))
-#define BER_GET_LENGTH_CTYPE_INT32U(x)			(ber_integer_length((x), SV_GET_LENGTH_INT32U))
+#define BER_GET_LENGTH_CTYPE_INT8(x)			(ber_integer_length_int8(*(x)))
+#define BER_GET_LENGTH_CTYPE_INT16(x)			(ber_integer_length_int16(*(x)))
+#define BER_GET_LENGTH_CTYPE_INT32(x)			(ber_integer_length_int32(*(x)))
+#define BER_GET_LENGTH_CTYPE_INT8U(x)			(ber_integer_length_int8u(*(x)))
+#define BER_GET_LENGTH_CTYPE_INT16U(x)			(ber_integer_length_int16u(*(x)))
+#define BER_GET_LENGTH_CTYPE_INT32U(x)			(ber_integer_length_int32u(*(x)))
 #define BER_GET_LENGTH_CTYPE_VISSTRING255(x)	(SV_GET_LENGTH_VISSTRING255)
 #define BER_GET_LENGTH_CTYPE_BOOLEAN(x)			(SV_GET_LENGTH_BOOLEAN)
-#define BER_GET_LENGTH_CTYPE_ENUM(x)			(ber_integer_length((x), SV_GET_LENGTH_ENUM))
+#define BER_GET_LENGTH_CTYPE_ENUM(x)			(ber_integer_length_int32((CTYPE_INT32) *(x)))
 #define BER_GET_LENGTH_CTYPE_QUALITY(x)			(2 + 1)		// + 1 byte for padding
 #define BER_GET_LENGTH_CTYPE_DBPOS(x)			(SV_GET_LENGTH_DBPOS)
 #endif
@@ -26,6 +26,9 @@ extern "C" {
 #endif
 
 #include "ctypes.h"
+#include "latency.h"
+#include "seqlock.h"
+#include "eventQueue.h"
 
 
 // enums
@@ -221,6 +224,15 @@ struct LPHDa {
 		struct E1Q1SB1_C1_smv E1Q1SB1_C1_smv[2];
 		void (*datasetDecodeDone)(CTYPE_INT16U smpCnt);
 		CTYPE_INT16U smpCnt;
+#if LATENCY_STATS_SUPPORTED == 1
+		struct latencyStats latency;
+#endif
+#if INPUT_SEQLOCK_SUPPORTED == 1
+		struct seqlock seqlock;
+#endif
+#if EVENT_QUEUE_SUPPORTED == 1
+		struct eventQueue *eventQueue;
+#endif
 	} sv_inputs_Volt;
 };
 struct CSWIa {
@@ -246,6 +258,15 @@ struct exampleMMXU {
 		struct E1Q1SB1_C1_rmxu E1Q1SB1_C1_rmxu[16];
 		void (*datasetDecodeDone)(CTYPE_INT16U smpCnt);
 		CTYPE_INT16U smpCnt;
+#if LATENCY_STATS_SUPPORTED == 1
+		struct latencyStats latency;
+#endif
+#if INPUT_SEQLOCK_SUPPORTED == 1
+		struct seqlock seqlock;
+#endif
+#if EVENT_QUEUE_SUPPORTED == 1
+		struct eventQueue *eventQueue;
+#endif
 	} sv_inputs_rmxuCB;
 	struct {
 		struct E1Q1SB1_C1_Performance E1Q1SB1_C1_Performance;
@@ -254,11 +275,29 @@ struct exampleMMXU {
 		CTYPE_TIMESTAMP T;
 		CTYPE_INT32U stNum;
 		CTYPE_INT32U sqNum;
+#if LATENCY_STATS_SUPPORTED == 1
+		struct latencyStats latency;
+#endif
+#if INPUT_SEQLOCK_SUPPORTED == 1
+		struct seqlock seqlock;
+#endif
+#if EVENT_QUEUE_SUPPORTED == 1
+		struct eventQueue *eventQueue;
+#endif
 	} gse_inputs_Performance;
 	struct {
 		struct E1Q1SB1_C1_Performance E1Q1SB1_C1_Performance;
 		void (*datasetDecodeDone)(CTYPE_INT16U smpCnt);
 		CTYPE_INT16U smpCnt;
+#if LATENCY_STATS_SUPPORTED == 1
+		struct latencyStats latency;
+#endif
+#if INPUT_SEQLOCK_SUPPORTED == 1
+		struct seqlock seqlock;
+#endif
+#if EVENT_QUEUE_SUPPORTED == 1
+		struct eventQueue *eventQueue;
+#endif
 	} sv_inputs_PerformanceSV;
 };
 struct exampleRMXU {
@@ -292,6 +331,15 @@ struct RSYNa {
 		struct E1Q1SB1_C1_smv E1Q1SB1_C1_smv[2];
 		void (*datasetDecodeDone)(CTYPE_INT16U smpCnt);
 		CTYPE_INT16U smpCnt;
+#if LATENCY_STATS_SUPPORTED == 1
+		struct latencyStats latency;
+#endif
+#if INPUT_SEQLOCK_SUPPORTED == 1
+		struct seqlock seqlock;
+#endif
+#if EVENT_QUEUE_SUPPORTED == 1
+		struct eventQueue *eventQueue;
+#endif
 	} sv_inputs_Volt;
 	struct {
 		struct E1Q1SB1_C1_Positions E1Q1SB1_C1_Positions;
@@ -300,6 +348,15 @@ struct RSYNa {
 		CTYPE_TIMESTAMP T;
 		CTYPE_INT32U stNum;
 		CTYPE_INT32U sqNum;
+#if LATENCY_STATS_SUPPORTED == 1
+		struct latencyStats latency;
+#endif
+#if INPUT_SEQLOCK_SUPPORTED == 1
+		struct seqlock seqlock;
+#endif
+#if EVENT_QUEUE_SUPPORTED == 1
+		struct eventQueue *eventQueue;
+#endif
 	} gse_inputs_AnotherPositions;
 	struct {
 		struct E1Q1SB1_C1_Positions E1Q1SB1_C1_Positions;
@@ -308,6 +365,15 @@ struct RSYNa {
 		CTYPE_TIMESTAMP T;
 		CTYPE_INT32U stNum;
 		CTYPE_INT32U sqNum;
+#if LATENCY_STATS_SUPPORTED == 1
+		struct latencyStats latency;
+#endif
+#if INPUT_SEQLOCK_SUPPORTED == 1
+		struct seqlock seqlock;
+#endif
+#if EVENT_QUEUE_SUPPORTED == 1
+		struct eventQueue *eventQueue;
+#endif
 	} gse_inputs_ItlPositions;
 };
 
@@ -25,6 +25,9 @@
 extern "C" {
 #endif
 
+#include "ctypes.h"
+#include "berInteger.h"
+
 int getLengthFieldSize(unsigned char byte);
 int decodeLength(unsigned char *buf);
 
@@ -26,6 +26,7 @@ extern "C" {
 #endif
 
 #include "ctypes.h"
+#include "berInteger.h"
 
 int getLengthBytes(int len);
 int encodeLength(unsigned char *buf, CTYPE_INT16U len);
@@ -0,0 +1,133 @@
+/**
+ * Rapid-prototyping protection schemes with IEC 61850
+ *
+ * Copyright (c) 2014 Steven Blair
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+
+#include "eventQueue.h"
+
+#if EVENT_QUEUE_SUPPORTED == 1
+
+#include <string.h>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define EVENT_QUEUE_BARRIER()				_ReadWriteBarrier()		// x86 does not reorder loads with loads, or stores with stores
+#define EVENT_QUEUE_CAS(ptr, old, new)		(_InterlockedCompareExchange((volatile long *) (ptr), (long) (new), (long) (old)) == (long) (old))
+#define EVENT_QUEUE_INCREMENT(ptr)			_InterlockedIncrement64((volatile __int64 *) (ptr))
+#else
+#define EVENT_QUEUE_BARRIER()				__sync_synchronize()
+#define EVENT_QUEUE_CAS(ptr, old, new)		__sync_bool_compare_and_swap(ptr, old, new)
+#define EVENT_QUEUE_INCREMENT(ptr)			__sync_fetch_and_add(ptr, 1)
+#endif
+
+void event_queue_init(struct eventQueue *queue, int multiProducer) {
+	memset(queue, 0, sizeof(struct eventQueue));
+	queue->multiProducer = multiProducer;
+}
+
+int event_queue_push(struct eventQueue *queue, const struct inputEvent *event) {
+	struct eventQueueSlot *slot = NULL;
+	CTYPE_INT32U head = 0;
+
+	// a slot can be reused as soon as the consumer has moved tail past it
+	if (queue->multiProducer) {
+		do {
+			head = queue->head;
+			if (head - queue->tail >= EVENT_QUEUE_SLOTS) {
+				EVENT_QUEUE_INCREMENT(&queue->overflows);
+				return -1;
+			}
+		} while (!EVENT_QUEUE_CAS(&queue->head, head, head + 1));
+	}
+	else {
+		head = queue->head;
+		if (head - queue->tail >= EVENT_QUEUE_SLOTS) {
+			queue->overflows++;
+			return -1;
+		}
+		queue->head = head + 1;
+	}
+
+	slot = &queue->slots[head & (EVENT_QUEUE_SLOTS - 1)];
+	EVENT_QUEUE_BARRIER();		// the slot is written after tail was read
+	slot->event = *event;
+	EVENT_QUEUE_BARRIER();		// the event is published before the sequence
+	slot->sequence = head + 1;
+
+	return 0;
+}
+
+int event_queue_push_gse(struct eventQueue *queue, void *inputs, const char *name, CTYPE_TIMESTAMP T, CTYPE_INT32U stNum, CTYPE_INT32U sqNum) {
+	struct inputEvent event;
+
+	event.name = name;
+	event.inputs = inputs;
+	event.type = INPUT_EVENT_GSE;
+	event.smpCnt = 0;
+	event.stNum = stNum;
+	event.sqNum = sqNum;
+	event.T = T;
+
+	return event_queue_push(queue, &event);
+}
+
+int event_queue_push_sv(struct eventQueue *queue, void *inputs, const char *name, CTYPE_INT16U smpCnt) {
+	struct inputEvent event;
+
+	event.name = name;
+	event.inputs = inputs;
+	event.type = INPUT_EVENT_SV;
+	event.smpCnt = smpCnt;
+	event.stNum = 0;
+	event.sqNum = 0;
+	event.T = 0;
+
+	return event_queue_push(queue, &event);
+}
+
+int event_queue_pop_batch(struct eventQueue *queue, struct inputEvent *events, int maxEvents) {
+	CTYPE_INT32U tail = queue->tail;
+	int count = 0;
+
+	// stops at the first slot which has not been published, even if later slots have been, so that order is kept
+	while (count < maxEvents) {
+		struct eventQueueSlot *slot = &queue->slots[tail & (EVENT_QUEUE_SLOTS - 1)];
+
+		if (slot->sequence != tail + 1) {
+			break;
+		}
+		EVENT_QUEUE_BARRIER();		// the event is read after the sequence
+		events[count] = slot->event;
+		tail++;
+		count++;
+	}
+
+	if (count > 0) {
+		EVENT_QUEUE_BARRIER();		// slots are released after they have been read
+		queue->tail = tail;
+	}
+
+	return count;
+}
+
+unsigned long long event_queue_overflows(struct eventQueue *queue) {
+	return queue->overflows;
+}
+
+#endif
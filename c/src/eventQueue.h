@@ -0,0 +1,108 @@
+/**
+ * Rapid-prototyping protection schemes with IEC 61850
+ *
+ * Copyright (c) 2014 Steven Blair
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+
+#ifndef EVENT_QUEUE_H
+#define EVENT_QUEUE_H
+
+#ifdef __cplusplus /* If this is a C++ compiler, use C linkage */
+extern "C" {
+#endif
+
+#include "ctypes.h"
+
+// Bounded lock-free queues of decoded GSE and SV events, so that application logic can run on its own threads rather
+// than in datasetDecodeDone() on the receive thread. Each subscribed inputs structure has an eventQueue pointer; if it
+// is set, an event is pushed after each GSE frame, or after the last ASDU of each SV frame, is decoded. The receive
+// thread never waits: if a queue is full, the event is discarded and counted as an overflow.
+
+#if EVENT_QUEUE_SUPPORTED == 1
+
+#define EVENT_QUEUE_SLOTS			1024	// must be a power of two
+#define EVENT_QUEUE_CACHE_LINE		64
+
+enum inputEventType {
+	INPUT_EVENT_GSE = 0,
+	INPUT_EVENT_SV
+};
+
+struct inputEvent {
+	const char *name;			// path of the subscribed inputs in the data model, e.g. "D1Q1SB4.S1.C1.LPHDa_1.sv_inputs_Volt"
+	void *inputs;				// the subscribed inputs structure (use the generated *_inputs_snapshot_*() functions for a consistent copy)
+	enum inputEventType type;
+	CTYPE_INT16U smpCnt;		// SV only
+	CTYPE_INT32U stNum;			// GSE only
+	CTYPE_INT32U sqNum;			// GSE only
+	CTYPE_TIMESTAMP T;			// GSE only
+};
+
+struct eventQueueSlot {
+	volatile CTYPE_INT32U sequence;		// index of the event in the slot, plus one, once it has been published
+	struct inputEvent event;
+};
+
+struct eventQueue {
+	volatile CTYPE_INT32U head;			// next slot to be written; reserved with compare-and-swap if multiProducer is set
+	int multiProducer;
+	volatile unsigned long long overflows;
+	unsigned char padding[EVENT_QUEUE_CACHE_LINE];	// keeps the producer and consumer indexes in separate cache lines
+	volatile CTYPE_INT32U tail;			// next slot to be read; only modified by the consuming thread
+	struct eventQueueSlot slots[EVENT_QUEUE_SLOTS];
+};
+
+/**
+ * Empties a queue. multiProducer must be non-zero if events may be pushed from more than one thread, such as when
+ * receiving with packet_ring_start_workers(). Each queue must only have one consuming thread.
+ */
+void event_queue_init(struct eventQueue *queue, int multiProducer);
+
+/**
+ * Pushes an event. Returns 0 on success, or -1 if the queue is full.
+ */
+int event_queue_push(struct eventQueue *queue, const struct inputEvent *event);
+int event_queue_push_gse(struct eventQueue *queue, void *inputs, const char *name, CTYPE_TIMESTAMP T, CTYPE_INT32U stNum, CTYPE_INT32U sqNum);
+int event_queue_push_sv(struct eventQueue *queue, void *inputs, const char *name, CTYPE_INT16U smpCnt);
+
+/**
+ * Copies up to maxEvents events, in the order they were pushed, and removes them from the queue. Returns the number of
+ * events copied, which is 0 if the queue is empty. Must only be called from the consuming thread.
+ */
+int event_queue_pop_batch(struct eventQueue *queue, struct inputEvent *events, int maxEvents);
+
+/**
+ * Returns the number of events which have been discarded because the queue was full.
+ */
+unsigned long long event_queue_overflows(struct eventQueue *queue);
+
+#define EVENT_QUEUE_GSE(queue, inputs, name, T, stNum, sqNum)	((queue) != NULL ? event_queue_push_gse(queue, inputs, name, T, stNum, sqNum) : 0)
+#define EVENT_QUEUE_SV(queue, inputs, name, smpCnt)				((queue) != NULL ? event_queue_push_sv(queue, inputs, name, smpCnt) : 0)
+
+#else
+
+#define EVENT_QUEUE_GSE(queue, inputs, name, T, stNum, sqNum)
+#define EVENT_QUEUE_SV(queue, inputs, name, smpCnt)
+
+#endif
+
+#ifdef __cplusplus /* If this is a C++ compiler, end C linkage */
+}
+#endif
+
+#endif
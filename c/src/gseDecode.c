@@ -343,6 +343,7 @@ int ber_decode_D1Q1SB4_C1_MMXUResult(unsigned char *buf, struct D1Q1SB4_C1_MMXUR
 void gseDecodeDataset(unsigned char *dataset, CTYPE_INT16U datasetLength, unsigned char *gocbRef, CTYPE_INT16U gocbRefLength, CTYPE_INT32U timeAllowedToLive, CTYPE_TIMESTAMP T, CTYPE_INT32U stNum, CTYPE_INT32U sqNum) {
 
 	if (gocbRefLength == 29 && strncmp((const char *) gocbRef, "E1Q1SB1C1/LLN0$GO$Performance", gocbRefLength) == 0) {
+		SEQLOCK_WRITE_BEGIN(&D1Q1SB4.S1.C1.exampleMMXU_1.gse_inputs_Performance.seqlock);
 		if (stNum != D1Q1SB4.S1.C1.exampleMMXU_1.gse_inputs_Performance.stNum) {
 			ber_decode_E1Q1SB1_C1_Performance(dataset, &D1Q1SB4.S1.C1.exampleMMXU_1.gse_inputs_Performance.E1Q1SB1_C1_Performance);
 		}
@@ -350,11 +351,16 @@ void gseDecodeDataset(unsigned char *dataset, CTYPE_INT16U datasetLength, unsign
 		D1Q1SB4.S1.C1.exampleMMXU_1.gse_inputs_Performance.T = T;
 		D1Q1SB4.S1.C1.exampleMMXU_1.gse_inputs_Performance.stNum = stNum;
 		D1Q1SB4.S1.C1.exampleMMXU_1.gse_inputs_Performance.sqNum = sqNum;
+		SEQLOCK_WRITE_END(&D1Q1SB4.S1.C1.exampleMMXU_1.gse_inputs_Performance.seqlock);
+		EVENT_QUEUE_GSE(D1Q1SB4.S1.C1.exampleMMXU_1.gse_inputs_Performance.eventQueue, &D1Q1SB4.S1.C1.exampleMMXU_1.gse_inputs_Performance, "D1Q1SB4.S1.C1.exampleMMXU_1.gse_inputs_Performance", T, stNum, sqNum);
+		LATENCY_FRAME_DECODED();
 		if (D1Q1SB4.S1.C1.exampleMMXU_1.gse_inputs_Performance.datasetDecodeDone != NULL) {
 			D1Q1SB4.S1.C1.exampleMMXU_1.gse_inputs_Performance.datasetDecodeDone(timeAllowedToLive, T, stNum, sqNum);
 		}
+		LATENCY_FRAME_DONE(&D1Q1SB4.S1.C1.exampleMMXU_1.gse_inputs_Performance.latency, "D1Q1SB4.S1.C1.exampleMMXU_1.gse_inputs_Performance");
 	}
 	if (gocbRefLength == 34 && strncmp((const char *) gocbRef, "E1Q1SB1C1/LLN0$GO$AnotherPositions", gocbRefLength) == 0) {
+		SEQLOCK_WRITE_BEGIN(&D1Q1SB4.S1.C1.RSYNa_1.gse_inputs_AnotherPositions.seqlock);
 		if (stNum != D1Q1SB4.S1.C1.RSYNa_1.gse_inputs_AnotherPositions.stNum) {
 			ber_decode_E1Q1SB1_C1_Positions(dataset, &D1Q1SB4.S1.C1.RSYNa_1.gse_inputs_AnotherPositions.E1Q1SB1_C1_Positions);
 		}
@@ -362,11 +368,16 @@ void gseDecodeDataset(unsigned char *dataset, CTYPE_INT16U datasetLength, unsign
 		D1Q1SB4.S1.C1.RSYNa_1.gse_inputs_AnotherPositions.T = T;
 		D1Q1SB4.S1.C1.RSYNa_1.gse_inputs_AnotherPositions.stNum = stNum;
 		D1Q1SB4.S1.C1.RSYNa_1.gse_inputs_AnotherPositions.sqNum = sqNum;
+		SEQLOCK_WRITE_END(&D1Q1SB4.S1.C1.RSYNa_1.gse_inputs_AnotherPositions.seqlock);
+		EVENT_QUEUE_GSE(D1Q1SB4.S1.C1.RSYNa_1.gse_inputs_AnotherPositions.eventQueue, &D1Q1SB4.S1.C1.RSYNa_1.gse_inputs_AnotherPositions, "D1Q1SB4.S1.C1.RSYNa_1.gse_inputs_AnotherPositions", T, stNum, sqNum);
+		LATENCY_FRAME_DECODED();
 		if (D1Q1SB4.S1.C1.RSYNa_1.gse_inputs_AnotherPositions.datasetDecodeDone != NULL) {
 			D1Q1SB4.S1.C1.RSYNa_1.gse_inputs_AnotherPositions.datasetDecodeDone(timeAllowedToLive, T, stNum, sqNum);
 		}
+		LATENCY_FRAME_DONE(&D1Q1SB4.S1.C1.RSYNa_1.gse_inputs_AnotherPositions.latency, "D1Q1SB4.S1.C1.RSYNa_1.gse_inputs_AnotherPositions");
 	}
 	if (gocbRefLength == 30 && strncmp((const char *) gocbRef, "E1Q1SB1C1/LLN0$GO$ItlPositions", gocbRefLength) == 0) {
+		SEQLOCK_WRITE_BEGIN(&D1Q1SB4.S1.C1.RSYNa_1.gse_inputs_ItlPositions.seqlock);
 		if (stNum != D1Q1SB4.S1.C1.RSYNa_1.gse_inputs_ItlPositions.stNum) {
 			ber_decode_E1Q1SB1_C1_Positions(dataset, &D1Q1SB4.S1.C1.RSYNa_1.gse_inputs_ItlPositions.E1Q1SB1_C1_Positions);
 		}
@@ -374,10 +385,50 @@ void gseDecodeDataset(unsigned char *dataset, CTYPE_INT16U datasetLength, unsign
 		D1Q1SB4.S1.C1.RSYNa_1.gse_inputs_ItlPositions.T = T;
 		D1Q1SB4.S1.C1.RSYNa_1.gse_inputs_ItlPositions.stNum = stNum;
 		D1Q1SB4.S1.C1.RSYNa_1.gse_inputs_ItlPositions.sqNum = sqNum;
+		SEQLOCK_WRITE_END(&D1Q1SB4.S1.C1.RSYNa_1.gse_inputs_ItlPositions.seqlock);
+		EVENT_QUEUE_GSE(D1Q1SB4.S1.C1.RSYNa_1.gse_inputs_ItlPositions.eventQueue, &D1Q1SB4.S1.C1.RSYNa_1.gse_inputs_ItlPositions, "D1Q1SB4.S1.C1.RSYNa_1.gse_inputs_ItlPositions", T, stNum, sqNum);
+		LATENCY_FRAME_DECODED();
 		if (D1Q1SB4.S1.C1.RSYNa_1.gse_inputs_ItlPositions.datasetDecodeDone != NULL) {
 			D1Q1SB4.S1.C1.RSYNa_1.gse_inputs_ItlPositions.datasetDecodeDone(timeAllowedToLive, T, stNum, sqNum);
 		}
+		LATENCY_FRAME_DONE(&D1Q1SB4.S1.C1.RSYNa_1.gse_inputs_ItlPositions.latency, "D1Q1SB4.S1.C1.RSYNa_1.gse_inputs_ItlPositions");
 	}
 }
 
 
+void gse_inputs_snapshot_D1Q1SB4_C1_exampleMMXU_1_Performance(struct E1Q1SB1_C1_Performance *E1Q1SB1_C1_Performance, CTYPE_INT32U *timeAllowedToLive, CTYPE_TIMESTAMP *T, CTYPE_INT32U *stNum, CTYPE_INT32U *sqNum) {
+	CTYPE_INT32U sequence = 0;
+
+	do {
+		sequence = SEQLOCK_READ_BEGIN(&D1Q1SB4.S1.C1.exampleMMXU_1.gse_inputs_Performance.seqlock);
+		memcpy(E1Q1SB1_C1_Performance, &D1Q1SB4.S1.C1.exampleMMXU_1.gse_inputs_Performance.E1Q1SB1_C1_Performance, sizeof(D1Q1SB4.S1.C1.exampleMMXU_1.gse_inputs_Performance.E1Q1SB1_C1_Performance));
+		*timeAllowedToLive = D1Q1SB4.S1.C1.exampleMMXU_1.gse_inputs_Performance.timeAllowedToLive;
+		*T = D1Q1SB4.S1.C1.exampleMMXU_1.gse_inputs_Performance.T;
+		*stNum = D1Q1SB4.S1.C1.exampleMMXU_1.gse_inputs_Performance.stNum;
+		*sqNum = D1Q1SB4.S1.C1.exampleMMXU_1.gse_inputs_Performance.sqNum;
+	} while (SEQLOCK_READ_RETRY(&D1Q1SB4.S1.C1.exampleMMXU_1.gse_inputs_Performance.seqlock, sequence));
+}
+void gse_inputs_snapshot_D1Q1SB4_C1_RSYNa_1_AnotherPositions(struct E1Q1SB1_C1_Positions *E1Q1SB1_C1_Positions, CTYPE_INT32U *timeAllowedToLive, CTYPE_TIMESTAMP *T, CTYPE_INT32U *stNum, CTYPE_INT32U *sqNum) {
+	CTYPE_INT32U sequence = 0;
+
+	do {
+		sequence = SEQLOCK_READ_BEGIN(&D1Q1SB4.S1.C1.RSYNa_1.gse_inputs_AnotherPositions.seqlock);
+		memcpy(E1Q1SB1_C1_Positions, &D1Q1SB4.S1.C1.RSYNa_1.gse_inputs_AnotherPositions.E1Q1SB1_C1_Positions, sizeof(D1Q1SB4.S1.C1.RSYNa_1.gse_inputs_AnotherPositions.E1Q1SB1_C1_Positions));
+		*timeAllowedToLive = D1Q1SB4.S1.C1.RSYNa_1.gse_inputs_AnotherPositions.timeAllowedToLive;
+		*T = D1Q1SB4.S1.C1.RSYNa_1.gse_inputs_AnotherPositions.T;
+		*stNum = D1Q1SB4.S1.C1.RSYNa_1.gse_inputs_AnotherPositions.stNum;
+		*sqNum = D1Q1SB4.S1.C1.RSYNa_1.gse_inputs_AnotherPositions.sqNum;
+	} while (SEQLOCK_READ_RETRY(&D1Q1SB4.S1.C1.RSYNa_1.gse_inputs_AnotherPositions.seqlock, sequence));
+}
+void gse_inputs_snapshot_D1Q1SB4_C1_RSYNa_1_ItlPositions(struct E1Q1SB1_C1_Positions *E1Q1SB1_C1_Positions, CTYPE_INT32U *timeAllowedToLive, CTYPE_TIMESTAMP *T, CTYPE_INT32U *stNum, CTYPE_INT32U *sqNum) {
+	CTYPE_INT32U sequence = 0;
+
+	do {
+		sequence = SEQLOCK_READ_BEGIN(&D1Q1SB4.S1.C1.RSYNa_1.gse_inputs_ItlPositions.seqlock);
+		memcpy(E1Q1SB1_C1_Positions, &D1Q1SB4.S1.C1.RSYNa_1.gse_inputs_ItlPositions.E1Q1SB1_C1_Positions, sizeof(D1Q1SB4.S1.C1.RSYNa_1.gse_inputs_ItlPositions.E1Q1SB1_C1_Positions));
+		*timeAllowedToLive = D1Q1SB4.S1.C1.RSYNa_1.gse_inputs_ItlPositions.timeAllowedToLive;
+		*T = D1Q1SB4.S1.C1.RSYNa_1.gse_inputs_ItlPositions.T;
+		*stNum = D1Q1SB4.S1.C1.RSYNa_1.gse_inputs_ItlPositions.stNum;
+		*sqNum = D1Q1SB4.S1.C1.RSYNa_1.gse_inputs_ItlPositions.sqNum;
+	} while (SEQLOCK_READ_RETRY(&D1Q1SB4.S1.C1.RSYNa_1.gse_inputs_ItlPositions.seqlock, sequence));
+}
@@ -41,6 +41,12 @@ int ber_decode_D1Q1SB4_C1_MMXUResult(unsigned char *buf, struct D1Q1SB4_C1_MMXUR
 
 void gseDecodeDataset(unsigned char *dataset, CTYPE_INT16U datasetLength, unsigned char *gocbRef, CTYPE_INT16U gocbRefLength, CTYPE_INT32U timeAllowedToLive, CTYPE_TIMESTAMP T, CTYPE_INT32U stNum, CTYPE_INT32U sqNum);
 
+// consistent copies of subscribed inputs, which may be taken from any thread while frames are being decoded (but not
+// from datasetDecodeDone(), which runs on the decoding thread and can read the inputs directly)
+void gse_inputs_snapshot_D1Q1SB4_C1_exampleMMXU_1_Performance(struct E1Q1SB1_C1_Performance *E1Q1SB1_C1_Performance, CTYPE_INT32U *timeAllowedToLive, CTYPE_TIMESTAMP *T, CTYPE_INT32U *stNum, CTYPE_INT32U *sqNum);
+void gse_inputs_snapshot_D1Q1SB4_C1_RSYNa_1_AnotherPositions(struct E1Q1SB1_C1_Positions *E1Q1SB1_C1_Positions, CTYPE_INT32U *timeAllowedToLive, CTYPE_TIMESTAMP *T, CTYPE_INT32U *stNum, CTYPE_INT32U *sqNum);
+void gse_inputs_snapshot_D1Q1SB4_C1_RSYNa_1_ItlPositions(struct E1Q1SB1_C1_Positions *E1Q1SB1_C1_Positions, CTYPE_INT32U *timeAllowedToLive, CTYPE_TIMESTAMP *T, CTYPE_INT32U *stNum, CTYPE_INT32U *sqNum);
+
 
 
 #ifdef __cplusplus /* If this is a C++ compiler, end C linkage */
@@ -35,10 +35,10 @@ int BER_DECODE_CTYPE_FLOAT32(unsigned char *buf, CTYPE_FLOAT32 *value) {
 
 		// check for fixed-length GOOSE. If not, check for 8 bits for exponent
 		if (len == 5 && buf[offset] == 0x08) {
-			netmemcpy(value, &buf[offset + 1], len - 1);
+			*value = net_load_float32(&buf[offset + 1]);
 		}
 		else if (len == 4) {
-			netmemcpy(value, &buf[offset], len);
+			*value = net_load_float32(&buf[offset]);
 		}
 	}
 
@@ -55,10 +55,10 @@ int BER_DECODE_CTYPE_FLOAT64(unsigned char *buf, CTYPE_FLOAT64 *value) {
 
 		// check for fixed-length GOOSE. If not, check for 11 bits for exponent
 		if (len == 9 && buf[offset] == 0x0B) {
-			netmemcpy(value, &buf[offset + 1], len - 1);
+			*value = net_load_float64(&buf[offset + 1]);
 		}
 		else if (len == 8) {
-			netmemcpy(value, &buf[offset], len);
+			*value = net_load_float64(&buf[offset]);
 		}
 	}
 
@@ -73,7 +73,7 @@ int BER_DECODE_CTYPE_QUALITY(unsigned char *buf, CTYPE_QUALITY *value) {
 		len += decodeLength(&buf[offset]);
 		offset += getLengthFieldSize(buf[offset]);
 
-		netmemcpy(value, &buf[offset + 1], len - 1);	// skip over one byte (which contains number of unused bits)
+		*value = (CTYPE_QUALITY) ber_load_integer(&buf[offset + 1], len - 1, 0);	// skip over one byte (which contains number of unused bits)
 	}
 
 	return offset + len;
@@ -86,7 +86,9 @@ int BER_DECODE_CTYPE_TIMESTAMP(unsigned char *buf, CTYPE_TIMESTAMP *value) {
 		len += decodeLength(&buf[offset]);
 		offset += getLengthFieldSize(buf[offset]);
 
-		netmemcpy(value, &buf[offset], len);
+		if (len == SV_GET_LENGTH_TIMESTAMP) {
+			*value = (CTYPE_TIMESTAMP) net_load64(&buf[offset]);
+		}
 	}
 
 	return offset + len;
@@ -100,9 +102,9 @@ int BER_DECODE_CTYPE_ENUM(unsigned char *buf, CTYPE_ENUM *value) {	// assuming e
 		offset += getLengthFieldSize(buf[offset]);
 
 #if GOOSE_FIXED_SIZE == 1
-		ber_decode_integer(&buf[offset], len, value, SV_GET_LENGTH_INT8);
+		*value = ber_decode_integer_int8(&buf[offset], len);
 #else
-		ber_decode_integer(&buf[offset], len, value, SV_GET_LENGTH_INT32U);
+		*value = ber_decode_integer_int32(&buf[offset], len);
 #endif
 	}
 
@@ -116,7 +118,7 @@ int BER_DECODE_CTYPE_INT8(unsigned char *buf, CTYPE_INT8 *value) {
 		len += decodeLength(&buf[offset]);
 		offset += getLengthFieldSize(buf[offset]);
 
-		ber_decode_integer(&buf[offset], len, value, SV_GET_LENGTH_INT8);
+		*value = ber_decode_integer_int8(&buf[offset], len);
 	}
 
 	return offset + len;
@@ -129,7 +131,7 @@ int BER_DECODE_CTYPE_INT16(unsigned char *buf, CTYPE_INT16 *value) {
 		len += decodeLength(&buf[offset]);
 		offset += getLengthFieldSize(buf[offset]);
 
-		ber_decode_integer(&buf[offset], len, value, SV_GET_LENGTH_INT16);
+		*value = ber_decode_integer_int16(&buf[offset], len);
 	}
 
 	return offset + len;
@@ -142,7 +144,7 @@ int BER_DECODE_CTYPE_INT32(unsigned char *buf, CTYPE_INT32 *value) {
 		len += decodeLength(&buf[offset]);
 		offset += getLengthFieldSize(buf[offset]);
 
-		ber_decode_integer(&buf[offset], len, value, SV_GET_LENGTH_INT32);
+		*value = ber_decode_integer_int32(&buf[offset], len);
 	}
 
 	return offset + len;
@@ -155,7 +157,7 @@ int BER_DECODE_CTYPE_INT8U(unsigned char *buf, CTYPE_INT8U *value) {
 		len += decodeLength(&buf[offset]);
 		offset += getLengthFieldSize(buf[offset]);
 
-		ber_decode_integer(&buf[offset], len, value, SV_GET_LENGTH_INT8U);
+		*value = ber_decode_integer_int8u(&buf[offset], len);
 	}
 
 	return offset + len;
@@ -168,7 +170,7 @@ int BER_DECODE_CTYPE_INT16U(unsigned char *buf, CTYPE_INT16U *value) {
 		len += decodeLength(&buf[offset]);
 		offset += getLengthFieldSize(buf[offset]);
 
-		ber_decode_integer(&buf[offset], len, value, SV_GET_LENGTH_INT16U);
+		*value = ber_decode_integer_int16u(&buf[offset], len);
 	}
 
 	return offset + len;
@@ -181,7 +183,7 @@ int BER_DECODE_CTYPE_INT32U(unsigned char *buf, CTYPE_INT32U *value) {
 		len += decodeLength(&buf[offset]);
 		offset += getLengthFieldSize(buf[offset]);
 
-		ber_decode_integer(&buf[offset], len, value, SV_GET_LENGTH_INT32U);
+		*value = ber_decode_integer_int32u(&buf[offset], len);
 	}
 
 	return offset + len;
@@ -199,13 +201,13 @@ int BER_DECODE_CTYPE_BOOLEAN(unsigned char *buf, CTYPE_BOOLEAN *value) {
 		len += decodeLength(&buf[offset]);
 		offset += getLengthFieldSize(buf[offset]);
 
-		netmemcpy(value, &buf[offset], len);
+		*value = buf[offset];
 	}
 
 	return offset + len;
 }
 int BER_DECODE_CTYPE_DBPOS(unsigned char *buf, CTYPE_DBPOS *value) {
-	netmemcpy(value, buf, SV_GET_LENGTH_DBPOS);
+	*value = (CTYPE_DBPOS) net_load32(buf);
 
 	return SV_GET_LENGTH_DBPOS;
 }
@@ -55,7 +55,7 @@ void gseDecodePDU(unsigned char *buf) {
 			buf = &buf[offsetForNonSequence];
 			break;
 		case GSE_TAG_TIME_ALLOWED_TO_LIVE:
-			ber_decode_integer(&buf[offsetForSequence], lengthValue, &timeAllowedToLive, SV_GET_LENGTH_INT32U);
+			timeAllowedToLive = ber_decode_integer_int32u(&buf[offsetForSequence], lengthValue);
 			buf = &buf[offsetForNonSequence];
 			break;
 		case ASN1_TAG_SEQUENCE:
@@ -69,11 +69,11 @@ void gseDecodePDU(unsigned char *buf) {
 			buf = &buf[offsetForNonSequence];
 			break;
 		case GSE_TAG_STNUM:
-			ber_decode_integer(&buf[offsetForSequence], lengthValue, &stNum, SV_GET_LENGTH_INT32U);
+			stNum = ber_decode_integer_int32u(&buf[offsetForSequence], lengthValue);
 			buf = &buf[offsetForNonSequence];
 			break;
 		case GSE_TAG_SQNUM:
-			ber_decode_integer(&buf[offsetForSequence], lengthValue, &sqNum, SV_GET_LENGTH_INT32U);
+			sqNum = ber_decode_integer_int32u(&buf[offsetForSequence], lengthValue);
 			buf = &buf[offsetForNonSequence];
 			break;
 		case GSE_TAG_ALLDATA:
@@ -35,7 +35,7 @@ int BER_ENCODE_CTYPE_FLOAT32(unsigned char *buf, CTYPE_FLOAT32 *value) {
 	offset += encodeLength(&buf[offset], len);
 
 	buf[offset++] = 0x08;	// bits for exponent
-	netmemcpy(&buf[offset], value, len - 1);
+	net_store_float32(&buf[offset], *value);
 
 	return offset + len - 1;
 }
@@ -47,7 +47,7 @@ int BER_ENCODE_CTYPE_FLOAT64(unsigned char *buf, CTYPE_FLOAT64 *value) {
 	offset += encodeLength(&buf[offset], len);
 
 	buf[offset++] = 0x0B;	// bits for exponent
-	netmemcpy(&buf[offset], value, len - 1);
+	net_store_float64(&buf[offset], *value);
 
 	return offset + len - 1;
 }
@@ -60,7 +60,7 @@ int BER_ENCODE_CTYPE_QUALITY(unsigned char *buf, CTYPE_QUALITY *value) {
 	offset += encodeLength(&buf[offset], len);
 
 	buf[offset++] = QUALITY_UNUSED_BITS;	// number of unused bits
-	netmemcpy(&buf[offset], value, len - 1);
+	net_store16(&buf[offset], *value);
 
 	return offset + len - 1;
 }
@@ -85,7 +85,7 @@ int BER_ENCODE_CTYPE_ENUM(unsigned char *buf, CTYPE_ENUM *value) {
 #if GOOSE_FIXED_SIZE == 1
 	ber_encode_integer_fixed_size(&buf[offset], value, SV_GET_LENGTH_INT8);
 #else
-	ber_encode_integer(&buf[offset], value, SV_GET_LENGTH_INT32U);			// assuming enum is an int - allows any enum type to be used
+	ber_store_integer(&buf[offset], (unsigned long long) *value, len);	// assuming enum is an int - allows any enum type to be used
 #endif
 
 	return offset + len;
@@ -100,7 +100,7 @@ int BER_ENCODE_CTYPE_INT8(unsigned char *buf, CTYPE_INT8 *value) {
 #if GOOSE_FIXED_SIZE == 1
 	ber_encode_integer_fixed_size(&buf[offset], value, SV_GET_LENGTH_INT8);
 #else
-	ber_encode_integer(&buf[offset], value, SV_GET_LENGTH_INT8);
+	ber_store_integer(&buf[offset], (unsigned long long) *value, len);
 #endif
 
 	return offset + len;
@@ -115,7 +115,7 @@ int BER_ENCODE_CTYPE_INT16(unsigned char *buf, CTYPE_INT16 *value) {
 #if GOOSE_FIXED_SIZE == 1
 	ber_encode_integer_fixed_size(&buf[offset], value, SV_GET_LENGTH_INT16);
 #else
-	ber_encode_integer(&buf[offset], value, SV_GET_LENGTH_INT16);
+	ber_store_integer(&buf[offset], (unsigned long long) *value, len);
 #endif
 
 	return offset + len;
@@ -130,7 +130,7 @@ int BER_ENCODE_CTYPE_INT32(unsigned char *buf, CTYPE_INT32 *value) {
 #if GOOSE_FIXED_SIZE == 1
 	ber_encode_integer_fixed_size(&buf[offset], value, SV_GET_LENGTH_INT32);
 #else
-	ber_encode_integer(&buf[offset], value, SV_GET_LENGTH_INT32);
+	ber_store_integer(&buf[offset], (unsigned long long) *value, len);
 #endif
 
 	return offset + len;
@@ -145,7 +145,7 @@ int BER_ENCODE_CTYPE_INT8U(unsigned char *buf, CTYPE_INT8U *value) {
 #if GOOSE_FIXED_SIZE == 1
 	ber_encode_integer_fixed_size(&buf[offset], value, SV_GET_LENGTH_INT8U);
 #else
-	ber_encode_integer(&buf[offset], value, SV_GET_LENGTH_INT8U);
+	ber_store_integer(&buf[offset], (unsigned long long) *value, len);
 #endif
 
 	return offset + len;
@@ -160,7 +160,7 @@ int BER_ENCODE_CTYPE_INT16U(unsigned char *buf, CTYPE_INT16U *value) {
 #if GOOSE_FIXED_SIZE == 1
 	ber_encode_integer_fixed_size(&buf[offset], value, SV_GET_LENGTH_INT16U);
 #else
-	ber_encode_integer(&buf[offset], value, SV_GET_LENGTH_INT16U);
+	ber_store_integer(&buf[offset], (unsigned long long) *value, len);
 #endif
 
 	return offset + len;
@@ -175,7 +175,7 @@ int BER_ENCODE_CTYPE_INT32U(unsigned char *buf, CTYPE_INT32U *value) {
 #if GOOSE_FIXED_SIZE == 1
 	ber_encode_integer_fixed_size(&buf[offset], value, SV_GET_LENGTH_INT32U);
 #else
-	ber_encode_integer(&buf[offset], value, SV_GET_LENGTH_INT32U);
+	ber_store_integer(&buf[offset], (unsigned long long) *value, len);
 #endif
 
 	return offset + len;
@@ -192,7 +192,7 @@ int BER_ENCODE_CTYPE_BOOLEAN(unsigned char *buf, CTYPE_BOOLEAN *value) {
 	buf[offset++] = ASN1_TAG_BOOLEAN;
 	offset += encodeLength(&buf[offset], len);
 
-	netmemcpy(&buf[offset], value, len);
+	buf[offset] = *value;
 
 	return offset + len;
 }
@@ -203,7 +203,7 @@ int BER_ENCODE_CTYPE_DBPOS(unsigned char *buf, CTYPE_DBPOS *value) {
 	buf[offset++] = 0x85;
 	offset += encodeLength(&buf[offset], len);
 
-	netmemcpy(&buf[offset], value, len);
+	net_store32(&buf[offset], (CTYPE_INT32U) *value);
 
 	return offset + len;
 }
@@ -84,17 +84,17 @@ int gseEncodePacket(struct gseControl *gseControl, unsigned char *buf) {
 	buf[offset++] = 0x81;	// TPID
 	buf[offset++] = 0x00;
 
-	netmemcpy(&buf[offset], &gseControl->ethHeaderData.VLAN_ID, 2);	// TCI
+	net_store16(&buf[offset], gseControl->ethHeaderData.VLAN_ID);	// TCI
 	buf[offset] |= (gseControl->ethHeaderData.VLAN_PRIORITY << 5);
 	offset += 2;
 
 	buf[offset++] = 0x88;	// EtherType
 	buf[offset++] = 0xB8;
 
-	netmemcpy(&buf[offset], &gseControl->ethHeaderData.APPID, 2);	// APPID
+	net_store16(&buf[offset], gseControl->ethHeaderData.APPID);	// APPID
 	offset += 2;
 
-	netmemcpy(&buf[offset], &len, 2);	// length
+	net_store16(&buf[offset], (CTYPE_INT16U) len);	// length
 	offset += 2;
 
 	buf[offset++] = 0x00;	// reserved 1
@@ -112,11 +112,13 @@ int gseEncodePacket(struct gseControl *gseControl, unsigned char *buf) {
 	offset += size;
 
 	buf[offset++] = GSE_TAG_TIME_ALLOWED_TO_LIVE;
-	offset += encodeLength(&buf[offset], BER_GET_LENGTH_CTYPE_INT32U(&gseControl->timeAllowedToLive));
 #if GOOSE_FIXED_SIZE == 1
+	offset += encodeLength(&buf[offset], BER_GET_LENGTH_CTYPE_INT32U(&gseControl->timeAllowedToLive));
 	offset += ber_encode_integer_fixed_size(&buf[offset], &gseControl->timeAllowedToLive, SV_GET_LENGTH_INT32U);
 #else
-	offset += ber_encode_integer(&buf[offset], &gseControl->timeAllowedToLive, SV_GET_LENGTH_INT32U);
+	size = ber_encode_integer_int32u(&buf[offset + 1], gseControl->timeAllowedToLive);	// content is at most 5 bytes, so the length field is one byte
+	buf[offset++] = size;
+	offset += size;
 #endif
 
 	buf[offset++] = GSE_TAG_DATSET;
@@ -138,43 +140,51 @@ int gseEncodePacket(struct gseControl *gseControl, unsigned char *buf) {
 	offset += BER_GET_LENGTH_CTYPE_TIMESTAMP(&gseControl->t);
 
 	buf[offset++] = GSE_TAG_STNUM;
-	offset += encodeLength(&buf[offset], BER_GET_LENGTH_CTYPE_INT32U(&gseControl->stNum));
 #if GOOSE_FIXED_SIZE == 1
+	offset += encodeLength(&buf[offset], BER_GET_LENGTH_CTYPE_INT32U(&gseControl->stNum));
 	offset += ber_encode_integer_fixed_size(&buf[offset], &gseControl->stNum, SV_GET_LENGTH_INT32U);
 #else
-	offset += ber_encode_integer(&buf[offset], &gseControl->stNum, SV_GET_LENGTH_INT32U);
+	size = ber_encode_integer_int32u(&buf[offset + 1], gseControl->stNum);
+	buf[offset++] = size;
+	offset += size;
 #endif
 
 	buf[offset++] = GSE_TAG_SQNUM;
-	offset += encodeLength(&buf[offset], BER_GET_LENGTH_CTYPE_INT32U(&gseControl->sqNum));
 #if GOOSE_FIXED_SIZE == 1
+	offset += encodeLength(&buf[offset], BER_GET_LENGTH_CTYPE_INT32U(&gseControl->sqNum));
 	offset += ber_encode_integer_fixed_size(&buf[offset], &gseControl->sqNum, SV_GET_LENGTH_INT32U);
 #else
-	offset += ber_encode_integer(&buf[offset], &gseControl->sqNum, SV_GET_LENGTH_INT32U);
+	size = ber_encode_integer_int32u(&buf[offset + 1], gseControl->sqNum);
+	buf[offset++] = size;
+	offset += size;
 #endif
 
 	buf[offset++] = GSE_TAG_SIMULATION;
 	offset += encodeLength(&buf[offset], BER_GET_LENGTH_CTYPE_BOOLEAN(&gseControl->test));
-	offset += ber_encode_integer(&buf[offset], &gseControl->test, SV_GET_LENGTH_BOOLEAN);
+	buf[offset++] = gseControl->test;
 
 	buf[offset++] = GSE_TAG_CONFREV;
-	offset += encodeLength(&buf[offset], BER_GET_LENGTH_CTYPE_INT32U(&gseControl->confRev));
 #if GOOSE_FIXED_SIZE == 1
+	offset += encodeLength(&buf[offset], BER_GET_LENGTH_CTYPE_INT32U(&gseControl->confRev));
 	offset += ber_encode_integer_fixed_size(&buf[offset], &gseControl->confRev, SV_GET_LENGTH_INT32U);
 #else
-	offset += ber_encode_integer(&buf[offset], &gseControl->confRev, SV_GET_LENGTH_INT32U);
+	size = ber_encode_integer_int32u(&buf[offset + 1], gseControl->confRev);
+	buf[offset++] = size;
+	offset += size;
 #endif
 
 	buf[offset++] = GSE_TAG_NDSCOM;
 	offset += encodeLength(&buf[offset], BER_GET_LENGTH_CTYPE_BOOLEAN(&gseControl->ndsCom));
-	offset += ber_encode_integer(&buf[offset], &gseControl->ndsCom, SV_GET_LENGTH_BOOLEAN);
+	buf[offset++] = gseControl->ndsCom;
 
 	buf[offset++] = GSE_TAG_NUMDATSETENTRIES;
-	offset += encodeLength(&buf[offset], BER_GET_LENGTH_CTYPE_INT32U(&gseControl->numDatSetEntries));
 #if GOOSE_FIXED_SIZE == 1
+	offset += encodeLength(&buf[offset], BER_GET_LENGTH_CTYPE_INT32U(&gseControl->numDatSetEntries));
 	offset += ber_encode_integer_fixed_size(&buf[offset], &gseControl->numDatSetEntries, SV_GET_LENGTH_INT32U);
 #else
-	offset += ber_encode_integer(&buf[offset], &gseControl->numDatSetEntries, SV_GET_LENGTH_INT32U);
+	size = ber_encode_integer_int32u(&buf[offset + 1], gseControl->numDatSetEntries);
+	buf[offset++] = size;
+	offset += size;
 #endif
 
 	buf[offset++] = GSE_TAG_ALLDATA;
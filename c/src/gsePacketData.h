@@ -28,6 +28,7 @@ extern "C" {
 #include <stdlib.h>
 #include <string.h>
 #include "ctypes.h"
+#include "latency.h"
 
 struct gseControl {
 	struct ethHeaderData ethHeaderData;
@@ -47,6 +48,9 @@ struct gseControl {
 	int (*encodeDataset)(unsigned char *buf);	// function pointer to dataset-specific encoder
 	int (*getDatasetLength)();					// function pointer to dataset-specific getLength function
 	int (*send)(unsigned char *buf, CTYPE_BOOLEAN statusChange, CTYPE_INT32U timeAllowedToLive);	// function pointer to send GSE packet
+#if LATENCY_STATS_SUPPORTED == 1
+	struct latencyStats latency;				// transmit latency of frames sent by this control block
+#endif
 };
 
 #ifdef __cplusplus /* If this is a C++ compiler, end C linkage */
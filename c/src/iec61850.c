@@ -27,5 +27,7 @@ void initialise_iec61850() {
 
 #if JSON_INTERFACE == 1
 	init_data_model_index();
+	init_data_model_lookup();
+	init_json_cache();
 #endif
 }
@@ -17,9 +17,9 @@
  * along with this program; if not, write to the Free Software
  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
  */
-
 #include "interface.h"
 #include "interfaceSendPacket.h"
+#include "latency.h"
 
 //#if HIGH_LEVEL_INTERFACE == 1
 
@@ -28,15 +28,11 @@ int testValue = 0;
 unsigned char bufIn[2048] = {0};
 unsigned char bufOut[2048] = {0};
 
-pcap_t *fp;
 char errbuf[PCAP_ERRBUF_SIZE];
+char interfaceName[256] = {0};
 
-void packet_handler_interface(u_char *param, const struct pcap_pkthdr *header, const u_char *pkt_data) {
-    gse_sv_packet_filter((unsigned char *) pkt_data, header->len);
-}
-
-pcap_t *init_pcap() {
-	pcap_t *fpl;
+// finds the platform-specific libpcap network interface
+const char *find_interface() {
     pcap_if_t *alldevs = 0;
     pcap_if_t *used_if;
 
@@ -62,48 +58,59 @@ pcap_t *init_pcap() {
 #endif
     fflush(stdout);
 
-	if ((fpl = pcap_open_live(used_if->name,	// name of the device
-							 65536,				// portion of the packet to capture. It doesn't matter in this case
-							 1,					// promiscuous mode (nonzero means promiscuous)
-							 1,					// read timeout
-							 errbuf				// error buffer
-							 )) == NULL)
-	{
-		fprintf(stderr, "\nUnable to open the adapter. %s is not supported by WinPcap\n", alldevs->name);
-		exit(2);
-	}
-
+    strncpy(interfaceName, used_if->name, sizeof(interfaceName) - 1);
     pcap_freealldevs(alldevs);
 
-	return fpl;
+	return interfaceName;
 }
 
 void start() {
+	startWithBackend(&netBackendPcap, NULL);
+}
+
+void startWithBackend(struct netBackend *backend, const char *source) {
+	int isInterface = (backend != &netBackendPcapFile && backend != &netBackendLoopback);
+
 	initialise_iec61850();	// initialise IEC 61850 library
+#if LATENCY_STATS_SUPPORTED == 1
+	latency_init();
+#endif
 
-	fp = init_pcap();		// initialise platform-specific libpcap network interface
+	if (source == NULL && isInterface) {
+		source = find_interface();
+	}
+
+	netBackend = backend;
+	if (netBackend->open(netBackend, source) != 0) {
+		// libpcap is the portable fallback for faster network interface backends
+		if (!isInterface || netBackend == &netBackendPcap || netBackendPcap.open(&netBackendPcap, source) != 0) {
+			exit(2);
+		}
+		netBackend = &netBackendPcap;
+	}
+
+	fprintf(stdout, "network backend: %s\n", netBackend->name);
+	fflush(stdout);
+
+#if LATENCY_STATS_SUPPORTED == 1 && !defined(_WIN32)
+	// request kernel transmit timestamps, which the backend's receive loop also collects (see latency.h); received frames
+	// are timed from the backend's receive timestamps
+	if (netBackend->fd >= 0) {
+		latency_enable_socket_timestamps(netBackend->fd, isInterface ? source : NULL);
+	}
+#endif
 }
 
 void stop() {
-	pcap_close(fp);	// close network interface
+	netBackend->close(netBackend);	// close network interface
 }
 
 int readPacket() {
-	return pcap_loop(fp, 1, packet_handler_interface, NULL);
+	return netBackend->rxBatch(netBackend, -1);
 }
 
 int	readPacketTimeout() {
-	struct pcap_pkthdr *header;
-	const u_char *pkt_data;
-	int ret = pcap_next_ex(fp, &header, &pkt_data);
-
-	if (ret <= 0) {
-		return ret;
-	}
-
-	// process packet data
-	gse_sv_packet_filter((unsigned char *) pkt_data, header->len);
-	return ret;
+	return netBackend->rxBatch(netBackend, 1);
 }
 
 //#endif
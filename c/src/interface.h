@@ -32,14 +32,25 @@
 	#define WIN32_LEAN_AND_MEAN
 #endif
 #include <pcap.h>
+#include "netBackend.h"
 
 extern unsigned char bufIn[2048];
 extern unsigned char bufOut[2048];
 
-extern pcap_t *fp;
-
 void start();
+
+/**
+ * Starts the library with the given network backend. source is a network interface name, or a file name for
+ * netBackendPcapFile; if NULL, the default network interface is used. If a network interface backend cannot be
+ * opened, libpcap is used instead.
+ */
+void startWithBackend(struct netBackend *backend, const char *source);
 void stop();
+
+/**
+ * Processes a batch of received frames, with the return values of netBackend->rxBatch(). readPacket() waits
+ * indefinitely for a frame, and readPacketTimeout() waits for up to 1 ms.
+ */
 int readPacket();
 int readPacketTimeout();
 
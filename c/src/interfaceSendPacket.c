@@ -29,7 +29,9 @@ int interface_sv_update_E1Q1SB1_C1_PerformanceSV() {
 	int len = sv_update_E1Q1SB1_C1_PerformanceSV(bufOut);
 
 	if (len > 0) {
-		pcap_sendpacket(fp, bufOut, len);
+		LATENCY_TRANSMIT_START(&E1Q1SB1.S1.C1.LN0.PerformanceSV.latency, "E1Q1SB1.S1.C1.LN0.PerformanceSV");
+		net_backend_send(netBackend, bufOut, len);
+		LATENCY_TRANSMIT_POLL(netBackend->fd);
 	}
 
 	return len;
@@ -39,7 +41,9 @@ int interface_gse_send_E1Q1SB1_C1_Performance(int statusChange, int timeAllowedT
 	int len = gse_send_E1Q1SB1_C1_Performance(bufOut, (CTYPE_BOOLEAN) statusChange, (CTYPE_INT32U) timeAllowedToLive);
 
 	if (len > 0) {
-		pcap_sendpacket(fp, bufOut, len);
+		LATENCY_TRANSMIT_START(&E1Q1SB1.S1.C1.LN0.Performance.latency, "E1Q1SB1.S1.C1.LN0.Performance");
+		net_backend_send(netBackend, bufOut, len);
+		LATENCY_TRANSMIT_POLL(netBackend->fd);
 	}
 
 	return len;
@@ -49,7 +53,9 @@ int interface_gse_send_E1Q1SB1_C1_ItlPositions(int statusChange, int timeAllowed
 	int len = gse_send_E1Q1SB1_C1_ItlPositions(bufOut, (CTYPE_BOOLEAN) statusChange, (CTYPE_INT32U) timeAllowedToLive);
 
 	if (len > 0) {
-		pcap_sendpacket(fp, bufOut, len);
+		LATENCY_TRANSMIT_START(&E1Q1SB1.S1.C1.LN0.ItlPositions.latency, "E1Q1SB1.S1.C1.LN0.ItlPositions");
+		net_backend_send(netBackend, bufOut, len);
+		LATENCY_TRANSMIT_POLL(netBackend->fd);
 	}
 
 	return len;
@@ -59,7 +65,9 @@ int interface_gse_send_E1Q1SB1_C1_AnotherPositions(int statusChange, int timeAll
 	int len = gse_send_E1Q1SB1_C1_AnotherPositions(bufOut, (CTYPE_BOOLEAN) statusChange, (CTYPE_INT32U) timeAllowedToLive);
 
 	if (len > 0) {
-		pcap_sendpacket(fp, bufOut, len);
+		LATENCY_TRANSMIT_START(&E1Q1SB1.S1.C1.LN0.AnotherPositions.latency, "E1Q1SB1.S1.C1.LN0.AnotherPositions");
+		net_backend_send(netBackend, bufOut, len);
+		LATENCY_TRANSMIT_POLL(netBackend->fd);
 	}
 
 	return len;
@@ -69,7 +77,9 @@ int interface_sv_update_E1Q1SB1_C1_Volt() {
 	int len = sv_update_E1Q1SB1_C1_Volt(bufOut);
 
 	if (len > 0) {
-		pcap_sendpacket(fp, bufOut, len);
+		LATENCY_TRANSMIT_START(&E1Q1SB1.S1.C1.LN0.Volt.latency, "E1Q1SB1.S1.C1.LN0.Volt");
+		net_backend_send(netBackend, bufOut, len);
+		LATENCY_TRANSMIT_POLL(netBackend->fd);
 	}
 
 	return len;
@@ -79,7 +89,9 @@ int interface_sv_update_E1Q1SB1_C1_rmxuCB() {
 	int len = sv_update_E1Q1SB1_C1_rmxuCB(bufOut);
 
 	if (len > 0) {
-		pcap_sendpacket(fp, bufOut, len);
+		LATENCY_TRANSMIT_START(&E1Q1SB1.S1.C1.LN0.rmxuCB.latency, "E1Q1SB1.S1.C1.LN0.rmxuCB");
+		net_backend_send(netBackend, bufOut, len);
+		LATENCY_TRANSMIT_POLL(netBackend->fd);
 	}
 
 	return len;
@@ -89,7 +101,9 @@ int interface_gse_send_D1Q1SB4_C1_SyckResult(int statusChange, int timeAllowedTo
 	int len = gse_send_D1Q1SB4_C1_SyckResult(bufOut, (CTYPE_BOOLEAN) statusChange, (CTYPE_INT32U) timeAllowedToLive);
 
 	if (len > 0) {
-		pcap_sendpacket(fp, bufOut, len);
+		LATENCY_TRANSMIT_START(&D1Q1SB4.S1.C1.LN0.SyckResult.latency, "D1Q1SB4.S1.C1.LN0.SyckResult");
+		net_backend_send(netBackend, bufOut, len);
+		LATENCY_TRANSMIT_POLL(netBackend->fd);
 	}
 
 	return len;
@@ -99,7 +113,9 @@ int interface_gse_send_D1Q1SB4_C1_MMXUResult(int statusChange, int timeAllowedTo
 	int len = gse_send_D1Q1SB4_C1_MMXUResult(bufOut, (CTYPE_BOOLEAN) statusChange, (CTYPE_INT32U) timeAllowedToLive);
 
 	if (len > 0) {
-		pcap_sendpacket(fp, bufOut, len);
+		LATENCY_TRANSMIT_START(&D1Q1SB4.S1.C1.LN0.MMXUResult.latency, "D1Q1SB4.S1.C1.LN0.MMXUResult");
+		net_backend_send(netBackend, bufOut, len);
+		LATENCY_TRANSMIT_POLL(netBackend->fd);
 	}
 
 	return len;
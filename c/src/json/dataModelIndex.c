@@ -1869,7 +1869,7 @@ ACSIServer *server10;
 ACSIServer *server11;
 ACSIServer *server12;
 
-void init_webservers(mg_handler_t handler, void *(*serve)(void *)) {
+void init_webservers(mg_handler_t handler, void (*add_server)(ACSIServer *)) {
 	server1 = calloc(1, sizeof(ACSIServer));
 	server1->iedName = "E1Q1SB1";
 	server1->apName = "S1";
@@ -1882,7 +1882,7 @@ void init_webservers(mg_handler_t handler, void *(*serve)(void *)) {
 	mg_set_option(server1->mg, "auth_domain", "localhost");
 #endif
 	mg_add_uri_handler(server1->mg, "/", handler);
-	mg_start_thread(serve, server1->mg);
+	add_server(server1);
 
 	server2 = calloc(1, sizeof(ACSIServer));
 	server2->iedName = "E1Q1BP2";
@@ -1896,7 +1896,7 @@ void init_webservers(mg_handler_t handler, void *(*serve)(void *)) {
 	mg_set_option(server2->mg, "auth_domain", "localhost");
 #endif
 	mg_add_uri_handler(server2->mg, "/", handler);
-	mg_start_thread(serve, server2->mg);
+	add_server(server2);
 
 	server3 = calloc(1, sizeof(ACSIServer));
 	server3->iedName = "E1Q1BP3";
@@ -1910,7 +1910,7 @@ void init_webservers(mg_handler_t handler, void *(*serve)(void *)) {
 	mg_set_option(server3->mg, "auth_domain", "localhost");
 #endif
 	mg_add_uri_handler(server3->mg, "/", handler);
-	mg_start_thread(serve, server3->mg);
+	add_server(server3);
 
 	server4 = calloc(1, sizeof(ACSIServer));
 	server4->iedName = "E1Q2SB1";
@@ -1924,7 +1924,7 @@ void init_webservers(mg_handler_t handler, void *(*serve)(void *)) {
 	mg_set_option(server4->mg, "auth_domain", "localhost");
 #endif
 	mg_add_uri_handler(server4->mg, "/", handler);
-	mg_start_thread(serve, server4->mg);
+	add_server(server4);
 
 	server5 = calloc(1, sizeof(ACSIServer));
 	server5->iedName = "E1Q3SB1";
@@ -1938,7 +1938,7 @@ void init_webservers(mg_handler_t handler, void *(*serve)(void *)) {
 	mg_set_option(server5->mg, "auth_domain", "localhost");
 #endif
 	mg_add_uri_handler(server5->mg, "/", handler);
-	mg_start_thread(serve, server5->mg);
+	add_server(server5);
 
 	server6 = calloc(1, sizeof(ACSIServer));
 	server6->iedName = "E1Q3KA1";
@@ -1952,7 +1952,7 @@ void init_webservers(mg_handler_t handler, void *(*serve)(void *)) {
 	mg_set_option(server6->mg, "auth_domain", "localhost");
 #endif
 	mg_add_uri_handler(server6->mg, "/", handler);
-	mg_start_thread(serve, server6->mg);
+	add_server(server6);
 
 	server7 = calloc(1, sizeof(ACSIServer));
 	server7->iedName = "E1Q3KA2";
@@ -1966,7 +1966,7 @@ void init_webservers(mg_handler_t handler, void *(*serve)(void *)) {
 	mg_set_option(server7->mg, "auth_domain", "localhost");
 #endif
 	mg_add_uri_handler(server7->mg, "/", handler);
-	mg_start_thread(serve, server7->mg);
+	add_server(server7);
 
 	server8 = calloc(1, sizeof(ACSIServer));
 	server8->iedName = "E1Q3KA3";
@@ -1980,7 +1980,7 @@ void init_webservers(mg_handler_t handler, void *(*serve)(void *)) {
 	mg_set_option(server8->mg, "auth_domain", "localhost");
 #endif
 	mg_add_uri_handler(server8->mg, "/", handler);
-	mg_start_thread(serve, server8->mg);
+	add_server(server8);
 
 	server9 = calloc(1, sizeof(ACSIServer));
 	server9->iedName = "D1Q1SB1";
@@ -1994,7 +1994,7 @@ void init_webservers(mg_handler_t handler, void *(*serve)(void *)) {
 	mg_set_option(server9->mg, "auth_domain", "localhost");
 #endif
 	mg_add_uri_handler(server9->mg, "/", handler);
-	mg_start_thread(serve, server9->mg);
+	add_server(server9);
 
 	server10 = calloc(1, sizeof(ACSIServer));
 	server10->iedName = "D1Q1BP2";
@@ -2008,7 +2008,7 @@ void init_webservers(mg_handler_t handler, void *(*serve)(void *)) {
 	mg_set_option(server10->mg, "auth_domain", "localhost");
 #endif
 	mg_add_uri_handler(server10->mg, "/", handler);
-	mg_start_thread(serve, server10->mg);
+	add_server(server10);
 
 	server11 = calloc(1, sizeof(ACSIServer));
 	server11->iedName = "D1Q1BP3";
@@ -2022,7 +2022,7 @@ void init_webservers(mg_handler_t handler, void *(*serve)(void *)) {
 	mg_set_option(server11->mg, "auth_domain", "localhost");
 #endif
 	mg_add_uri_handler(server11->mg, "/", handler);
-	mg_start_thread(serve, server11->mg);
+	add_server(server11);
 
 	server12 = calloc(1, sizeof(ACSIServer));
 	server12->iedName = "D1Q1SB4";
@@ -2036,6 +2036,6 @@ void init_webservers(mg_handler_t handler, void *(*serve)(void *)) {
 	mg_set_option(server12->mg, "auth_domain", "localhost");
 #endif
 	mg_add_uri_handler(server12->mg, "/", handler);
-	mg_start_thread(serve, server12->mg);
+	add_server(server12);
 }
 
@@ -85,17 +85,35 @@ typedef struct Item {
 	char *FC;
 	TriggerOptionValue dchg;
 	TriggerOptionValue qchg;
+	unsigned long long version;	// data model version of the last change to this item, or to any of its sub-items
+	unsigned long long sample;	// value signature of a leaf item when its version was last updated
 } Item;
 
+#define ACSI_CLIENT_TABLE_SIZE	256		// hash buckets for the associated clients of each server; must be a power of two
+
 /**
- * Linked list definition for associated clients.
+ * An associated client, keyed by its binary address and port. Each client is in a hash bucket, for lookup, and in a
+ * list ordered by when it was last seen, for idle expiry.
  */
 typedef struct ACSIClient {
-	char ip[48];         		// max IPv6 string length is 45 characters
+	unsigned char address[16];	// IPv6 address, or IPv4-mapped IPv6 address (i.e., ::ffff:a.b.c.d)
 	int port;            		// client's port
-	struct ACSIClient *next;
+	unsigned long long lastSeen;	// ms
+	struct ACSIClient *next;	// next client in the same hash bucket
+	struct ACSIClient *older;
+	struct ACSIClient *newer;
 } ACSIClient;
 
+/**
+ * Hash table of the associated clients of a server. A zero-initialised table is empty.
+ */
+typedef struct ACSIClientTable {
+	ACSIClient *buckets[ACSI_CLIENT_TABLE_SIZE];
+	ACSIClient *oldest;			// least recently seen client, which is the first to expire
+	ACSIClient *newest;
+	int numberOfClients;
+} ACSIClientTable;
+
 /**
  * Defines an ACSI server, which contains a mongoose web server instance.
  */
@@ -103,7 +121,8 @@ typedef struct ACSIServer {
 	char *iedName;				// the name of the IED
 	char *apName;				// the name of the Access Point
 	struct mg_server *mg;		// mongoose web server instance
-	ACSIClient *clients;		// list of associated clients
+	ACSIClientTable clients;	// associated clients
+	struct JSONSubscription *subscriptions;	// list of open subscriptions (see jsonSubscribe.h)
 	Item *dataModel;			// pointer to root of data model index
 	unsigned long int ticks;
 //	void *customData;
@@ -144,9 +163,22 @@ typedef struct DataSet {
 void init_data_model_index();
 
 /**
- * Calls auto-generated function to start a webserver for each IED. Each server is started in a new thread to avoid blocking the main thread.
+ * Builds the hash table used by getIED(), getLD(), getLN() and getItemFromPath(), so that lookups do not depend on
+ * the size of the data model. Must be called after init_data_model_index().
+ */
+void init_data_model_lookup();
+
+/**
+ * Builds the table of cached definition and directory responses (see jsonCache.h). Each response is generated when it
+ * is first requested. Must be called after init_data_model_index().
+ */
+void init_json_cache();
+
+/**
+ * Calls auto-generated function to create a webserver for each IED. Each server is passed to add_server(), which
+ * either starts it in a new thread or adds it to a shared event loop, to avoid blocking the main thread.
  */
-void init_webservers(mg_handler_t handler, void *(*serve)(void *));
+void init_webservers(mg_handler_t handler, void (*add_server)(ACSIServer *));
 
 /**
  * Stores the data model index hierarchy.
@@ -22,7 +22,225 @@
 #if JSON_INTERFACE == 1
 
 #include "json.h"
+#include "jsonCache.h"
+#include "jsonCbor.h"
+#include "jsonClient.h"
+#include "jsonNumber.h"
+#include "jsonSubscribe.h"
+#include "jsonWriter.h"
+#include "latency.h"
 #include <pcap.h>
+#include <ctype.h>
+#ifdef _WIN32
+#include <ws2tcpip.h>
+#else
+#include <arpa/inet.h>
+#endif
+#ifdef __linux__
+#include <sys/epoll.h>
+#include <unistd.h>
+#endif
+#include <time.h>
+#include <wchar.h>
+
+#define ITEM_LOOKUP_MAX_PATH			512
+#define ITEM_LOOKUP_FNV_OFFSET			2166136261U
+#define ITEM_LOOKUP_FNV_PRIME			16777619U
+#define ITEM_SIGNATURE_FNV_OFFSET		14695981039346656037ULL
+#define ITEM_SIGNATURE_FNV_PRIME		1099511628211ULL
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define DATA_MODEL_VERSION_INCREMENT(ptr)	((unsigned long long) _InterlockedIncrement64((volatile long long *) (ptr)))
+#define DATA_MODEL_LOCK_ACQUIRE(ptr)		while (_InterlockedExchange((volatile long *) (ptr), 1) != 0) {}
+#define DATA_MODEL_LOCK_RELEASE(ptr)		_InterlockedExchange((volatile long *) (ptr), 0)
+#define JSON_THREAD_LOCAL					__declspec(thread)
+#else
+#define DATA_MODEL_VERSION_INCREMENT(ptr)	__sync_add_and_fetch(ptr, 1ULL)
+#define DATA_MODEL_LOCK_ACQUIRE(ptr)		while (__sync_lock_test_and_set(ptr, 1) != 0) {}
+#define DATA_MODEL_LOCK_RELEASE(ptr)		__sync_lock_release(ptr)
+#define JSON_THREAD_LOCAL					__thread
+#endif
+
+static volatile unsigned long long dataModelVersion = 0;
+static volatile long dataModelLock = 0;
+
+/**
+ * Entry in the hash table of all items, keyed by the full object reference with '/' between every level, e.g.,
+ * "E1Q1SB1/C1/TVTRa_1/Vol/instMag/f". Only the first Access Point of each IED is indexed, as for getLD().
+ */
+typedef struct ItemLookupEntry {
+	char *objectRef;
+	unsigned int hash;
+	Item *item;
+} ItemLookupEntry;
+
+static ItemLookupEntry *itemLookup = NULL;
+static unsigned int itemLookupMask = 0;
+
+// '.' and '/' are interchangeable in object references given to getItemFromPath()
+static unsigned int item_lookup_hash(unsigned int hash, const char *s, int len) {
+	int i = 0;
+
+	for (i = 0; i < len; i++) {
+		unsigned char c = (s[i] == '.') ? '/' : (unsigned char) s[i];
+		hash = (hash ^ c) * ITEM_LOOKUP_FNV_PRIME;
+	}
+
+	return hash;
+}
+
+static int item_lookup_matches(const char *objectRef, const char *s, int len) {
+	int i = 0;
+
+	for (i = 0; i < len; i++) {
+		if (objectRef[i] != ((s[i] == '.') ? '/' : s[i])) {
+			return 0;
+		}
+	}
+
+	return 1;
+}
+
+/**
+ * Internal helper function. Finds the item with the reference ied[/ref1[/ref2]], where ref1 and ref2 may be NULL.
+ */
+static Item *item_lookup_find(const char *ied, const char *ref1, int len1, const char *ref2, int len2) {
+	int iedLen = strlen(ied);
+	int keyLen = iedLen + ((ref1 != NULL) ? len1 + 1 : 0) + ((ref2 != NULL) ? len2 + 1 : 0);
+	unsigned int hash = item_lookup_hash(ITEM_LOOKUP_FNV_OFFSET, ied, iedLen);
+	unsigned int i = 0;
+
+	if (ref1 != NULL) {
+		hash = item_lookup_hash(hash, "/", 1);
+		hash = item_lookup_hash(hash, ref1, len1);
+	}
+	if (ref2 != NULL) {
+		hash = item_lookup_hash(hash, "/", 1);
+		hash = item_lookup_hash(hash, ref2, len2);
+	}
+
+	// linear probing; the table is never more than half full
+	for (i = hash & itemLookupMask; itemLookup[i].objectRef != NULL; i = (i + 1) & itemLookupMask) {
+		ItemLookupEntry *entry = &itemLookup[i];
+		char *key = entry->objectRef;
+
+		if (entry->hash != hash || (int) strlen(key) != keyLen || strncmp(key, ied, iedLen) != 0) {
+			continue;
+		}
+		key = &key[iedLen];
+		if (ref1 != NULL) {
+			if (key[0] != '/' || !item_lookup_matches(&key[1], ref1, len1)) {
+				continue;
+			}
+			key = &key[len1 + 1];
+		}
+		if (ref2 != NULL && (key[0] != '/' || !item_lookup_matches(&key[1], ref2, len2))) {
+			continue;
+		}
+
+		return entry->item;
+	}
+
+	return NULL;
+}
+
+static int item_lookup_count(Item *item) {
+	int count = 1;
+	int i = 0;
+
+	for (i = 0; item->items != NULL && i < item->numberOfItems; i++) {
+		count += item_lookup_count(&item->items[i]);
+	}
+
+	return count;
+}
+
+static void item_lookup_insert(Item *item, char *path, int pathLen) {
+	unsigned int hash = item_lookup_hash(ITEM_LOOKUP_FNV_OFFSET, path, pathLen);
+	unsigned int i = hash & itemLookupMask;
+
+	// the first of any items with the same reference is kept, as found by a linear search
+	while (itemLookup[i].objectRef != NULL) {
+		if (itemLookup[i].hash == hash && strcmp(itemLookup[i].objectRef, path) == 0) {
+			return;
+		}
+		i = (i + 1) & itemLookupMask;
+	}
+
+	itemLookup[i].objectRef = calloc(pathLen + 1, sizeof(char));
+	memcpy(itemLookup[i].objectRef, path, pathLen);
+	itemLookup[i].hash = hash;
+	itemLookup[i].item = item;
+}
+
+static void item_lookup_add_tree(Item *item, char *path, int pathLen) {
+	int i = 0;
+
+	item_lookup_insert(item, path, pathLen);
+
+	for (i = 0; item->items != NULL && i < item->numberOfItems; i++) {
+		int len = strlen(item->items[i].objectRef);
+
+		if (pathLen + len + 2 > ITEM_LOOKUP_MAX_PATH) {
+			continue;
+		}
+		path[pathLen] = '/';
+		memcpy(&path[pathLen + 1], item->items[i].objectRef, len + 1);
+		item_lookup_add_tree(&item->items[i], path, pathLen + len + 1);
+	}
+	path[pathLen] = '\0';
+}
+
+void init_data_model_lookup() {
+	char path[ITEM_LOOKUP_MAX_PATH];
+	unsigned int size = 2;
+	int count = 0;
+	int i = 0;
+
+	if (dataModelIndex.items == NULL || itemLookup != NULL) {
+		return;
+	}
+
+	// the Access Point level is not part of object references
+	for (i = 0; i < dataModelIndex.numberOfItems; i++) {
+		Item *ied = &dataModelIndex.items[i];
+
+		count++;
+		if (ied->items != NULL) {
+			count += item_lookup_count(&ied->items[0]) - 1;
+		}
+	}
+
+	while (size < (unsigned int) count * 2) {
+		size <<= 1;
+	}
+	itemLookup = (ItemLookupEntry *) calloc(size, sizeof(ItemLookupEntry));
+	itemLookupMask = size - 1;
+
+	for (i = 0; i < dataModelIndex.numberOfItems; i++) {
+		Item *ied = &dataModelIndex.items[i];
+		int len = strlen(ied->objectRef);
+		int j = 0;
+
+		if (len + 1 > ITEM_LOOKUP_MAX_PATH) {
+			continue;
+		}
+		memcpy(path, ied->objectRef, len + 1);
+		item_lookup_insert(ied, path, len);
+
+		for (j = 0; ied->items != NULL && ied->items[0].items != NULL && j < ied->items[0].numberOfItems; j++) {
+			int ldLen = strlen(ied->items[0].items[j].objectRef);
+
+			if (len + ldLen + 2 > ITEM_LOOKUP_MAX_PATH) {
+				continue;
+			}
+			path[len] = '/';
+			memcpy(&path[len + 1], ied->items[0].items[j].objectRef, ldLen + 1);
+			item_lookup_add_tree(&ied->items[0].items[j], path, len + ldLen + 1);
+		}
+	}
+}
 
 Item *getIED(char *iedObjectRef) {
 	// check contains at least one IED
@@ -30,6 +248,10 @@ Item *getIED(char *iedObjectRef) {
 		return NULL;
 	}
 
+	if (itemLookup != NULL) {
+		return item_lookup_find(iedObjectRef, NULL, 0, NULL, 0);
+	}
+
 	int i = 0;
 	for (i = 0; i < dataModelIndex.numberOfItems; i++) {
 		if (strcmp(iedObjectRef, dataModelIndex.items[i].objectRef) == 0) {
@@ -41,6 +263,10 @@ Item *getIED(char *iedObjectRef) {
 }
 
 Item *getLD(char *iedObjectRef, char *objectRef) {
+	if (itemLookup != NULL) {
+		return item_lookup_find(iedObjectRef, objectRef, strlen(objectRef), NULL, 0);
+	}
+
 	Item *ied = getIED(iedObjectRef);
 
 	// check IED exists
@@ -71,6 +297,10 @@ Item *getLD(char *iedObjectRef, char *objectRef) {
 }
 
 Item *getLN(char *iedObjectRef, char *LDObjectRef, char *objectRef) {
+	if (itemLookup != NULL) {
+		return item_lookup_find(iedObjectRef, LDObjectRef, strlen(LDObjectRef), objectRef, strlen(objectRef));
+	}
+
 	Item *LD = getLD(iedObjectRef, LDObjectRef);
 
 	if (LD == NULL) {
@@ -169,6 +399,11 @@ Item *getItemFromPath(char *iedObjectRef, char *objectRefPath) {
 		objectRefPathLen--;
 	}
 
+	// every level is in the lookup table, so the reference does not need to be split
+	if (itemLookup != NULL) {
+		return (objectRefPathLen > 0) ? item_lookup_find(iedObjectRef, objectRefPath, objectRefPathLen, NULL, 0) : NULL;
+	}
+
 	// create copy of object ref
 	char *objectRefPathCopy = calloc(objectRefPathLen + 1, sizeof(char));
 	memcpy(objectRefPathCopy, objectRefPath, objectRefPathLen);
@@ -215,7 +450,140 @@ Item *getItemFromPath(char *iedObjectRef, char *objectRefPath) {
 	return item;
 }
 
-int setItem(Item *item, char *input, int input_len) {
+static unsigned long long item_signature_hash(const unsigned char *data, size_t len) {
+	unsigned long long hash = ITEM_SIGNATURE_FNV_OFFSET;
+	size_t i = 0;
+
+	for (i = 0; i < len; i++) {
+		hash = (hash ^ data[i]) * ITEM_SIGNATURE_FNV_PRIME;
+	}
+
+	return hash;
+}
+
+unsigned long long itemValueSignature(Item *item) {
+	unsigned long long value = 0;
+	size_t size = 0;
+
+	switch (item->type) {
+		case BASIC_TYPE_BOOLEAN:
+			size = sizeof(CTYPE_BOOLEAN);
+			break;
+		case BASIC_TYPE_INT8:
+			size = sizeof(CTYPE_INT8);
+			break;
+		case BASIC_TYPE_INT16:
+			size = sizeof(CTYPE_INT16);
+			break;
+		case BASIC_TYPE_INT32:
+			size = sizeof(CTYPE_INT32);
+			break;
+		case BASIC_TYPE_INT64:
+			size = sizeof(CTYPE_INT64);
+			break;
+		case BASIC_TYPE_INT8U:
+			size = sizeof(CTYPE_INT8U);
+			break;
+		case BASIC_TYPE_INT16U:
+			size = sizeof(CTYPE_INT16U);
+			break;
+		case BASIC_TYPE_INT24U:
+			size = sizeof(CTYPE_INT24U);
+			break;
+		case BASIC_TYPE_INT32U:
+			size = sizeof(CTYPE_INT32U);
+			break;
+		case BASIC_TYPE_FLOAT32:
+			size = sizeof(CTYPE_FLOAT32);
+			break;
+		case BASIC_TYPE_FLOAT64:
+			size = sizeof(CTYPE_FLOAT64);
+			break;
+		case BASIC_TYPE_ENUMERATED:
+		case BASIC_TYPE_CODED_ENUM:
+			size = sizeof(CTYPE_ENUM);
+			break;
+		// all string types must be null-terminated in data model
+		case BASIC_TYPE_UNICODE_STRING:
+			return item_signature_hash((const unsigned char *) item->data, wcslen((const wchar_t *) item->data) * sizeof(wchar_t));
+		case BASIC_TYPE_OCTET_STRING:
+		case BASIC_TYPE_VISIBLE_STRING:
+		case BASIC_TYPE_CURRENCY:
+			return item_signature_hash((const unsigned char *) item->data, strlen((const char *) item->data));
+		default:
+			return 0;
+	}
+
+	memcpy(&value, item->data, (size < sizeof(value)) ? size : sizeof(value));
+	return value;
+}
+
+unsigned long long getDataModelVersion() {
+	return dataModelVersion;
+}
+
+void itemChanged(Item *item) {
+	unsigned long long sample = 0;
+
+	if (item == NULL || item->type == BASIC_TYPE_CONSTRUCTED || item->data == NULL) {
+		return;
+	}
+
+	sample = itemValueSignature(item);
+	if (sample != item->sample) {
+		item->sample = sample;
+		item->version = DATA_MODEL_VERSION_INCREMENT(&dataModelVersion);
+	}
+}
+
+/**
+ * Internal helper function for updateItemVersions(). All changes found in one update share a single new version, which
+ * is only allocated if there are any changes.
+ */
+static unsigned long long update_item_versions(Item *item, unsigned long long *newVersion) {
+	int i = 0;
+
+	if (item->type != BASIC_TYPE_CONSTRUCTED) {
+		if (item->data != NULL) {
+			unsigned long long sample = itemValueSignature(item);
+
+			if (sample != item->sample) {
+				if (*newVersion == 0) {
+					*newVersion = DATA_MODEL_VERSION_INCREMENT(&dataModelVersion);
+				}
+				item->sample = sample;
+				item->version = *newVersion;
+			}
+		}
+		return item->version;
+	}
+
+	item->version = 0;
+	for (i = 0; item->items != NULL && i < item->numberOfItems; i++) {
+		unsigned long long version = update_item_versions(&item->items[i], newVersion);
+
+		if (version > item->version) {
+			item->version = version;
+		}
+	}
+
+	return item->version;
+}
+
+unsigned long long updateItemVersions(Item *root) {
+	unsigned long long newVersion = 0;
+
+	if (root == NULL) {
+		return 0;
+	}
+
+	return update_item_versions(root, &newVersion);
+}
+
+/**
+ * Internal helper function for setItem().
+ */
+static int set_item_value(Item *item, char *input, int input_len) {
 	void *data = item->data;
 
 	if (item == NULL) {
@@ -302,6 +670,29 @@ int setItem(Item *item, char *input, int input_len) {
 	}
 }
 
+int setItem(Item *item, char *input, int input_len) {
+	int len = 0;
+
+	if (item == NULL) {
+		return 0;
+	}
+
+	len = set_item_value(item, input, input_len);
+	if (len > 0) {
+		itemChanged(item);
+	}
+
+	return len;
+}
+
+void lockDataModel() {
+	DATA_MODEL_LOCK_ACQUIRE(&dataModelLock);
+}
+
+void unlockDataModel() {
+	DATA_MODEL_LOCK_RELEASE(&dataModelLock);
+}
+
 int itemToJSON(char *buf, Item *item) {
 	void *data = item->data;
 	int i = 0;
@@ -312,36 +703,31 @@ int itemToJSON(char *buf, Item *item) {
 			// compound data types are not allowed
 			return 0;
 		case BASIC_TYPE_BOOLEAN:
-			if (*(CTYPE_BOOLEAN *) data == FALSE) {
-				return sprintf(buf, "false");
-			}
-			else {
-				return sprintf(buf, "true");
-			}
+			return jsonFormatBoolean(buf, *(CTYPE_BOOLEAN *) data != FALSE);
 		case BASIC_TYPE_INT8:
-			return sprintf(buf, "%d", *((CTYPE_INT8 *) data));
+			return jsonFormatInt32(buf, *((CTYPE_INT8 *) data));
 		case BASIC_TYPE_INT16:
-			return sprintf(buf, "%hd", *((CTYPE_INT16 *) data));
+			return jsonFormatInt32(buf, *((CTYPE_INT16 *) data));
 		case BASIC_TYPE_INT32:
-			return sprintf(buf, "%d", *((CTYPE_INT32 *) data));
+			return jsonFormatInt32(buf, *((CTYPE_INT32 *) data));
 		case BASIC_TYPE_INT64:
-			return sprintf(buf, "%ld", *((CTYPE_INT64 *) data));
+			return jsonFormatInt64(buf, *((CTYPE_INT64 *) data));
 		case BASIC_TYPE_INT8U:
-			return sprintf(buf, "%u", *((CTYPE_INT8U *) data));
+			return jsonFormatUint32(buf, *((CTYPE_INT8U *) data));
 		case BASIC_TYPE_INT16U:
-			return sprintf(buf, "%hu", *((CTYPE_INT16U *) data));
+			return jsonFormatUint32(buf, *((CTYPE_INT16U *) data));
 		case BASIC_TYPE_INT24U:
-			return sprintf(buf, "%u", *((CTYPE_INT24U *) data));	// TODO format correctly
+			return jsonFormatUint32(buf, *((CTYPE_INT24U *) data));	// TODO format correctly
 		case BASIC_TYPE_INT32U:
-			return sprintf(buf, "%u", *((CTYPE_INT32U *) data));
+			return jsonFormatUint32(buf, *((CTYPE_INT32U *) data));
 		case BASIC_TYPE_FLOAT32:
-			return sprintf(buf, "%f", *((CTYPE_FLOAT32 *) data));
+			return jsonFormatFloat32(buf, *((CTYPE_FLOAT32 *) data));
 		case BASIC_TYPE_FLOAT64:
-			return sprintf(buf, "%lf", *((CTYPE_FLOAT64 *) data));
+			return jsonFormatFloat64(buf, *((CTYPE_FLOAT64 *) data));
 		case BASIC_TYPE_ENUMERATED:
-			return sprintf(buf, "%u", *((CTYPE_ENUM *) data));
+			return jsonFormatUint32(buf, (unsigned int) *((CTYPE_ENUM *) data));
 		case BASIC_TYPE_CODED_ENUM:
-			return sprintf(buf, "%u", *((CTYPE_ENUM *) data));
+			return jsonFormatUint32(buf, (unsigned int) *((CTYPE_ENUM *) data));
 		// all string types must be null-terminated in data model
 		case BASIC_TYPE_OCTET_STRING:
 			len = strlen((const char *) data);
@@ -764,100 +1150,211 @@ int itemTreeToJSON(char *buf, Item *root) {
 
 
 
-unsigned char isClient(ACSIClient *client, char ip[48], int port) {
-	if (client == NULL) {
-		return FALSE;
-	}
+static unsigned long long client_now() {
+#ifdef _WIN32
+	return (unsigned long long) GetTickCount64();
+#else
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (unsigned long long) ts.tv_sec * 1000ULL + (unsigned long long) ts.tv_nsec / 1000000ULL;
+#endif
+}
 
-	if (strcmp(client->ip, ip) == 0 && client->port == port) {
+/**
+ * Converts an address string to the binary key of the client table. IPv4 addresses are mapped to IPv6 addresses, so
+ * that both kinds have the same key format.
+ */
+static unsigned char client_address(const char *ip, unsigned char address[16]) {
+	memset(address, 0, 16);
+	if (inet_pton(AF_INET, ip, &address[12]) == 1) {
+		address[10] = 0xFF;
+		address[11] = 0xFF;
 		return TRUE;
 	}
+	return inet_pton(AF_INET6, ip, address) == 1;
+}
+
+static unsigned int client_hash(const unsigned char address[16], int port) {
+	unsigned int hash = ITEM_LOOKUP_FNV_OFFSET;
+	int i = 0;
+
+	for (i = 0; i < 16; i++) {
+		hash = (hash ^ address[i]) * ITEM_LOOKUP_FNV_PRIME;
+	}
+	hash = (hash ^ (port & 0xFF)) * ITEM_LOOKUP_FNV_PRIME;
+	hash = (hash ^ ((port >> 8) & 0xFF)) * ITEM_LOOKUP_FNV_PRIME;
 
-	return FALSE;
+	return hash & (ACSI_CLIENT_TABLE_SIZE - 1);
 }
 
-ACSIClient *findClient(ACSIClient *client_list, char ip[48], int port) {
-	ACSIClient *client = client_list;
+static ACSIClient *client_lookup(ACSIClientTable *table, const unsigned char address[16], int port) {
+	ACSIClient *client = table->buckets[client_hash(address, port)];
 
 	while (client != NULL) {
-		if (isClient(client, ip, port)) {
+		if (client->port == port && memcmp(client->address, address, 16) == 0) {
 			return client;
 		}
-
 		client = client->next;
 	}
 
 	return NULL;
 }
 
-ACSIClient *addClient(ACSIClient *client_list, char ip[48], int port) {
-	if (client_list == NULL) {
-		client_list = (ACSIClient *) calloc(1, sizeof(ACSIClient));
-		memcpy(client_list->ip, ip, 48);
-		client_list->port = port;
-		return client_list;
+static void client_unlink_age(ACSIClientTable *table, ACSIClient *client) {
+	if (client->older != NULL) {
+		client->older->newer = client->newer;
+	}
+	else {
+		table->oldest = client->newer;
+	}
+	if (client->newer != NULL) {
+		client->newer->older = client->older;
+	}
+	else {
+		table->newest = client->older;
+	}
+	client->older = NULL;
+	client->newer = NULL;
+}
+
+static void client_link_newest(ACSIClientTable *table, ACSIClient *client) {
+	client->older = table->newest;
+	client->newer = NULL;
+	if (table->newest != NULL) {
+		table->newest->newer = client;
+	}
+	else {
+		table->oldest = client;
 	}
+	table->newest = client;
+}
 
-	ACSIClient *found = findClient(client_list, ip, port);
+static void client_unlink_bucket(ACSIClientTable *table, ACSIClient *client) {
+	ACSIClient **link = &table->buckets[client_hash(client->address, client->port)];
 
-	if (found == NULL) {
-		ACSIClient *end = client_list;
-		while (end->next != NULL) {
-			end = end->next;
+	while (*link != NULL) {
+		if (*link == client) {
+			*link = client->next;
+			client->next = NULL;
+			return;
 		}
+		link = &(*link)->next;
+	}
+}
 
-		end->next = (ACSIClient *) calloc(1, sizeof(ACSIClient));
-		memcpy(end->next->ip, ip, 48);
-		end->next->port = port;
-		return end->next;
+unsigned char isClient(ACSIClient *client, char ip[48], int port) {
+	unsigned char address[16];
 
-		return end;
-	}
-	else {
-		return found;
+	if (client == NULL || !client_address(ip, address)) {
+		return FALSE;
 	}
+
+	return client->port == port && memcmp(client->address, address, 16) == 0;
 }
 
-ACSIClient *removeClient(ACSIClient *client_list, ACSIClient *remove) {
-	if (client_list == NULL || remove == NULL) {
-		return client_list;
+ACSIClient *findClient(ACSIClientTable *table, char ip[48], int port) {
+	unsigned char address[16];
+
+	if (!client_address(ip, address)) {
+		return NULL;
 	}
 
-	if (client_list == remove) {
-		ACSIClient *next = client_list->next;
-		free(client_list);
-		return next;
+	return client_lookup(table, address, port);
+}
+
+ACSIClient *addClient(ACSIClientTable *table, char ip[48], int port) {
+	unsigned char address[16];
+	ACSIClient *client = NULL;
+	unsigned int hash = 0;
+
+	if (!client_address(ip, address)) {
+		return NULL;
 	}
 
-	ACSIClient *prev = client_list;
-	ACSIClient *client = prev->next;
+	client = client_lookup(table, address, port);
+	if (client != NULL) {
+		// the most recently seen client is already at the end of the list, which is the usual case when polling
+		if (client != table->newest) {
+			client_unlink_age(table, client);
+			client_link_newest(table, client);
+		}
+		client->lastSeen = client_now();
+		return client;
+	}
 
-	while (client != NULL) {
-		if (client == remove) {
-			prev->next = client->next;
-			free(client);
-			return client_list;
+	if (table->numberOfClients >= ACSI_MAX_CLIENTS && table->oldest != NULL) {
+		// the least recently seen client is reused for the new one
+		client = table->oldest;
+		client_unlink_age(table, client);
+		client_unlink_bucket(table, client);
+	}
+	else {
+		client = (ACSIClient *) calloc(1, sizeof(ACSIClient));
+		if (client == NULL) {
+			return NULL;
 		}
+		table->numberOfClients++;
+	}
 
-		prev = client;
-		client = client->next;
+	memcpy(client->address, address, 16);
+	client->port = port;
+	client->lastSeen = client_now();
+
+	hash = client_hash(address, port);
+	client->next = table->buckets[hash];
+	table->buckets[hash] = client;
+	client_link_newest(table, client);
+
+	return client;
+}
+
+void removeClient(ACSIClientTable *table, ACSIClient *remove) {
+	if (remove == NULL) {
+		return;
 	}
 
-	return client_list;
+	client_unlink_bucket(table, remove);
+	client_unlink_age(table, remove);
+	table->numberOfClients--;
+	free(remove);
+}
+
+void removeClientByConnection(ACSIClientTable *table, char ip[48], int port) {
+	removeClient(table, findClient(table, ip, port));
 }
 
-ACSIClient *removeClientByConnection(ACSIClient *client_list, char ip[48], int port) {
-	ACSIClient *found = findClient(client_list, ip, port);
-	return removeClient(client_list, found);
+int expireClients(ACSIClientTable *table) {
+	unsigned long long now = 0;
+	int removed = 0;
+
+	if (table->oldest == NULL) {
+		return 0;
+	}
+
+	now = client_now();
+	while (table->oldest != NULL && now - table->oldest->lastSeen >= ACSI_CLIENT_IDLE_TIME) {
+		removeClient(table, table->oldest);
+		removed++;
+	}
+
+	return removed;
 }
 
-void printClients(ACSIClient *client_list) {
-	ACSIClient *client = client_list;
+void printClients(ACSIClientTable *table) {
+	ACSIClient *client = table->oldest;
+	char ip[48];
 
 	printf("client_list:\n");
 	while (client != NULL) {
-		printf("  %s : %d\n", client->ip, client->port);
-		client = client->next;
+		if (client->address[10] == 0xFF && client->address[11] == 0xFF && memcmp(client->address, "\0\0\0\0\0\0\0\0\0\0", 10) == 0) {
+			inet_ntop(AF_INET, &client->address[12], ip, sizeof(ip));
+		}
+		else {
+			inet_ntop(AF_INET6, client->address, ip, sizeof(ip));
+		}
+		printf("  %s : %d\n", ip, client->port);
+		client = client->newer;
 	}
 	fflush(stdout);
 }
@@ -868,24 +1365,651 @@ void printClients(ACSIClient *client_list) {
 
 
 /**
- * Callback function which handles all HTTP requests.
+ * Queues the next chunk of a streamed response, once the previous chunks have been sent. Returns 1 when the response is
+ * complete, or if the connection has been closed, and 0 otherwise.
  */
-static int handle_http(struct mg_connection *conn) {
-	char *url = (char *) &conn->uri[1];	// exclude the starting '/'
-	Item *item;
-	ACSIServer *acsiServer = (ACSIServer *) conn->server_param;
-
-#ifdef USE_SSL
-#if USE_HTTP_AUTH == 1
-	static const char *passwords_file = "htpasswd.txt";
-	FILE *fp = fopen(passwords_file, "r");
+static int stream_http(struct mg_connection *conn) {
+	JSONWriter *writer = (JSONWriter *) conn->connection_param;
 
-	if (fp == NULL || !mg_authorize_digest(conn, fp)) {
-		mg_send_digest_auth_request(conn);
-		return 1;
+	if (conn->wsbits == 0) {
+		if (mg_get_queued_length(conn) >= JSON_WRITER_BUFFER_SIZE) {
+			return 0;
+		}
+		if (!jsonWriterStep(writer)) {
+			return 0;
+		}
 	}
 
-	if (fp != NULL) {
+	freeJSONWriter(writer);
+	conn->connection_param = NULL;
+	return 1;
+}
+
+#if JSON_COMPRESSION == 1
+/**
+ * Internal helper function. Returns TRUE if a content coding of the given length matches name, ignoring case.
+ */
+static unsigned char encoding_is(const char *coding, int codingLength, const char *name) {
+	int i = 0;
+
+	for (i = 0; i < codingLength; i++) {
+		if (name[i] == '\0' || tolower((unsigned char) coding[i]) != name[i]) {
+			return FALSE;
+		}
+	}
+	return name[codingLength] == '\0';
+}
+#endif
+
+/**
+ * Internal helper function. Returns the content coding for a response, from the Accept-Encoding request header, e.g.,
+ * "gzip, deflate;q=0.5". gzip is preferred to deflate, and codings with a quality value of zero are refused.
+ */
+static JSONContentEncoding accepted_encoding(struct mg_connection *conn) {
+#if JSON_COMPRESSION == 1
+	const char *accept = mg_get_header(conn, "Accept-Encoding");
+	JSONContentEncoding encoding = JSON_ENCODING_IDENTITY;
+
+	while (accept != NULL && *accept != '\0') {
+		int codingLength = 0;
+		int listLength = 0;
+		const char *quality = NULL;
+
+		while (*accept == ' ' || *accept == '\t' || *accept == ',') {
+			accept++;
+		}
+		codingLength = strcspn(accept, ",; \t");
+		listLength = strcspn(accept, ",");
+
+		quality = strstr(accept, "q=");
+		if (quality == NULL || quality >= accept + listLength || strtod(&quality[2], NULL) > 0.0) {
+			if (encoding_is(accept, codingLength, "gzip") || encoding_is(accept, codingLength, "*")) {
+				return JSON_ENCODING_GZIP;
+			}
+			if (encoding_is(accept, codingLength, "deflate")) {
+				encoding = JSON_ENCODING_DEFLATE;
+			}
+		}
+		accept += listLength;
+	}
+
+	return encoding;
+#else
+	return JSON_ENCODING_IDENTITY;
+#endif
+}
+
+/**
+ * Internal helper function. Sends the headers for a response body with the given content coding.
+ */
+static void send_encoding_headers(struct mg_connection *conn, JSONContentEncoding encoding) {
+#if JSON_COMPRESSION == 1
+	if (encoding == JSON_ENCODING_GZIP) {
+	    mg_send_header(conn, "Content-Encoding", "gzip");
+	}
+	else if (encoding == JSON_ENCODING_DEFLATE) {
+	    mg_send_header(conn, "Content-Encoding", "deflate");
+	}
+	// the body depends on the request headers, so shared caches must not send it for other requests
+    mg_send_header(conn, "Vary", "Accept-Encoding");
+#endif
+}
+
+/**
+ * Sends a cached response, or only its entity tag if the client already has the same response.
+ */
+static void send_cached_http(struct mg_connection *conn, JSONCachedResponse *cached) {
+	JSONContentEncoding encoding = accepted_encoding(conn);
+
+	if (cached->encoded[encoding] == NULL) {
+		encoding = JSON_ENCODING_IDENTITY;
+	}
+
+	if (cachedResponseMatches(cached, encoding, mg_get_header(conn, "If-None-Match"))) {
+		mg_send_status(conn, 304);
+	    mg_send_header(conn, "ETag", cached->etag[encoding]);
+	    mg_send_header(conn, "Cache-Control", "no-cache");
+	    mg_send_header(conn, "Access-Control-Allow-Origin", "*");
+		send_encoding_headers(conn, JSON_ENCODING_IDENTITY);
+		mg_write(conn, "\r\n", 2);	// a 304 response has no body, so the headers are terminated here
+		return;
+	}
+
+    mg_send_header(conn, "Content-Type", "application/json");
+    mg_send_header(conn, "Cache-Control", "no-cache");
+    mg_send_header(conn, "Access-Control-Allow-Origin", "*");
+    mg_send_header(conn, "ETag", cached->etag[encoding]);
+	send_encoding_headers(conn, encoding);
+	if (encoding != JSON_ENCODING_IDENTITY) {
+		mg_send_data(conn, cached->encoded[encoding], cached->encodedLength[encoding]);
+	}
+	else {
+		mg_send_data(conn, cached->data, cached->length);
+	}
+}
+
+/**
+ * Internal helper function. Copies a URL-encoded query string parameter, e.g., "C1%2FLN0.Mod", to a null-terminated
+ * string. Returns FALSE if it does not fit.
+ */
+static unsigned char decode_query_parameter(const char *src, int srcLen, char *dst, int dstSize) {
+	int i = 0;
+	int len = 0;
+
+	for (i = 0; i < srcLen; i++) {
+		if (len + 1 >= dstSize) {
+			return FALSE;
+		}
+		if (src[i] == '%' && i + 2 < srcLen && isxdigit((unsigned char) src[i + 1]) && isxdigit((unsigned char) src[i + 2])) {
+			char hex[3] = {src[i + 1], src[i + 2], '\0'};
+			dst[len++] = (char) strtol(hex, NULL, 16);
+			i += 2;
+		}
+		else {
+			dst[len++] = (src[i] == '+') ? ' ' : src[i];
+		}
+	}
+	dst[len] = '\0';
+
+	return TRUE;
+}
+
+/**
+ * Opens a Server-Sent Events response, which stays open until the client closes it. The query string lists the object
+ * references, e.g., "?ref=C1/MMXU1.PhV&ref=C1/XCBR1.Pos&period=100".
+ */
+static int subscribe_http(struct mg_connection *conn, ACSIServer *acsiServer) {
+	char ref[ITEM_LOOKUP_MAX_PATH];
+	const char *query = conn->query_string;
+	JSONSubscription *subscription = NULL;
+	Item *ied = getIED(acsiServer->iedName);
+	int period = 0;
+	int found = 0;
+
+	if (query != NULL && (query = strstr(query, ACSI_SUBSCRIBE_PERIOD)) != NULL) {
+		period = atoi(&query[strlen(ACSI_SUBSCRIBE_PERIOD)]);
+	}
+
+	subscription = createJSONSubscription(conn, period);
+	if (subscription == NULL || ied == NULL) {
+		freeJSONSubscription(subscription);
+		mg_send_status(conn, 500);
+		mg_send_data(conn, ACSI_NOT_POSSIBLE, strlen(ACSI_NOT_POSSIBLE));
+		return 1;
+	}
+
+	query = conn->query_string;
+	while (query != NULL && *query != '\0') {
+		const char *end = strchr(query, '&');
+		int len = (end != NULL) ? (int) (end - query) : (int) strlen(query);
+
+		if (strncmp(query, ACSI_SUBSCRIBE_REF, strlen(ACSI_SUBSCRIBE_REF)) == 0) {
+			int refLen = len - strlen(ACSI_SUBSCRIBE_REF);
+
+			if (!decode_query_parameter(&query[strlen(ACSI_SUBSCRIBE_REF)], refLen, ref, sizeof(ref)) || jsonSubscriptionAdd(subscription, ied, ref) < 0) {
+				found = -1;
+				break;
+			}
+			found++;
+		}
+
+		query = (end != NULL) ? &end[1] : NULL;
+	}
+
+	if (found <= 0) {
+		freeJSONSubscription(subscription);
+		mg_send_status(conn, 404);
+		mg_send_data(conn, ACSI_NOT_FOUND, strlen(ACSI_NOT_FOUND));
+		return 1;
+	}
+
+#if ACSI_AUTO_ASSOCIATE == 1
+	addClient(&acsiServer->clients, conn->remote_ip, conn->remote_port);
+#endif
+    mg_send_header(conn, "Content-Type", "text/event-stream");
+    mg_send_header(conn, "Cache-Control", "no-cache");
+    mg_send_header(conn, "Access-Control-Allow-Origin", "*");
+
+	// the first event has every value; the following events only have the values which have changed
+	jsonSubscriptionSendAll(subscription);
+	acsiServer->subscriptions = addJSONSubscription(acsiServer->subscriptions, subscription);
+	conn->connection_param = subscription;
+
+	return 0;
+}
+
+/**
+ * Keeps a subscription open, until the connection is closed. Events are sent by pollJSONSubscriptions().
+ */
+static int continue_subscription_http(struct mg_connection *conn, ACSIServer *acsiServer) {
+	JSONSubscription *subscription = (JSONSubscription *) conn->connection_param;
+
+	if (conn->wsbits == 0) {
+		return 0;
+	}
+
+	acsiServer->subscriptions = removeJSONSubscription(acsiServer->subscriptions, subscription);
+	freeJSONSubscription(subscription);
+	conn->connection_param = NULL;
+	return 1;
+}
+
+/**
+ * An object reference in a GetDataValues or SetDataValues request, and the value to set.
+ */
+typedef struct BatchEntry {
+	char *ref;					// decoded in place, within the copy of the request body
+	char *value;				// NULL for GetDataValues
+	int valueLength;
+	Item *item;					// NULL if the reference was not found
+} BatchEntry;
+
+static int batch_skip_space(const char *buf, int len, int pos) {
+	while (pos < len && (buf[pos] == ' ' || buf[pos] == '\t' || buf[pos] == '\r' || buf[pos] == '\n')) {
+		pos++;
+	}
+	return pos;
+}
+
+/**
+ * Decodes the JSON string starting at buf[pos], which must be '"', into the same buffer, and null-terminates it. The
+ * decoded string is never longer than the encoded string, so it ends before the closing quote. Returns the position
+ * after the closing quote, or -1 if the string is not valid.
+ */
+static int batch_parse_string(char *buf, int len, int pos, char **out, int *outLength) {
+	int written = 0;
+	char *dst = NULL;
+
+	if (pos >= len || buf[pos] != '"') {
+		return -1;
+	}
+	pos++;
+	dst = &buf[pos];
+
+	while (pos < len && buf[pos] != '"') {
+		if ((unsigned char) buf[pos] < 0x20) {
+			return -1;
+		}
+		if (buf[pos] != '\\') {
+			dst[written++] = buf[pos++];
+			continue;
+		}
+
+		if (++pos >= len) {
+			return -1;
+		}
+		switch (buf[pos]) {
+			case '"': dst[written++] = '"'; break;
+			case '\\': dst[written++] = '\\'; break;
+			case '/': dst[written++] = '/'; break;
+			case 'b': dst[written++] = '\b'; break;
+			case 'f': dst[written++] = '\f'; break;
+			case 'n': dst[written++] = '\n'; break;
+			case 'r': dst[written++] = '\r'; break;
+			case 't': dst[written++] = '\t'; break;
+			case 'u': {
+				// characters outside the Basic Multilingual Plane (surrogate pairs) are not supported
+				unsigned int code = 0;
+				int i = 0;
+
+				if (pos + 4 >= len) {
+					return -1;
+				}
+				for (i = 1; i <= 4; i++) {
+					if (!isxdigit((unsigned char) buf[pos + i])) {
+						return -1;
+					}
+					code = (code << 4) | (isdigit((unsigned char) buf[pos + i]) ? buf[pos + i] - '0' : (tolower((unsigned char) buf[pos + i]) - 'a' + 10));
+				}
+				pos += 4;
+
+				// "\uXXXX" is six bytes long, and its UTF-8 encoding is at most three
+				if (code < 0x80) {
+					dst[written++] = (char) code;
+				}
+				else if (code < 0x800) {
+					dst[written++] = (char) (0xC0 | (code >> 6));
+					dst[written++] = (char) (0x80 | (code & 0x3F));
+				}
+				else {
+					dst[written++] = (char) (0xE0 | (code >> 12));
+					dst[written++] = (char) (0x80 | ((code >> 6) & 0x3F));
+					dst[written++] = (char) (0x80 | (code & 0x3F));
+				}
+				break;
+			}
+			default:
+				return -1;
+		}
+		pos++;
+	}
+
+	if (pos >= len) {
+		return -1;
+	}
+	dst[written] = '\0';
+	*out = dst;
+	*outLength = written;
+
+	return pos + 1;
+}
+
+/**
+ * Parses a GetDataValues request, a JSON array of object references (e.g., ["C1/LN0.Mod.stVal", "C1/MMXU1.PhV"]), or a
+ * SetDataValues request, a JSON object of object references and values (e.g., {"C1/LN0.Mod.ctlVal" : 1}). Values may
+ * be strings, numbers or booleans, which are passed to setItem() as text. The body is decoded in place. Returns the
+ * number of entries, or -1 if the request is not valid.
+ */
+static int batch_parse(char *buf, int len, unsigned char withValues, BatchEntry **entries) {
+	BatchEntry *list = NULL;
+	int size = 0;
+	int count = 0;
+	int pos = batch_skip_space(buf, len, 0);
+	int i = 0;
+
+	if (pos >= len || buf[pos] != (withValues ? '{' : '[')) {
+		return -1;
+	}
+	pos = batch_skip_space(buf, len, pos + 1);
+
+	while (pos < len && buf[pos] != (withValues ? '}' : ']')) {
+		BatchEntry *entry = NULL;
+		int refLength = 0;
+
+		if (count > 0) {
+			if (buf[pos] != ',') {
+				free(list);
+				return -1;
+			}
+			pos = batch_skip_space(buf, len, pos + 1);
+		}
+
+		if (count == size) {
+			BatchEntry *grown = (BatchEntry *) realloc(list, (size > 0 ? size * 2 : 64) * sizeof(BatchEntry));
+			if (grown == NULL) {
+				free(list);
+				return -1;
+			}
+			list = grown;
+			size = (size > 0 ? size * 2 : 64);
+		}
+		entry = &list[count];
+		entry->value = NULL;
+		entry->valueLength = 0;
+		entry->item = NULL;
+
+		pos = batch_parse_string(buf, len, pos, &entry->ref, &refLength);
+		if (pos < 0) {
+			free(list);
+			return -1;
+		}
+		pos = batch_skip_space(buf, len, pos);
+
+		if (withValues) {
+			if (pos >= len || buf[pos] != ':') {
+				free(list);
+				return -1;
+			}
+			pos = batch_skip_space(buf, len, pos + 1);
+
+			if (pos < len && buf[pos] == '"') {
+				pos = batch_parse_string(buf, len, pos, &entry->value, &entry->valueLength);
+				if (pos < 0) {
+					free(list);
+					return -1;
+				}
+			}
+			else {
+				// a number or literal ends at the next delimiter, which is replaced by '\0' once the whole body is parsed
+				entry->value = &buf[pos];
+				while (pos < len && buf[pos] != ',' && buf[pos] != '}' && buf[pos] != ' ' && buf[pos] != '\t' && buf[pos] != '\r' && buf[pos] != '\n') {
+					pos++;
+				}
+				entry->valueLength = (int) (&buf[pos] - entry->value);
+				if (entry->valueLength == 0 || pos >= len) {
+					free(list);
+					return -1;
+				}
+			}
+			pos = batch_skip_space(buf, len, pos);
+		}
+
+		count++;
+	}
+
+	if (pos >= len || buf[pos] != (withValues ? '}' : ']')) {
+		free(list);
+		return -1;
+	}
+
+	for (i = 0; i < count; i++) {
+		if (list[i].value != NULL) {
+			list[i].value[list[i].valueLength] = '\0';
+		}
+	}
+
+	*entries = list;
+	return count;
+}
+
+/**
+ * Copies the body of a batch request, parses it, and looks up each object reference. Returns the number of entries, or
+ * -1 if the request is not valid. The caller must free() the body and the entries.
+ */
+static int batch_request(struct mg_connection *conn, ACSIServer *acsiServer, unsigned char withValues, char **body, BatchEntry **entries) {
+	int count = 0;
+	int i = 0;
+
+	*body = (char *) malloc(conn->content_len + 1);
+	*entries = NULL;
+	if (*body == NULL) {
+		return -1;
+	}
+	memcpy(*body, conn->content, conn->content_len);
+	(*body)[conn->content_len] = '\0';
+
+	count = batch_parse(*body, conn->content_len, withValues, entries);
+	for (i = 0; i < count; i++) {
+		(*entries)[i].item = getItemFromPath(acsiServer->iedName, (*entries)[i].ref);
+	}
+
+	return count;
+}
+
+/**
+ * Writes an object reference as a JSON or CBOR key, for references which are not in the data model.
+ */
+static void batch_write_key(JSONWriter *writer, const char *ref) {
+	int i = 0;
+
+	if (writer->binary) {
+		unsigned char head[JSON_CBOR_MAX_HEAD];
+		int refLength = strlen(ref);
+
+		jsonWriterWrite(writer, (const char *) head, cborEncodeHead(head, JSON_CBOR_MAJOR_TEXT, refLength));
+		jsonWriterWrite(writer, ref, refLength);
+		return;
+	}
+
+	jsonWriterWrite(writer, writer->pretty ? "    \"" : "\"", writer->pretty ? 5 : 1);
+	for (i = 0; ref[i] != '\0'; i++) {
+		if (ref[i] == '"' || ref[i] == '\\') {
+			jsonWriterWrite(writer, "\\", 1);
+			jsonWriterWrite(writer, &ref[i], 1);
+		}
+		else if ((unsigned char) ref[i] < 0x20) {
+			jsonWriterPrintf(writer, "\\u%04x", (unsigned char) ref[i]);
+		}
+		else {
+			jsonWriterWrite(writer, &ref[i], 1);
+		}
+	}
+	jsonWriterWrite(writer, writer->pretty ? "\" : " : "\":", writer->pretty ? 4 : 2);
+}
+
+/**
+ * Responds to a GetDataValues request with one document, of the form {"<reference>" : <value>, ...}. The value of each
+ * reference is as for a "get value" request, and is null if the reference is not found. All of the references are
+ * looked up and written in one pass, rather than streamed, so the values are read together.
+ */
+static int get_data_values_http(struct mg_connection *conn, ACSIServer *acsiServer) {
+	const char *accept = mg_get_header(conn, "Accept");
+	char *body = NULL;
+	BatchEntry *entries = NULL;
+	JSONWriter *writer = NULL;
+	int count = batch_request(conn, acsiServer, FALSE, &body, &entries);
+	int i = 0;
+
+	if (count < 0 || (writer = createJSONWriter(conn, NULL, JSON_WRITER_VALUES, JSON_OUTPUT_PRETTIFY)) == NULL) {
+		mg_send_status(conn, count < 0 ? 400 : 500);
+		mg_send_data(conn, ACSI_NOT_POSSIBLE, strlen(ACSI_NOT_POSSIBLE));
+		free(body);
+		free(entries);
+		return 1;
+	}
+
+#if ACSI_AUTO_ASSOCIATE == 1
+	addClient(&acsiServer->clients, conn->remote_ip, conn->remote_port);
+#endif
+	writer->binary = (accept != NULL && strstr(accept, ACSI_CBOR_MEDIA_TYPE) != NULL);
+	writer->member = TRUE;
+    mg_send_header(conn, "Content-Type", writer->binary ? ACSI_CBOR_MEDIA_TYPE : "application/json");
+    mg_send_header(conn, "Cache-Control", "no-cache");
+    mg_send_header(conn, "Access-Control-Allow-Origin", "*");
+
+	if (writer->binary) {
+		const char start = (char) JSON_CBOR_MAP_START;
+		jsonWriterWrite(writer, &start, 1);
+	}
+	else {
+		jsonWriterWrite(writer, writer->pretty ? "{\n" : "{", writer->pretty ? 2 : 1);
+	}
+
+	for (i = 0; i < count; i++) {
+		if (i > 0 && !writer->binary) {
+			jsonWriterWrite(writer, writer->pretty ? ",\n" : ",", writer->pretty ? 2 : 1);
+		}
+
+		if (entries[i].item != NULL) {
+			writer->name = entries[i].ref;
+			jsonWriterReset(writer, entries[i].item);
+			while (!jsonWriterStep(writer)) {
+			}
+		}
+		else {
+			batch_write_key(writer, entries[i].ref);
+			if (writer->binary) {
+				const char null = (char) JSON_CBOR_NULL;
+				jsonWriterWrite(writer, &null, 1);
+			}
+			else {
+				jsonWriterWrite(writer, "null", 4);
+			}
+		}
+	}
+
+	if (writer->binary) {
+		const char end = (char) JSON_CBOR_BREAK;
+		jsonWriterWrite(writer, &end, 1);
+	}
+	else {
+		jsonWriterWrite(writer, writer->pretty ? "\n}" : "}", writer->pretty ? 2 : 1);
+	}
+	jsonWriterFlush(writer);
+
+	freeJSONWriter(writer);
+	free(body);
+	free(entries);
+	return 1;
+}
+
+/**
+ * Responds to a SetDataValues request with one document, of the form {"<reference>" : "ok", ...}, giving the result of
+ * setting each value: ACSI_OK, ACSI_NOT_POSSIBLE, or ACSI_NOT_FOUND. The whole request is parsed and looked up before
+ * any value is set, and the values are then set while holding lockDataModel(), so that GOOSE and SV encoding which
+ * holds the same lock (as in emulate_IED()) sees either none or all of them.
+ */
+static int set_data_values_http(struct mg_connection *conn, ACSIServer *acsiServer) {
+	char *body = NULL;
+	BatchEntry *entries = NULL;
+	JSONWriter *writer = NULL;
+	const char **results = NULL;
+	int count = batch_request(conn, acsiServer, TRUE, &body, &entries);
+	int i = 0;
+
+	if (count < 0 || (results = (const char **) malloc((count + 1) * sizeof(const char *))) == NULL || (writer = createJSONWriter(conn, NULL, JSON_WRITER_VALUES, JSON_OUTPUT_PRETTIFY)) == NULL) {
+		mg_send_status(conn, count < 0 ? 400 : 500);
+		mg_send_data(conn, ACSI_NOT_POSSIBLE, strlen(ACSI_NOT_POSSIBLE));
+		free(results);
+		free(body);
+		free(entries);
+		return 1;
+	}
+
+	lockDataModel();
+	for (i = 0; i < count; i++) {
+		if (entries[i].item == NULL) {
+			results[i] = ACSI_NOT_FOUND;
+		}
+		else if (setItem(entries[i].item, entries[i].value, entries[i].valueLength) > 0) {
+			results[i] = ACSI_OK;
+		}
+		else {
+			results[i] = ACSI_NOT_POSSIBLE;
+		}
+	}
+	unlockDataModel();
+
+#if ACSI_AUTO_ASSOCIATE == 1
+	addClient(&acsiServer->clients, conn->remote_ip, conn->remote_port);
+#endif
+    mg_send_header(conn, "Content-Type", "application/json");
+    mg_send_header(conn, "Cache-Control", "no-cache");
+    mg_send_header(conn, "Access-Control-Allow-Origin", "*");
+
+	jsonWriterWrite(writer, writer->pretty ? "{\n" : "{", writer->pretty ? 2 : 1);
+	for (i = 0; i < count; i++) {
+		if (i > 0) {
+			jsonWriterWrite(writer, writer->pretty ? ",\n" : ",", writer->pretty ? 2 : 1);
+		}
+		batch_write_key(writer, entries[i].ref);
+		jsonWriterPrintf(writer, "\"%s\"", results[i]);
+	}
+	jsonWriterWrite(writer, writer->pretty ? "\n}" : "}", writer->pretty ? 2 : 1);
+	jsonWriterFlush(writer);
+
+	freeJSONWriter(writer);
+	free(results);
+	free(body);
+	free(entries);
+	return 1;
+}
+
+/**
+ * Handles an HTTP request for the IED served by acsiServer. The url excludes the starting '/', and any IED prefix.
+ */
+static int handle_acsi_http(struct mg_connection *conn, ACSIServer *acsiServer, char *url) {
+	Item *item;
+
+	// continue a response which is still being written, or an open subscription
+	if (conn->connection_param != NULL) {
+		if (strncmp(url, ACSI_SUBSCRIBE, strlen(ACSI_SUBSCRIBE)) == 0) {
+			return continue_subscription_http(conn, acsiServer);
+		}
+		return stream_http(conn);
+	}
+
+#ifdef USE_SSL
+#if USE_HTTP_AUTH == 1
+	static const char *passwords_file = "htpasswd.txt";
+	FILE *fp = fopen(passwords_file, "r");
+
+	if (fp == NULL || !mg_authorize_digest(conn, fp)) {
+		mg_send_digest_auth_request(conn);
+		return 1;
+	}
+
+	if (fp != NULL) {
 		fclose(fp);
 	}
 #endif
@@ -893,63 +2017,150 @@ static int handle_http(struct mg_connection *conn) {
 
 	// check for method names in url
 	if (strcmp(conn->request_method, "GET") == 0) {
-		int len = 0;
-		char printBuf[ACSI_RESPONSE_MAX_SIZE];
+		JSONWriterContent content = JSON_WRITER_VALUES;
 
 		if (strncmp(url, ACSI_GET_DEFINITION, strlen(ACSI_GET_DEFINITION)) == 0) {
 			item = getItemFromPath(acsiServer->iedName, (char *) &url[strlen(ACSI_GET_DEFINITION) + 1]);
-			len = itemDescriptionTreeToJSON(printBuf, item, FALSE);
+			content = JSON_WRITER_DEFINITION;
 		}
 		else if (strncmp(url, ACSI_GET_DIRECTORY, strlen(ACSI_GET_DIRECTORY)) == 0) {
 			item = getItemFromPath(acsiServer->iedName, (char *) &url[strlen(ACSI_GET_DIRECTORY) + 1]);
-			len = itemDescriptionTreeToJSON(printBuf, item, TRUE);
+			content = JSON_WRITER_DIRECTORY;
 		}
 //		else if (strncmp(url, "scd", strlen("scd")) == 0) {
 //		    mg_send_header(conn, "Content-Type", "application/xml");
 //			mg_send_data(conn, scd_file, strlen(scd_file));
 //		}
+#if LATENCY_STATS_SUPPORTED == 1
+		else if (strncmp(url, ACSI_GET_LATENCY, strlen(ACSI_GET_LATENCY)) == 0) {
+			char printBuf[ACSI_RESPONSE_MAX_SIZE];
+			int len = latencyStatsToJSON(printBuf, ACSI_RESPONSE_MAX_SIZE);
+
+			if (len == -1) {
+				mg_send_status(conn, 500);
+				mg_send_data(conn, ACSI_BUFFER_OVERRUN, strlen(ACSI_BUFFER_OVERRUN));
+				return 1;
+			}
+
+		    mg_send_header(conn, "Content-Type", "application/json");
+		    mg_send_header(conn, "Cache-Control", "no-cache");
+		    mg_send_header(conn, "Access-Control-Allow-Origin", "*");
+			mg_send_data(conn, printBuf, len);
+			return 1;
+		}
+#endif
+		else if (strncmp(url, ACSI_SUBSCRIBE, strlen(ACSI_SUBSCRIBE)) == 0) {
+			return subscribe_http(conn, acsiServer);
+		}
 		else if (strncmp(url, ACSI_ASSOCIATE, strlen(ACSI_ASSOCIATE)) == 0) {
-			acsiServer->clients = addClient(acsiServer->clients, conn->remote_ip, conn->remote_port);
+			addClient(&acsiServer->clients, conn->remote_ip, conn->remote_port);
 			mg_send_data(conn, ACSI_OK, strlen(ACSI_OK));
 			return 1;
 		}
 		else if (strncmp(url, ACSI_RELEASE, strlen(ACSI_RELEASE)) == 0) {
 			// TODO raise flag here, rather than remove?
-			acsiServer->clients = removeClientByConnection(acsiServer->clients, conn->remote_ip, conn->remote_port);
+			removeClientByConnection(&acsiServer->clients, conn->remote_ip, conn->remote_port);
 			mg_send_data(conn, ACSI_OK, strlen(ACSI_OK));
 			return 1;
 		}
 		else if (strncmp(url, ACSI_ABORT, strlen(ACSI_ABORT)) == 0) {
-			acsiServer->clients = removeClientByConnection(acsiServer->clients, conn->remote_ip, conn->remote_port);
+			removeClientByConnection(&acsiServer->clients, conn->remote_ip, conn->remote_port);
 			mg_send_data(conn, ACSI_OK, strlen(ACSI_OK));
 			return 1;
 		}
 		else {
 			item = getItemFromPath(acsiServer->iedName, (char *) url);
-			len = itemTreeToJSON(printBuf, item);
 		}
 
-		if (item != NULL && len == -1) {
-			mg_send_status(conn, 500);
-			mg_send_data(conn, ACSI_BUFFER_OVERRUN, strlen(ACSI_BUFFER_OVERRUN));
-			return 1;
-		}
-		else if (item != NULL && len > 0) {
+		if (item != NULL) {
+			// descriptions of the SCL structure never change, so are generated once and then sent from memory
+			JSONCachedResponse *cached = getCachedResponse(item, content);
+			JSONWriter *writer = NULL;
+			const char *since = (content == JSON_WRITER_VALUES && conn->query_string != NULL) ? strstr(conn->query_string, ACSI_SINCE) : NULL;
+			const char *accept = mg_get_header(conn, "Accept");
+			unsigned char binary = (content == JSON_WRITER_VALUES && accept != NULL && strstr(accept, ACSI_CBOR_MEDIA_TYPE) != NULL);
+			unsigned long long sinceVersion = 0;
+			JSONContentEncoding encoding = JSON_ENCODING_IDENTITY;
+			char version[24];
+
+			// values which have not changed since the version given by the client are left out
+			if (since != NULL) {
+				unsigned long long itemVersion = updateItemVersions(item);
+
+				// a version which this server has not reached (e.g., from before it was restarted) cannot be compared,
+				// so all values are sent, with the present version
+				sinceVersion = strtoull(&since[strlen(ACSI_SINCE)], NULL, 10);
+				if (sinceVersion > getDataModelVersion()) {
+					sinceVersion = 0;
+				}
+				if (itemVersion <= sinceVersion && sinceVersion != 0) {
+					sprintf(version, "%llu", getDataModelVersion());
+					mg_send_status(conn, 304);
+				    mg_send_header(conn, ACSI_VERSION_HEADER, version);
+				    mg_send_header(conn, "Access-Control-Expose-Headers", ACSI_VERSION_HEADER);
+				    mg_send_header(conn, "Cache-Control", "no-cache");
+				    mg_send_header(conn, "Access-Control-Allow-Origin", "*");
+					mg_write(conn, "\r\n", 2);	// a 304 response has no body, so the headers are terminated here
+					return 1;
+				}
+				sprintf(version, "%llu", getDataModelVersion());
+			}
+
+			if (cached != NULL) {
 #if ACSI_AUTO_ASSOCIATE == 1
-			acsiServer->clients = addClient(acsiServer->clients, conn->remote_ip, conn->remote_port);
+				addClient(&acsiServer->clients, conn->remote_ip, conn->remote_port);
 #endif
-		    mg_send_header(conn, "Content-Type", "application/json");
+				send_cached_http(conn, cached);
+				return 1;
+			}
+
+			// the response is written in chunks as the tree is walked, so there is no limit on its size
+			writer = createJSONWriter(conn, item, content, JSON_OUTPUT_PRETTIFY);
+			if (writer == NULL) {
+				mg_send_status(conn, 500);
+				mg_send_data(conn, ACSI_NOT_POSSIBLE, strlen(ACSI_NOT_POSSIBLE));
+				return 1;
+			}
+
+#if ACSI_AUTO_ASSOCIATE == 1
+			addClient(&acsiServer->clients, conn->remote_ip, conn->remote_port);
+#endif
+			writer->binary = binary;
+		    mg_send_header(conn, "Content-Type", binary ? ACSI_CBOR_MEDIA_TYPE : "application/json");
 		    mg_send_header(conn, "Cache-Control", "no-cache");
 		    mg_send_header(conn, "Access-Control-Allow-Origin", "*");
-			mg_send_data(conn, printBuf, len);
-//			printf("len: %d\n", len);
-//			fflush(stdout);
-			return 1;
+			// the output is compressed as it is written, so the whole response is never held in memory
+			encoding = accepted_encoding(conn);
+			send_encoding_headers(conn, jsonWriterCompress(writer, encoding) ? encoding : JSON_ENCODING_IDENTITY);
+			if (since != NULL) {
+				writer->since = sinceVersion;
+			    mg_send_header(conn, ACSI_VERSION_HEADER, version);
+			    mg_send_header(conn, "Access-Control-Expose-Headers", ACSI_VERSION_HEADER);
+			}
+			conn->connection_param = writer;
+			return stream_http(conn);
 		}
 	}
 	else if (strcmp(conn->request_method, "POST") == 0) {
+		const char *contentType = mg_get_header(conn, "Content-Type");
+		int setReturn = 0;
+
+		if (strcmp(url, ACSI_GET_DATA_VALUES) == 0) {
+			return get_data_values_http(conn, acsiServer);
+		}
+		else if (strcmp(url, ACSI_SET_DATA_VALUES) == 0) {
+			return set_data_values_http(conn, acsiServer);
+		}
+
 		item = getItemFromPath(acsiServer->iedName, (char *) url);
-		int setReturn = setItem(item, conn->content, conn->content_len);
+		lockDataModel();
+		if (contentType != NULL && strstr(contentType, ACSI_CBOR_MEDIA_TYPE) != NULL) {
+			setReturn = setItemFromCBOR(item, (const unsigned char *) conn->content, conn->content_len);
+		}
+		else {
+			setReturn = setItem(item, conn->content, conn->content_len);
+		}
+		unlockDataModel();
 
 //		printf("content: %.*s\n", conn->content_len, conn->content);
 //		fflush(stdout);
@@ -971,6 +2182,40 @@ static int handle_http(struct mg_connection *conn) {
 	return 1;
 }
 
+/**
+ * Callback function which handles all HTTP requests to the port of an individual IED.
+ */
+static int handle_http(struct mg_connection *conn) {
+	return handle_acsi_http(conn, (ACSIServer *) conn->server_param, (char *) &conn->uri[1]);	// exclude the starting '/'
+}
+
+#if ACSI_EVENT_LOOP == 1
+static ACSIServer **eventLoopIEDs = NULL;
+static int numberOfEventLoopIEDs = 0;
+static struct mg_server *eventLoopRouter = NULL;
+
+/**
+ * Callback function which handles HTTP requests to the shared port, of the form /<IED>/<LD>/<ObjectRef>, by routing them
+ * to the IED named by the first path segment.
+ */
+static int route_http(struct mg_connection *conn) {
+	const char *iedName = &conn->uri[1];
+	const char *end = strchr(iedName, '/');
+	size_t len = (end != NULL) ? (size_t) (end - iedName) : strlen(iedName);
+	int i = 0;
+
+	for (i = 0; i < numberOfEventLoopIEDs; i++) {
+		if (strlen(eventLoopIEDs[i]->iedName) == len && strncmp(eventLoopIEDs[i]->iedName, iedName, len) == 0) {
+			return handle_acsi_http(conn, eventLoopIEDs[i], (char *) ((end != NULL) ? end + 1 : iedName + len));
+		}
+	}
+
+	mg_send_status(conn, 404);
+	mg_send_data(conn, ACSI_NOT_FOUND, strlen(ACSI_NOT_FOUND));
+	return 1;
+}
+#endif
+
 #if EMULATE_IEDS == 1
 
 #define PI					3.1415926535897932384626433832795
@@ -1114,7 +2359,10 @@ void emulate_IED(ACSIServer *acsiServer) {
 			((struct IEC_61850_9_2LETCTR *) getLN(acsiServer->iedName, "C1", "IEC_61850_9_2LETCTR_3")->data)->Amp.instMag.i = toI(ln->A1.phsA.cVal.mag.f, harmonic(1, 1.0, theta - phi, + TWO_PI_OVER_THREE) + harmonic(2, 0.01, theta - phi, - TWO_PI_OVER_THREE) + harmonic(3, 0.05, theta - phi, 0) + harmonic(5, 0.05, theta - phi, - TWO_PI_OVER_THREE) + harmonic(7, 0.03, theta - phi, + TWO_PI_OVER_THREE) + harmonic(9, 0.03, theta - phi, 0));
 			((struct IEC_61850_9_2LETCTR *) getLN(acsiServer->iedName, "C1", "IEC_61850_9_2LETCTR_4")->data)->Amp.instMag.i = ((struct IEC_61850_9_2LETCTR *) getLN(acsiServer->iedName, "C1", "IEC_61850_9_2LETCTR_1")->data)->Amp.instMag.i + ((struct IEC_61850_9_2LETCTR *) getLN(acsiServer->iedName, "C1", "IEC_61850_9_2LETCTR_2")->data)->Amp.instMag.i + ((struct IEC_61850_9_2LETCTR *) getLN(acsiServer->iedName, "C1", "IEC_61850_9_2LETCTR_3")->data)->Amp.instMag.i;
 
+			// encodes while holding the lock, so that each message has either all or none of the values of a SetDataValues request
+			lockDataModel();
 			len = sv_update_JSON_C1_MSVCB01(bufOut);
+			unlockDataModel();
 			if (len > 0) {
 				pcap_sendpacket(fp, bufOut, len);
 			}
@@ -1124,17 +2372,97 @@ void emulate_IED(ACSIServer *acsiServer) {
 #endif
 
 /**
- * Internal helper function for processing HTTP events on threads.
+ * Returns how long a server can wait for network events, given the time until its next subscription is due (or -1).
  */
-static void *serve(void *server) {
+static int server_poll_time(int subscriptionTime) {
 #if EMULATE_IEDS == 1
+	return WEB_SERVER_SELECT_MAX_TIME;	// emulated IEDs are updated after every poll
+#else
+	if (subscriptionTime >= 0 && subscriptionTime < WEB_SERVER_IDLE_POLL_TIME) {
+		return subscriptionTime;
+	}
+	return WEB_SERVER_IDLE_POLL_TIME;
+#endif
+}
+
+#if ACSI_EVENT_LOOP == 1
+static struct mg_server **eventLoopServers = NULL;
+static int numberOfEventLoopServers = 0;
+
+int pollJSONInterface(int milliseconds) {
+	int nextTime = -1;
+	int subscriptionTime = 0;
+	int i = 0;
+
+	mg_poll_servers(eventLoopServers, numberOfEventLoopServers, milliseconds);
+
+	for (i = 0; i < numberOfEventLoopIEDs; i++) {
+		subscriptionTime = pollJSONSubscriptions(eventLoopIEDs[i]->subscriptions);
+		expireClients(&eventLoopIEDs[i]->clients);
+		if (subscriptionTime >= 0 && (nextTime < 0 || subscriptionTime < nextTime)) {
+			nextTime = subscriptionTime;
+		}
+#if EMULATE_IEDS == 1
+		emulate_IED(eventLoopIEDs[i]);
+#endif
+	}
+
+	return server_poll_time(nextTime);
+}
+
+int getJSONInterfaceFd() {
+#ifdef __linux__
+	static int fd = -1;
+	struct epoll_event ev;
+	int i = 0;
+
+	if (fd < 0 && numberOfEventLoopServers > 0) {
+		fd = epoll_create(numberOfEventLoopServers);
+		for (i = 0; i < numberOfEventLoopServers && fd >= 0; i++) {
+			memset(&ev, 0, sizeof(ev));
+			ev.events = EPOLLIN;
+			if (mg_get_poll_fd(eventLoopServers[i]) < 0 || epoll_ctl(fd, EPOLL_CTL_ADD, mg_get_poll_fd(eventLoopServers[i]), &ev) != 0) {
+				close(fd);
+				fd = -1;
+			}
+		}
+	}
+
+	return fd;
+#else
+	return -1;
+#endif
+}
+
+#if ACSI_EVENT_LOOP_THREAD == 1
+/**
+ * Internal helper function for processing HTTP events for all IEDs, and the shared port, on a single thread.
+ */
+static void *serve_event_loop(void *param) {
+	int pollTime = 0;
+
+	while (1) {
+		pollTime = pollJSONInterface(pollTime);
+	}
+	return NULL;
+}
+#endif
+#else
+/**
+ * Internal helper function for processing HTTP events on threads. The thread only wakes for network events, or when a
+ * subscription is due.
+ */
+static void *serve(void *server) {
 	ACSIServer *acsiServer = (ACSIServer *) mg_get_server_data((struct mg_server *) server);
+	int pollTime = 0;
+#if EMULATE_IEDS == 1
 	init_emulate_IED(acsiServer);
 #endif
 
 	while (1) {
-		// TODO add processing of associated clients here
-		mg_poll_server((struct mg_server *) server, WEB_SERVER_SELECT_MAX_TIME);
+		mg_poll_server((struct mg_server *) server, pollTime);
+		expireClients(&acsiServer->clients);
+		pollTime = server_poll_time(pollJSONSubscriptions(acsiServer->subscriptions));
 #if EMULATE_IEDS == 1
 		emulate_IED(acsiServer);
 #endif
@@ -1143,9 +2471,56 @@ static void *serve(void *server) {
 	}
 	return NULL;
 }
+#endif
+
+/**
+ * Called by init_webservers() for each IED, to start serving it.
+ */
+static void add_server(ACSIServer *acsiServer) {
+#if ACSI_EVENT_LOOP == 1
+	ACSIServer **ieds = (ACSIServer **) realloc(eventLoopIEDs, (numberOfEventLoopIEDs + 1) * sizeof(ACSIServer *));
+
+	if (ieds != NULL) {
+		eventLoopIEDs = ieds;
+		eventLoopIEDs[numberOfEventLoopIEDs++] = acsiServer;
+	}
+#else
+	mg_start_thread(serve, acsiServer->mg);
+#endif
+}
 
 void start_json_interface() {
-	init_webservers(&handle_http, serve);
+#if ACSI_EVENT_LOOP == 1
+	int i = 0;
+#endif
+
+	init_webservers(&handle_http, add_server);
+
+#if ACSI_EVENT_LOOP == 1
+	eventLoopRouter = mg_create_server(NULL);
+#ifndef USE_SSL
+	mg_set_option(eventLoopRouter, "listening_port", ACSI_EVENT_LOOP_PORT);
+#else
+	mg_set_option(eventLoopRouter, "listening_port", ACSI_EVENT_LOOP_PORT "s");
+	mg_set_option(eventLoopRouter, "ssl_certificate", "ssl_cert.pem");
+	mg_set_option(eventLoopRouter, "auth_domain", "localhost");
+#endif
+	mg_add_uri_handler(eventLoopRouter, "/", route_http);
+
+	eventLoopServers = (struct mg_server **) calloc(numberOfEventLoopIEDs + 1, sizeof(struct mg_server *));
+	if (eventLoopServers != NULL) {
+		for (i = 0; i < numberOfEventLoopIEDs; i++) {
+			eventLoopServers[numberOfEventLoopServers++] = eventLoopIEDs[i]->mg;
+#if EMULATE_IEDS == 1
+			init_emulate_IED(eventLoopIEDs[i]);
+#endif
+		}
+		eventLoopServers[numberOfEventLoopServers++] = eventLoopRouter;
+	}
+#if ACSI_EVENT_LOOP_THREAD == 1
+	mg_start_thread(serve_event_loop, NULL);
+#endif
+#endif
 
 #if EMULATE_IEDS == 1
 	fp = init_pcap();
@@ -1201,14 +2576,42 @@ char *wget(const char *host, int port, int *len, const char *fmt, ...) {
 	return reply;
 }
 
+// each thread has its own client, so that a slow request does not hold up requests from other threads
+static JSON_THREAD_LOCAL JSONClient *defaultClient = NULL;
+
+/**
+ * Sends a request on a connection of the calling thread's client, and returns a malloc-ed copy of the response body.
+ */
+static char *send_http_request(int port, int *len, const char *method, char *url, char *value) {
+	JSONClientRequest request;
+	char *reply = NULL;
+
+	memset(&request, 0, sizeof(request));
+	request.method = method;
+	request.url = url;
+	request.body = value;
+	request.bodyLength = (value != NULL) ? strlen(value) : 0;
+
+	if (defaultClient == NULL) {
+		defaultClient = createJSONClient();
+	}
+	if (defaultClient != NULL && jsonClientRequest(defaultClient, "localhost", port, &request) > 0) {
+		reply = (char *) malloc(request.responseLength + 1);
+		if (reply != NULL) {
+			memcpy(reply, request.response, request.responseLength + 1);
+			*len = request.responseLength;
+		}
+	}
+
+	return reply;
+}
+
 char *send_http_request_get(int port, int *len, char *url) {
-	return wget("localhost", port, len, "GET %s HTTP/1.0\r\n\r\n", url);
+	return send_http_request(port, len, "GET", url, NULL);
 }
 
 char *send_http_request_post(int port, int *len, char *url, char *value) {
-	int value_len = strlen(value);
-	return wget("localhost", port, len, "POST %s HTTP/1.0\r\nHost: localhost\r\nContent-Type: text/html\r\nContent-Length: %d\r\n\r\n%s\r\n\r\n", url, value_len, value);
+	return send_http_request(port, len, "POST", url, value);
 }
 
-
 #endif
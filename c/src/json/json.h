@@ -45,11 +45,19 @@ extern "C" {
 #include "ied.h"
 #include "datatypes.h"
 
-#define WEB_SERVER_SELECT_MAX_TIME		5	// ms
+#define WEB_SERVER_SELECT_MAX_TIME		5	// ms; poll interval when EMULATE_IEDS == 1
+#define WEB_SERVER_IDLE_POLL_TIME		1000	// ms; longest wait for network events when no subscription is due
 #define EMULATED_IED_REFRESH_TIME		(WEB_SERVER_SELECT_MAX_TIME * 10)
 #define JSON_OUTPUT_PRETTIFY			1
+#define JSON_COMPRESSION				0		// set to 1 to compress responses with zlib (link with -lz) if the client accepts gzip or deflate
+#define JSON_COMPRESSION_LEVEL			6		// from 1 (fastest) to 9 (smallest)
+#define JSON_COMPRESSION_MIN_SIZE		512		// bytes; smaller cached responses are always sent uncompressed
 #define JSON_USE_HTTP_AUTH				0
+#define ACSI_EVENT_LOOP					0		// set to 1 to serve all IEDs from a single thread, rather than one thread per IED
+#define ACSI_EVENT_LOOP_PORT			"8000"	// if ACSI_EVENT_LOOP == 1, all IEDs are also served on this port, as /<IED>/...
+#define ACSI_EVENT_LOOP_THREAD			1		// if ACSI_EVENT_LOOP == 1, set to 0 to run the loop from the application instead, with pollJSONInterface()
 
+// limits the buffer-based functions below; HTTP responses for the data model are streamed without a limit (see jsonWriter.h)
 #if JSON_OUTPUT_PRETTIFY == 1
 #define ACSI_RESPONSE_MAX_SIZE			64000
 #else
@@ -57,11 +65,22 @@ extern "C" {
 #endif
 #define ACSI_RESPONSE_SIZE_WARNING		128
 #define ACSI_AUTO_ASSOCIATE				1
+#define ACSI_MAX_CLIENTS				1024	// per server; the least recently seen client is replaced when there are more
+#define ACSI_CLIENT_IDLE_TIME			300000	// ms; clients which have not made a request for this long are released
 #define ACSI_ASSOCIATE					"associate"
 #define ACSI_RELEASE					"release"
 #define ACSI_ABORT						"abort"
 #define ACSI_GET_DEFINITION				"definition"
 #define ACSI_GET_DIRECTORY				"directory"
+#define ACSI_GET_LATENCY				"latency"		// per-control-block latency percentiles, if LATENCY_STATS_SUPPORTED == 1
+#define ACSI_SUBSCRIBE					"subscribe"		// Server-Sent Events of changed values (see jsonSubscribe.h)
+#define ACSI_SUBSCRIBE_REF				"ref="
+#define ACSI_SUBSCRIBE_PERIOD			"period="
+#define ACSI_SINCE						"since="		// query string parameter for values changed after a data model version
+#define ACSI_VERSION_HEADER				"X-Data-Model-Version"
+#define ACSI_CBOR_MEDIA_TYPE			"application/cbor"	// binary alternative to JSON, for values (see jsonCbor.h)
+#define ACSI_GET_DATA_VALUES			"GetDataValues"	// POST a list of object references, to get all of their values at once
+#define ACSI_SET_DATA_VALUES			"SetDataValues"	// POST object references and values, to set them all at once
 #define ACSI_OK							"ok"
 #define ACSI_NOT_POSSIBLE				"not possible"
 #define ACSI_NOT_FOUND					"404"
@@ -91,6 +110,44 @@ Item *getItemFromPath(char *iedObjectRef, char *objectRefPath);
  */
 int setItem(Item *item, char *input, int input_len);
 
+/**
+ * Stops values being set over the JSON interface until unlockDataModel() is called. Each request sets all of its values
+ * while holding this lock, so an application which encodes GOOSE or SV messages from values which are set over the JSON
+ * interface can hold it while encoding, to see either all or none of the values of each request. The generated
+ * gse_send_*() and sv_update_*() functions do not take this lock themselves, so a request is only atomic with respect to
+ * encoders which are called while holding it. The lock spins, so it must only be held briefly.
+ */
+void lockDataModel();
+
+/**
+ * Releases the lock taken by lockDataModel().
+ */
+void unlockDataModel();
+
+/**
+ * Returns a copy of the value of a leaf data item, or a hash of the value for strings. The result changes whenever the
+ * value changes, so it can be used to find changes without formatting values.
+ */
+unsigned long long itemValueSignature(Item *item);
+
+/**
+ * Returns the current data model version, which is shared by all IEDs and increases whenever changes are recorded.
+ */
+unsigned long long getDataModelVersion();
+
+/**
+ * Records a change to a leaf data item, by giving it a new data model version, if its value differs from when it was last
+ * recorded. setItem() calls this; other code which writes to the data model may call it, but does not need to, because
+ * updateItemVersions() finds any other changes.
+ */
+void itemChanged(Item *item);
+
+/**
+ * Records any changes to the leaf data items within root, and sets the version of each constructed item to the latest
+ * version of its sub-items. Returns the version of root.
+ */
+unsigned long long updateItemVersions(Item *root);
+
 /**
  * Prints leaf data items to the specified buffer. The buffer must be large enough. Returns the number of characters printed.
  */
@@ -129,26 +186,56 @@ int itemDescriptionTreeToJSON(char *buf, Item *root, unsigned char deep);
  */
 void start_json_interface();
 
+#if ACSI_EVENT_LOOP == 1
+/**
+ * Processes the network events of all IEDs, waiting for up to the given number of milliseconds if there are none, and
+ * sends any subscription updates which are due. Returns the time, in milliseconds, which can be waited before the
+ * next call. Must always be called from the same thread.
+ */
+int pollJSONInterface(int milliseconds);
+
+/**
+ * Returns a descriptor which becomes readable when pollJSONInterface() has network events to process, so that an
+ * application can wait for these together with its own (e.g., from pcap_get_selectable_fd()), or -1 if there is none.
+ */
+int getJSONInterfaceFd();
+#endif
+
 /**
- * Send an HTTP request to a server.
+ * Send an HTTP request to a server on localhost. The connection is kept open, and reused for later requests from the
+ * same thread to the same port. Returns a malloc-ed copy of the response body (without headers), or NULL if there was no response.
  */
 char *send_http_request_get(int port, int *len, char *url);
 
 /**
- * Send an HTTP POST request to a server.
+ * Send an HTTP POST request to a server on localhost, in the same way as send_http_request_get().
  */
 char *send_http_request_post(int port, int *len, char *url, char *value);
 
 
+/**
+ * Returns TRUE if a client has the given address, as a string (e.g., from mg_connection.remote_ip), and port.
+ */
 unsigned char isClient(ACSIClient *client, char ip[48], int port);
 
-ACSIClient *findClient(ACSIClient *client_list, char ip[48], int port);
+ACSIClient *findClient(ACSIClientTable *table, char ip[48], int port);
+
+/**
+ * Associates a client with a server, or updates when it was last seen if it is already associated. If the table has
+ * ACSI_MAX_CLIENTS clients, the least recently seen is replaced. Returns the client, or NULL if ip is not a valid
+ * address or memory cannot be allocated.
+ */
+ACSIClient *addClient(ACSIClientTable *table, char ip[48], int port);
 
-ACSIClient *addClient(ACSIClient *client_list, char ip[48], int port);
+void removeClient(ACSIClientTable *table, ACSIClient *remove);
 
-ACSIClient *removeClient(ACSIClient *client_list, ACSIClient *remove);
+void removeClientByConnection(ACSIClientTable *table, char ip[48], int port);
 
-ACSIClient *removeClientByConnection(ACSIClient *client_list, char ip[48], int port);
+/**
+ * Releases the clients which have not been seen for ACSI_CLIENT_IDLE_TIME. Must be called from the thread which polls
+ * the server of the table. Returns the number of clients released.
+ */
+int expireClients(ACSIClientTable *table);
 
 
 #ifdef __cplusplus /* If this is a C++ compiler, end C linkage */
@@ -0,0 +1,244 @@
+/**
+ * Rapid-prototyping protection schemes with IEC 61850
+ *
+ * Copyright (c) 2014 Steven Blair
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include "ctypes.h"
+#if JSON_INTERFACE == 1
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "json.h"
+#include "jsonCache.h"
+#if JSON_COMPRESSION == 1
+#include <zlib.h>
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define JSON_CACHE_CAS(ptr, old, new)		(_InterlockedCompareExchangePointer((void * volatile *) (ptr), (new), (old)) == (old))
+#else
+#define JSON_CACHE_CAS(ptr, old, new)		__sync_bool_compare_and_swap(ptr, old, new)
+#endif
+
+#define JSON_CACHE_FNV_OFFSET				14695981039346656037ULL
+#define JSON_CACHE_FNV_PRIME				1099511628211ULL
+
+/**
+ * Entry in the hash table of all items, keyed by the address of the item. The table is filled by init_json_cache(),
+ * and only the response pointers change afterwards, each exactly once.
+ */
+typedef struct JSONCacheEntry {
+	Item *item;
+	JSONCachedResponse *volatile responses[2];	// definition and directory
+} JSONCacheEntry;
+
+static JSONCacheEntry *jsonCache = NULL;
+static unsigned int jsonCacheMask = 0;
+
+static unsigned int json_cache_hash(Item *item) {
+	unsigned long long key = (unsigned long long) (size_t) item;
+
+	return (unsigned int) ((key * 0x9E3779B97F4A7C15ULL) >> 32);
+}
+
+static int json_cache_count(Item *item) {
+	int count = 1;
+	int i = 0;
+
+	for (i = 0; item->items != NULL && i < item->numberOfItems; i++) {
+		count += json_cache_count(&item->items[i]);
+	}
+
+	return count;
+}
+
+static void json_cache_insert(Item *item) {
+	unsigned int slot = json_cache_hash(item) & jsonCacheMask;
+	int i = 0;
+
+	while (jsonCache[slot].item != NULL && jsonCache[slot].item != item) {
+		slot = (slot + 1) & jsonCacheMask;
+	}
+	jsonCache[slot].item = item;
+
+	for (i = 0; item->items != NULL && i < item->numberOfItems; i++) {
+		json_cache_insert(&item->items[i]);
+	}
+}
+
+static JSONCacheEntry *json_cache_find(Item *item) {
+	unsigned int slot = json_cache_hash(item) & jsonCacheMask;
+
+	while (jsonCache[slot].item != NULL) {
+		if (jsonCache[slot].item == item) {
+			return &jsonCache[slot];
+		}
+		slot = (slot + 1) & jsonCacheMask;
+	}
+
+	return NULL;
+}
+
+void init_json_cache() {
+	unsigned int size = 2;
+	int count = 0;
+	int i = 0;
+
+	if (dataModelIndex.items == NULL || jsonCache != NULL) {
+		return;
+	}
+
+	for (i = 0; i < dataModelIndex.numberOfItems; i++) {
+		count += json_cache_count(&dataModelIndex.items[i]);
+	}
+
+	while (size < (unsigned int) count * 2) {
+		size <<= 1;
+	}
+	jsonCache = (JSONCacheEntry *) calloc(size, sizeof(JSONCacheEntry));
+	if (jsonCache == NULL) {
+		return;
+	}
+	jsonCacheMask = size - 1;
+
+	for (i = 0; i < dataModelIndex.numberOfItems; i++) {
+		json_cache_insert(&dataModelIndex.items[i]);
+	}
+}
+
+#if JSON_COMPRESSION == 1
+/**
+ * Compresses a whole response body in one step, with a gzip (windowBits of MAX_WBITS + 16) or zlib (MAX_WBITS) header.
+ * Returns NULL if memory cannot be allocated, or if the compressed body would not be smaller.
+ */
+static char *json_cache_compress(const char *data, int length, int windowBits, int *compressedLength) {
+	z_stream stream;
+	char *compressed = NULL;
+	uLong bound = 0;
+
+	memset(&stream, 0, sizeof(stream));
+	if (deflateInit2(&stream, Z_BEST_COMPRESSION, Z_DEFLATED, windowBits, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+		return NULL;
+	}
+
+	bound = deflateBound(&stream, length) + 18;		// older versions of deflateBound() leave out the gzip header and trailer
+	compressed = (char *) malloc(bound);
+	if (compressed != NULL) {
+		stream.next_in = (Bytef *) data;
+		stream.avail_in = length;
+		stream.next_out = (Bytef *) compressed;
+		stream.avail_out = bound;
+		if (deflate(&stream, Z_FINISH) == Z_STREAM_END && stream.total_out < (uLong) length) {
+			*compressedLength = (int) stream.total_out;
+		}
+		else {
+			free(compressed);
+			compressed = NULL;
+		}
+	}
+
+	deflateEnd(&stream);
+	return compressed;
+}
+#endif
+
+static JSONCachedResponse *json_cache_create(Item *item, JSONWriterContent content) {
+	JSONCachedResponse *response = (JSONCachedResponse *) calloc(1, sizeof(JSONCachedResponse));
+	unsigned long long hash = JSON_CACHE_FNV_OFFSET;
+	int i = 0;
+
+	if (response == NULL) {
+		return NULL;
+	}
+
+	response->data = jsonWriterToString(item, content, JSON_OUTPUT_PRETTIFY, &response->length);
+	if (response->data == NULL) {
+		free(response);
+		return NULL;
+	}
+
+	for (i = 0; i < response->length; i++) {
+		hash = (hash ^ (unsigned char) response->data[i]) * JSON_CACHE_FNV_PRIME;
+	}
+	snprintf(response->etag[JSON_ENCODING_IDENTITY], JSON_CACHE_ETAG_LENGTH, "\"%016llx\"", hash);
+	snprintf(response->etag[JSON_ENCODING_GZIP], JSON_CACHE_ETAG_LENGTH, "\"%016llx-gzip\"", hash);
+	snprintf(response->etag[JSON_ENCODING_DEFLATE], JSON_CACHE_ETAG_LENGTH, "\"%016llx-deflate\"", hash);
+
+#if JSON_COMPRESSION == 1
+	// the response is compressed once, so the best compression is worth its time
+	if (response->length >= JSON_COMPRESSION_MIN_SIZE) {
+		response->encoded[JSON_ENCODING_GZIP] = json_cache_compress(response->data, response->length, MAX_WBITS + 16, &response->encodedLength[JSON_ENCODING_GZIP]);
+		response->encoded[JSON_ENCODING_DEFLATE] = json_cache_compress(response->data, response->length, MAX_WBITS, &response->encodedLength[JSON_ENCODING_DEFLATE]);
+	}
+#endif
+
+	return response;
+}
+
+JSONCachedResponse *getCachedResponse(Item *item, JSONWriterContent content) {
+	JSONCacheEntry *entry = NULL;
+	JSONCachedResponse *response = NULL;
+	JSONCachedResponse *volatile *slot = NULL;
+
+	if (jsonCache == NULL || item == NULL || (content != JSON_WRITER_DEFINITION && content != JSON_WRITER_DIRECTORY)) {
+		return NULL;
+	}
+
+	entry = json_cache_find(item);
+	if (entry == NULL) {
+		return NULL;
+	}
+
+	slot = &entry->responses[content == JSON_WRITER_DIRECTORY ? 1 : 0];
+	response = *slot;
+	if (response != NULL) {
+		return response;
+	}
+
+	response = json_cache_create(item, content);
+	if (response != NULL && !JSON_CACHE_CAS(slot, NULL, response)) {
+		// another thread has generated the same response; use that one instead
+		free(response->encoded[JSON_ENCODING_GZIP]);
+		free(response->encoded[JSON_ENCODING_DEFLATE]);
+		free(response->data);
+		free(response);
+		response = *slot;
+	}
+
+	return response;
+}
+
+unsigned char cachedResponseMatches(JSONCachedResponse *response, JSONContentEncoding encoding, const char *ifNoneMatch) {
+	if (ifNoneMatch == NULL) {
+		return FALSE;
+	}
+
+	while (*ifNoneMatch == ' ') {
+		ifNoneMatch++;
+	}
+	if (ifNoneMatch[0] == '*') {
+		return TRUE;
+	}
+
+	// a list of entity tags, any of which may be weak, e.g., W/"0123456789abcdef", "fedcba9876543210"
+	return strstr(ifNoneMatch, response->etag[encoding]) != NULL;
+}
+
+#endif
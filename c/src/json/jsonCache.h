@@ -0,0 +1,72 @@
+/**
+ * Rapid-prototyping protection schemes with IEC 61850
+ *
+ * Copyright (c) 2014 Steven Blair
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include "ctypes.h"
+#if JSON_INTERFACE == 1
+
+#ifndef JSON_CACHE_H
+#define JSON_CACHE_H
+
+#ifdef __cplusplus /* If this is a C++ compiler, use C linkage */
+extern "C" {
+#endif
+
+
+#include "dataModelIndex.h"
+#include "jsonWriter.h"
+
+#define JSON_CACHE_ETAG_LENGTH			32		// a quoted 64-bit hash and content coding, e.g., "\"0123456789abcdef-deflate\"", and a null character
+
+/**
+ * A complete response body which is generated once, and never changes. If JSON_COMPRESSION is 1, the body is also
+ * stored compressed with each content coding, so that it is only compressed once.
+ */
+typedef struct JSONCachedResponse {
+	char *data;
+	int length;
+	char *encoded[JSON_WRITER_ENCODINGS];	// body for each content coding, or NULL to send data uncompressed
+	int encodedLength[JSON_WRITER_ENCODINGS];
+	char etag[JSON_WRITER_ENCODINGS][JSON_CACHE_ETAG_LENGTH];	// strong entity tags, derived from a hash of the data
+} JSONCachedResponse;
+
+/**
+ * Returns the cached response for a description of item, generating it if necessary. The table of items is built by
+ * init_json_cache() (see dataModelIndex.h), and responses are kept until the program exits. Only JSON_WRITER_DEFINITION and
+ * JSON_WRITER_DIRECTORY responses are cached, because they depend only on the SCL structure, rather than on any data
+ * values. Returns NULL for other content, for items outside the data model, or if memory cannot be allocated.
+ *
+ * May be called from any thread.
+ */
+JSONCachedResponse *getCachedResponse(Item *item, JSONWriterContent content);
+
+/**
+ * Returns TRUE if the value of an If-None-Match request header matches the entity tag of a cached response, with the
+ * given content coding.
+ */
+unsigned char cachedResponseMatches(JSONCachedResponse *response, JSONContentEncoding encoding, const char *ifNoneMatch);
+
+
+#ifdef __cplusplus /* If this is a C++ compiler, end C linkage */
+}
+#endif
+
+#endif /* JSON_CACHE_H */
+
+#endif
@@ -0,0 +1,635 @@
+/**
+ * Rapid-prototyping protection schemes with IEC 61850
+ *
+ * Copyright (c) 2014 Steven Blair
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include "ctypes.h"
+#if JSON_INTERFACE == 1
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <wchar.h>
+#include "json.h"
+#include "jsonCbor.h"
+#include "berInteger.h"
+#include "netOrder.h"
+
+#define JSON_CBOR_INDEFINITE			31		// additional information value for items of indefinite length
+
+/**
+ * Position within received CBOR data.
+ */
+typedef struct CBORReader {
+	const unsigned char *buf;
+	int len;
+	int pos;
+} CBORReader;
+
+/**
+ * A leaf value read from CBOR data, before conversion to the type of an item.
+ */
+typedef enum {
+	CBOR_VALUE_NONE = 0,
+	CBOR_VALUE_INTEGER,
+	CBOR_VALUE_FLOAT,
+	CBOR_VALUE_BOOLEAN,
+	CBOR_VALUE_STRING
+} CBORValueKind;
+
+int cborEncodeHead(unsigned char *buf, int majorType, unsigned long long argument) {
+	unsigned char initial = (unsigned char) (majorType << 5);
+
+	if (argument < 24) {
+		buf[0] = initial | (unsigned char) argument;
+		return 1;
+	}
+	else if (argument <= 0xFF) {
+		buf[0] = initial | 24;
+		buf[1] = (unsigned char) argument;
+		return 2;
+	}
+	else if (argument <= 0xFFFF) {
+		buf[0] = initial | 25;
+		net_store16(&buf[1], (unsigned short) argument);
+		return 3;
+	}
+	else if (argument <= 0xFFFFFFFFULL) {
+		buf[0] = initial | 26;
+		net_store32(&buf[1], (unsigned int) argument);
+		return 5;
+	}
+
+	buf[0] = initial | 27;
+	net_store64(&buf[1], argument);
+	return 9;
+}
+
+static int cbor_encode_signed(unsigned char *buf, long long value) {
+	if (value < 0) {
+		// the argument of a negative integer is -1 - value
+		return cborEncodeHead(buf, JSON_CBOR_MAJOR_NEGATIVE, ~((unsigned long long) value));
+	}
+
+	return cborEncodeHead(buf, JSON_CBOR_MAJOR_UNSIGNED, (unsigned long long) value);
+}
+
+/**
+ * Internal helper function. Returns the next Unicode code point of a wide string, combining UTF-16 surrogate pairs where
+ * wchar_t has 16 bits.
+ */
+static unsigned int cbor_next_code_point(const wchar_t **s) {
+	unsigned int c = (unsigned int) **s;
+
+	(*s)++;
+	if (sizeof(wchar_t) == 2 && c >= 0xD800 && c <= 0xDBFF && (unsigned int) **s >= 0xDC00 && (unsigned int) **s <= 0xDFFF) {
+		c = 0x10000 + ((c - 0xD800) << 10) + ((unsigned int) **s - 0xDC00);
+		(*s)++;
+	}
+
+	return c;
+}
+
+static int cbor_utf8_length(const wchar_t *s) {
+	int len = 0;
+
+	while (*s != 0) {
+		unsigned int c = cbor_next_code_point(&s);
+
+		len += (c < 0x80) ? 1 : (c < 0x800) ? 2 : (c < 0x10000) ? 3 : 4;
+	}
+
+	return len;
+}
+
+static int cbor_write_utf8(unsigned char *buf, const wchar_t *s) {
+	int len = 0;
+
+	while (*s != 0) {
+		unsigned int c = cbor_next_code_point(&s);
+
+		if (c < 0x80) {
+			buf[len++] = (unsigned char) c;
+		}
+		else if (c < 0x800) {
+			buf[len++] = (unsigned char) (0xC0 | (c >> 6));
+			buf[len++] = (unsigned char) (0x80 | (c & 0x3F));
+		}
+		else if (c < 0x10000) {
+			buf[len++] = (unsigned char) (0xE0 | (c >> 12));
+			buf[len++] = (unsigned char) (0x80 | ((c >> 6) & 0x3F));
+			buf[len++] = (unsigned char) (0x80 | (c & 0x3F));
+		}
+		else {
+			buf[len++] = (unsigned char) (0xF0 | (c >> 18));
+			buf[len++] = (unsigned char) (0x80 | ((c >> 12) & 0x3F));
+			buf[len++] = (unsigned char) (0x80 | ((c >> 6) & 0x3F));
+			buf[len++] = (unsigned char) (0x80 | (c & 0x3F));
+		}
+	}
+
+	return len;
+}
+
+int itemCBORLength(Item *item) {
+	switch (item->type) {
+		case BASIC_TYPE_CONSTRUCTED:
+			return 0;
+		// all string types must be null-terminated in data model
+		case BASIC_TYPE_OCTET_STRING:
+		case BASIC_TYPE_VISIBLE_STRING:
+		case BASIC_TYPE_CURRENCY:
+			return JSON_CBOR_MAX_HEAD + strlen((const char *) item->data);
+		case BASIC_TYPE_UNICODE_STRING:
+			return JSON_CBOR_MAX_HEAD + cbor_utf8_length((const wchar_t *) item->data);
+		default:
+			return JSON_CBOR_MAX_HEAD;
+	}
+}
+
+int itemToCBOR(unsigned char *buf, Item *item) {
+	void *data = item->data;
+	int head = 0;
+	int len = 0;
+
+	switch (item->type) {
+		case BASIC_TYPE_CONSTRUCTED:
+			// compound data types are not allowed
+			return 0;
+		case BASIC_TYPE_BOOLEAN:
+			buf[0] = (*(CTYPE_BOOLEAN *) data != FALSE) ? JSON_CBOR_TRUE : JSON_CBOR_FALSE;
+			return 1;
+		case BASIC_TYPE_INT8:
+			return cbor_encode_signed(buf, *((CTYPE_INT8 *) data));
+		case BASIC_TYPE_INT16:
+			return cbor_encode_signed(buf, *((CTYPE_INT16 *) data));
+		case BASIC_TYPE_INT32:
+			return cbor_encode_signed(buf, *((CTYPE_INT32 *) data));
+		case BASIC_TYPE_INT64:
+			return cbor_encode_signed(buf, *((CTYPE_INT64 *) data));
+		case BASIC_TYPE_INT8U:
+			return cborEncodeHead(buf, JSON_CBOR_MAJOR_UNSIGNED, *((CTYPE_INT8U *) data));
+		case BASIC_TYPE_INT16U:
+			return cborEncodeHead(buf, JSON_CBOR_MAJOR_UNSIGNED, *((CTYPE_INT16U *) data));
+		case BASIC_TYPE_INT24U:
+			return cborEncodeHead(buf, JSON_CBOR_MAJOR_UNSIGNED, *((CTYPE_INT24U *) data) & 0xFFFFFF);
+		case BASIC_TYPE_INT32U:
+			return cborEncodeHead(buf, JSON_CBOR_MAJOR_UNSIGNED, *((CTYPE_INT32U *) data));
+		case BASIC_TYPE_FLOAT32:
+			buf[0] = JSON_CBOR_FLOAT32;
+			net_store_float32(&buf[1], *((CTYPE_FLOAT32 *) data));
+			return 5;
+		case BASIC_TYPE_FLOAT64:
+			buf[0] = JSON_CBOR_FLOAT64;
+			net_store_float64(&buf[1], *((CTYPE_FLOAT64 *) data));
+			return 9;
+		case BASIC_TYPE_ENUMERATED:
+		case BASIC_TYPE_CODED_ENUM:
+			return cbor_encode_signed(buf, *((CTYPE_ENUM *) data));
+		case BASIC_TYPE_OCTET_STRING:
+			len = strlen((const char *) data);
+			head = cborEncodeHead(buf, JSON_CBOR_MAJOR_BYTES, len);
+			memcpy(&buf[head], data, len);
+			return head + len;
+		case BASIC_TYPE_VISIBLE_STRING:
+		case BASIC_TYPE_CURRENCY:
+			len = strlen((const char *) data);
+			head = cborEncodeHead(buf, JSON_CBOR_MAJOR_TEXT, len);
+			memcpy(&buf[head], data, len);
+			return head + len;
+		case BASIC_TYPE_UNICODE_STRING:
+			head = cborEncodeHead(buf, JSON_CBOR_MAJOR_TEXT, cbor_utf8_length((const wchar_t *) data));
+			return head + cbor_write_utf8(&buf[head], (const wchar_t *) data);
+		default:
+			return 0;
+	}
+}
+
+/**
+ * Internal helper function. Reads the initial byte and argument of a data item. For items of indefinite length, info is
+ * JSON_CBOR_INDEFINITE and the argument is zero. Returns FALSE if the data is truncated or not valid.
+ */
+static unsigned char cbor_read_head(CBORReader *reader, int *major, int *info, unsigned long long *argument) {
+	int size = 0;
+
+	if (reader->pos >= reader->len) {
+		return FALSE;
+	}
+
+	*major = reader->buf[reader->pos] >> 5;
+	*info = reader->buf[reader->pos] & 0x1F;
+	reader->pos++;
+
+	if (*info < 24) {
+		*argument = (unsigned long long) *info;
+		return TRUE;
+	}
+	else if (*info == JSON_CBOR_INDEFINITE) {
+		*argument = 0;
+		return (*major >= JSON_CBOR_MAJOR_BYTES && *major <= JSON_CBOR_MAJOR_MAP);
+	}
+	else if (*info > 27) {
+		return FALSE;
+	}
+
+	size = 1 << (*info - 24);
+	if (reader->len - reader->pos < size) {
+		return FALSE;
+	}
+	*argument = ber_load_integer(&reader->buf[reader->pos], size, 0);
+	reader->pos += size;
+
+	return TRUE;
+}
+
+/**
+ * Internal helper function. Skips one data item, including any items within it. Returns FALSE if the data is truncated
+ * or not valid.
+ */
+static unsigned char cbor_skip(CBORReader *reader, int depth) {
+	unsigned long long argument = 0;
+	unsigned long long i = 0;
+	int major = 0;
+	int info = 0;
+
+	if (depth > JSON_CBOR_MAX_DEPTH || !cbor_read_head(reader, &major, &info, &argument)) {
+		return FALSE;
+	}
+
+	switch (major) {
+		case JSON_CBOR_MAJOR_BYTES:
+		case JSON_CBOR_MAJOR_TEXT:
+			if (info == JSON_CBOR_INDEFINITE) {
+				// a sequence of definite-length chunks, ended by a break
+				while (reader->pos < reader->len && reader->buf[reader->pos] != JSON_CBOR_BREAK) {
+					if (!cbor_skip(reader, depth + 1)) {
+						return FALSE;
+					}
+				}
+				reader->pos++;
+				return (reader->pos <= reader->len);
+			}
+			if (argument > (unsigned long long) (reader->len - reader->pos)) {
+				return FALSE;
+			}
+			reader->pos += (int) argument;
+			return TRUE;
+		case JSON_CBOR_MAJOR_ARRAY:
+		case JSON_CBOR_MAJOR_MAP:
+			if (info == JSON_CBOR_INDEFINITE) {
+				while (reader->pos < reader->len && reader->buf[reader->pos] != JSON_CBOR_BREAK) {
+					if (!cbor_skip(reader, depth + 1)) {
+						return FALSE;
+					}
+				}
+				reader->pos++;
+				return (reader->pos <= reader->len);
+			}
+			if (major == JSON_CBOR_MAJOR_MAP) {
+				argument *= 2;
+			}
+			for (i = 0; i < argument; i++) {
+				if (!cbor_skip(reader, depth + 1)) {
+					return FALSE;
+				}
+			}
+			return TRUE;
+		case JSON_CBOR_MAJOR_TAG:
+			return cbor_skip(reader, depth + 1);
+		default:
+			return TRUE;
+	}
+}
+
+static double cbor_float16_to_double(unsigned int half) {
+	int exponent = (half >> 10) & 0x1F;
+	int mantissa = half & 0x3FF;
+	double value = 0.0;
+
+	if (exponent == 0) {
+		value = ldexp(mantissa, -24);
+	}
+	else if (exponent != 31) {
+		value = ldexp(mantissa + 1024, exponent - 25);
+	}
+	else {
+		value = (mantissa == 0) ? HUGE_VAL : NAN;
+	}
+
+	return (half & 0x8000) ? -value : value;
+}
+
+/**
+ * Internal helper function. Decodes UTF-8 text to a wide string, if out is not NULL, and returns the number of wchar_t
+ * units, or -1 if the text is not valid.
+ */
+static int cbor_read_utf8(wchar_t *out, const unsigned char *s, int len) {
+	int count = 0;
+	int i = 0;
+
+	while (i < len) {
+		unsigned int c = s[i];
+		int extra = (c < 0x80) ? 0 : (c >= 0xF0) ? 3 : (c >= 0xE0) ? 2 : (c >= 0xC0) ? 1 : -1;
+		int j = 0;
+
+		if (extra < 0 || i + extra >= len) {
+			return -1;
+		}
+		if (extra > 0) {
+			c &= 0x3F >> extra;
+		}
+		for (j = 1; j <= extra; j++) {
+			if ((s[i + j] & 0xC0) != 0x80) {
+				return -1;
+			}
+			c = (c << 6) | (s[i + j] & 0x3F);
+		}
+		i += extra + 1;
+
+		if (sizeof(wchar_t) == 2 && c >= 0x10000) {
+			if (out != NULL) {
+				out[count] = (wchar_t) (0xD800 + ((c - 0x10000) >> 10));
+				out[count + 1] = (wchar_t) (0xDC00 + ((c - 0x10000) & 0x3FF));
+			}
+			count += 2;
+		}
+		else {
+			if (out != NULL) {
+				out[count] = (wchar_t) c;
+			}
+			count++;
+		}
+	}
+
+	return count;
+}
+
+/**
+ * Internal helper function. Sets a leaf item from one data item. Returns 1 if the item was set, 0 if the data item is
+ * valid but not compatible with the type of the item, or -1 if the data is not valid.
+ */
+static int cbor_set_leaf(Item *item, CBORReader *reader, int depth) {
+	void *data = item->data;
+	CBORValueKind kind = CBOR_VALUE_NONE;
+	unsigned long long argument = 0;
+	long long integer = 0;
+	double number = 0.0;
+	const unsigned char *string = NULL;
+	int start = reader->pos;
+	int major = 0;
+	int info = 0;
+	int len = 0;
+
+	if (!cbor_read_head(reader, &major, &info, &argument)) {
+		return -1;
+	}
+
+	if (major == JSON_CBOR_MAJOR_UNSIGNED) {
+		kind = CBOR_VALUE_INTEGER;
+		integer = (long long) argument;
+		number = (double) argument;
+	}
+	else if (major == JSON_CBOR_MAJOR_NEGATIVE) {
+		kind = CBOR_VALUE_INTEGER;
+		integer = -1 - (long long) argument;
+		number = (double) integer;
+	}
+	else if (major == JSON_CBOR_MAJOR_SIMPLE && (info == (JSON_CBOR_FALSE & 0x1F) || info == (JSON_CBOR_TRUE & 0x1F))) {
+		kind = CBOR_VALUE_BOOLEAN;
+		integer = (info == (JSON_CBOR_TRUE & 0x1F));
+	}
+	else if (major == JSON_CBOR_MAJOR_SIMPLE && info >= (JSON_CBOR_FLOAT16 & 0x1F) && info <= (JSON_CBOR_FLOAT64 & 0x1F)) {
+		kind = CBOR_VALUE_FLOAT;
+		if (info == (JSON_CBOR_FLOAT16 & 0x1F)) {
+			number = cbor_float16_to_double((unsigned int) argument);
+		}
+		else if (info == (JSON_CBOR_FLOAT32 & 0x1F)) {
+			unsigned int bits = (unsigned int) argument;
+			float value = 0.0f;
+
+			memcpy(&value, &bits, sizeof(value));
+			number = value;
+		}
+		else {
+			memcpy(&number, &argument, sizeof(number));
+		}
+	}
+	else if ((major == JSON_CBOR_MAJOR_TEXT || major == JSON_CBOR_MAJOR_BYTES) && info != JSON_CBOR_INDEFINITE) {
+		if (argument > (unsigned long long) (reader->len - reader->pos)) {
+			return -1;
+		}
+		kind = CBOR_VALUE_STRING;
+		string = &reader->buf[reader->pos];
+		len = (int) argument;
+		reader->pos += len;
+	}
+	else {
+		reader->pos = start;
+		return cbor_skip(reader, depth) ? 0 : -1;
+	}
+
+	if (data == NULL) {
+		return 0;
+	}
+
+	switch (item->type) {
+		case BASIC_TYPE_BOOLEAN:
+			if (kind != CBOR_VALUE_BOOLEAN && kind != CBOR_VALUE_INTEGER) {
+				return 0;
+			}
+			*(CTYPE_BOOLEAN *) data = (integer != 0) ? 1 : 0;
+			break;
+		case BASIC_TYPE_INT8:
+		case BASIC_TYPE_INT16:
+		case BASIC_TYPE_INT32:
+		case BASIC_TYPE_INT64:
+		case BASIC_TYPE_INT8U:
+		case BASIC_TYPE_INT16U:
+		case BASIC_TYPE_INT24U:
+		case BASIC_TYPE_INT32U:
+		case BASIC_TYPE_ENUMERATED:
+		case BASIC_TYPE_CODED_ENUM:
+			if (kind != CBOR_VALUE_INTEGER) {
+				return 0;
+			}
+			switch (item->type) {
+				case BASIC_TYPE_INT8:
+					*(CTYPE_INT8 *) data = (CTYPE_INT8) integer;
+					break;
+				case BASIC_TYPE_INT16:
+					*(CTYPE_INT16 *) data = (CTYPE_INT16) integer;
+					break;
+				case BASIC_TYPE_INT32:
+					*(CTYPE_INT32 *) data = (CTYPE_INT32) integer;
+					break;
+				case BASIC_TYPE_INT64:
+					*(CTYPE_INT64 *) data = (CTYPE_INT64) integer;
+					break;
+				case BASIC_TYPE_INT8U:
+					*(CTYPE_INT8U *) data = (CTYPE_INT8U) integer;
+					break;
+				case BASIC_TYPE_INT16U:
+					*(CTYPE_INT16U *) data = (CTYPE_INT16U) integer;
+					break;
+				case BASIC_TYPE_INT24U:
+					*(CTYPE_INT24U *) data = (CTYPE_INT24U) integer & 0xFFFFFF;
+					break;
+				case BASIC_TYPE_INT32U:
+					*(CTYPE_INT32U *) data = (CTYPE_INT32U) integer;
+					break;
+				default:
+					*(CTYPE_ENUM *) data = (CTYPE_ENUM) integer;
+					break;
+			}
+			break;
+		case BASIC_TYPE_FLOAT32:
+			if (kind != CBOR_VALUE_FLOAT && kind != CBOR_VALUE_INTEGER) {
+				return 0;
+			}
+			*(CTYPE_FLOAT32 *) data = (CTYPE_FLOAT32) number;
+			break;
+		case BASIC_TYPE_FLOAT64:
+			if (kind != CBOR_VALUE_FLOAT && kind != CBOR_VALUE_INTEGER) {
+				return 0;
+			}
+			*(CTYPE_FLOAT64 *) data = (CTYPE_FLOAT64) number;
+			break;
+		// strings are null-terminated, and their storage is only known to be large enough for the current value
+		case BASIC_TYPE_OCTET_STRING:
+		case BASIC_TYPE_VISIBLE_STRING:
+		case BASIC_TYPE_CURRENCY:
+			if (kind != CBOR_VALUE_STRING || len > (int) strlen((const char *) data) || memchr(string, '\0', len) != NULL) {
+				return 0;
+			}
+			if (item->type == BASIC_TYPE_CURRENCY && len != 3) {
+				return 0;
+			}
+			memcpy(data, string, len);
+			((char *) data)[len] = '\0';
+			break;
+		case BASIC_TYPE_UNICODE_STRING:
+			if (kind != CBOR_VALUE_STRING) {
+				return 0;
+			}
+			len = cbor_read_utf8(NULL, string, len);
+			if (len < 0 || len > (int) wcslen((const wchar_t *) data)) {
+				return 0;
+			}
+			cbor_read_utf8((wchar_t *) data, string, (int) argument);
+			((wchar_t *) data)[len] = 0;
+			break;
+		default:
+			return 0;
+	}
+
+	itemChanged(item);
+	return 1;
+}
+
+/**
+ * Internal helper function. Sets item, and any sub-items, from one data item. Returns the number of leaf items set, or
+ * -1 if the data is not valid.
+ */
+static int cbor_set_item(Item *item, CBORReader *reader, int depth) {
+	unsigned long long argument = 0;
+	unsigned long long entry = 0;
+	int start = reader->pos;
+	int count = 0;
+	int major = 0;
+	int info = 0;
+
+	if (depth > JSON_CBOR_MAX_DEPTH) {
+		return -1;
+	}
+
+	if (item->type != BASIC_TYPE_CONSTRUCTED) {
+		return cbor_set_leaf(item, reader, depth);
+	}
+
+	if (!cbor_read_head(reader, &major, &info, &argument)) {
+		return -1;
+	}
+	if (major != JSON_CBOR_MAJOR_MAP) {
+		reader->pos = start;
+		return cbor_skip(reader, depth) ? 0 : -1;
+	}
+
+	for (entry = 0; info == JSON_CBOR_INDEFINITE || entry < argument; entry++) {
+		unsigned long long keyLen = 0;
+		const char *key = NULL;
+		Item *subItem = NULL;
+		int keyMajor = 0;
+		int keyInfo = 0;
+		int i = 0;
+
+		if (info == JSON_CBOR_INDEFINITE && reader->pos < reader->len && reader->buf[reader->pos] == JSON_CBOR_BREAK) {
+			reader->pos++;
+			break;
+		}
+
+		// keys are the names of sub-items
+		if (!cbor_read_head(reader, &keyMajor, &keyInfo, &keyLen) || keyMajor != JSON_CBOR_MAJOR_TEXT || keyInfo == JSON_CBOR_INDEFINITE) {
+			return -1;
+		}
+		if (keyLen > (unsigned long long) (reader->len - reader->pos)) {
+			return -1;
+		}
+		key = (const char *) &reader->buf[reader->pos];
+		reader->pos += (int) keyLen;
+
+		for (i = 0; item->items != NULL && i < item->numberOfItems; i++) {
+			if (strlen(item->items[i].objectRef) == keyLen && strncmp(item->items[i].objectRef, key, (size_t) keyLen) == 0) {
+				subItem = &item->items[i];
+				break;
+			}
+		}
+
+		if (subItem != NULL) {
+			int set = cbor_set_item(subItem, reader, depth + 1);
+
+			if (set < 0) {
+				return -1;
+			}
+			count += set;
+		}
+		else if (!cbor_skip(reader, depth + 1)) {
+			return -1;
+		}
+	}
+
+	return count;
+}
+
+int setItemFromCBOR(Item *item, const unsigned char *buf, int len) {
+	CBORReader reader;
+	int count = 0;
+
+	if (item == NULL || buf == NULL || len <= 0) {
+		return 0;
+	}
+
+	reader.buf = buf;
+	reader.len = len;
+	reader.pos = 0;
+
+	count = cbor_set_item(item, &reader, 0);
+
+	return (count > 0) ? count : 0;
+}
+
+#endif
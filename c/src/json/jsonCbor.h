@@ -0,0 +1,91 @@
+/**
+ * Rapid-prototyping protection schemes with IEC 61850
+ *
+ * Copyright (c) 2014 Steven Blair
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include "ctypes.h"
+#if JSON_INTERFACE == 1
+
+#ifndef JSON_CBOR_H
+#define JSON_CBOR_H
+
+#ifdef __cplusplus /* If this is a C++ compiler, use C linkage */
+extern "C" {
+#endif
+
+
+#include "dataModelIndex.h"
+
+#define JSON_CBOR_MAX_HEAD				9		// longest initial byte and argument of a CBOR data item
+#define JSON_CBOR_MAX_DEPTH				32		// limit of nested arrays and maps in received data
+
+#define JSON_CBOR_MAJOR_UNSIGNED		0
+#define JSON_CBOR_MAJOR_NEGATIVE		1
+#define JSON_CBOR_MAJOR_BYTES			2
+#define JSON_CBOR_MAJOR_TEXT			3
+#define JSON_CBOR_MAJOR_ARRAY			4
+#define JSON_CBOR_MAJOR_MAP				5
+#define JSON_CBOR_MAJOR_TAG				6
+#define JSON_CBOR_MAJOR_SIMPLE			7
+
+#define JSON_CBOR_FALSE					0xF4
+#define JSON_CBOR_TRUE					0xF5
+#define JSON_CBOR_NULL					0xF6
+#define JSON_CBOR_FLOAT16				0xF9
+#define JSON_CBOR_FLOAT32				0xFA
+#define JSON_CBOR_FLOAT64				0xFB
+#define JSON_CBOR_MAP_START				0xBF	// map of indefinite length
+#define JSON_CBOR_BREAK					0xFF	// end of an item of indefinite length
+
+// Binary encoding of the data model in CBOR (RFC 8949), as an alternative to JSON text. Values keep the widths of their
+// BasicType: FLOAT32 values are sent as single-precision floats, integers in the fewest bytes, and all multi-byte
+// fields are big-endian. Constructed items are maps of indefinite length, so that they can be streamed.
+
+/**
+ * Writes the initial byte and argument of a data item, and returns the number of bytes written.
+ */
+int cborEncodeHead(unsigned char *buf, int majorType, unsigned long long argument);
+
+/**
+ * Returns the number of bytes needed by itemToCBOR() for the value of a leaf item.
+ */
+int itemCBORLength(Item *item);
+
+/**
+ * Writes the value of a leaf item as a CBOR data item. The buffer must be large enough (see itemCBORLength()). Returns
+ * the number of bytes written, or 0 for constructed items.
+ */
+int itemToCBOR(unsigned char *buf, Item *item);
+
+/**
+ * Sets the values of item from a CBOR data item, of len bytes. Leaf items accept a value of a compatible type. Constructed
+ * items accept a map of sub-item names to values, as produced for GET requests, and map entries which do not match
+ * a sub-item are ignored. Strings are only set if they are no longer than the current value.
+ *
+ * Returns the number of leaf items which were set, or 0 if none were set or the data is not valid.
+ */
+int setItemFromCBOR(Item *item, const unsigned char *buf, int len);
+
+
+#ifdef __cplusplus /* If this is a C++ compiler, end C linkage */
+}
+#endif
+
+#endif /* JSON_CBOR_H */
+
+#endif
@@ -0,0 +1,533 @@
+/**
+ * Rapid-prototyping protection schemes with IEC 61850
+ *
+ * Copyright (c) 2014 Steven Blair
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include "ctypes.h"
+#if JSON_INTERFACE == 1
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#ifdef _WIN32
+#include <ws2tcpip.h>
+#else
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <netinet/tcp.h>
+#include <netdb.h>
+#include <unistd.h>
+#endif
+#include "jsonClient.h"
+
+#ifdef _WIN32
+#define JSON_CLIENT_CLOSE(sock)			closesocket(sock)
+#else
+#define JSON_CLIENT_CLOSE(sock)			close(sock)
+#endif
+
+#ifdef MSG_NOSIGNAL
+#define JSON_CLIENT_SEND_FLAGS			MSG_NOSIGNAL	// a closed connection is reported by send(), rather than by SIGPIPE
+#else
+#define JSON_CLIENT_SEND_FLAGS			0
+#endif
+
+#define JSON_CLIENT_DEFAULT_TYPE		"text/plain"
+
+JSONClient *createJSONClient() {
+	return (JSONClient *) calloc(1, sizeof(JSONClient));
+}
+
+static void client_close(JSONClientConnection *connection) {
+	if (connection->sock >= 0) {
+		JSON_CLIENT_CLOSE(connection->sock);
+		connection->sock = -1;
+	}
+}
+
+void freeJSONClient(JSONClient *client) {
+	JSONClientConnection *connection = NULL;
+
+	if (client == NULL) {
+		return;
+	}
+
+	while (client->connections != NULL) {
+		connection = client->connections;
+		client->connections = connection->next;
+		client_close(connection);
+		free(connection->host);
+		free(connection);
+	}
+
+	free(client->request);
+	free(client->reply);
+	free(client);
+}
+
+/**
+ * Makes sure that a buffer has space for at least "needed" more bytes, as well as a null terminator.
+ */
+static int client_reserve(char **buf, int *size, int length, int needed) {
+	int newSize = (*size > 0) ? *size : JSON_CLIENT_BUFFER_SIZE;
+	char *grown = NULL;
+
+	if (length + needed + 1 <= *size) {
+		return TRUE;
+	}
+	while (newSize < length + needed + 1) {
+		newSize *= 2;
+	}
+
+	grown = (char *) realloc(*buf, newSize);
+	if (grown == NULL) {
+		return FALSE;
+	}
+	*buf = grown;
+	*size = newSize;
+
+	return TRUE;
+}
+
+/**
+ * Returns the connection to host:port, adding a closed connection to the pool if there is none. The address is resolved
+ * when the connection is added.
+ */
+static JSONClientConnection *client_connection(JSONClient *client, const char *host, int port) {
+	JSONClientConnection *connection = client->connections;
+	struct addrinfo hints;
+	struct addrinfo *result = NULL;
+
+	while (connection != NULL) {
+		if (connection->port == port && strcmp(connection->host, host) == 0) {
+			return connection;
+		}
+		connection = connection->next;
+	}
+
+	memset(&hints, 0, sizeof(hints));
+	hints.ai_family = AF_INET;
+	hints.ai_socktype = SOCK_STREAM;
+	if (getaddrinfo(host, NULL, &hints, &result) != 0 || result == NULL) {
+		return NULL;
+	}
+
+	connection = (JSONClientConnection *) calloc(1, sizeof(JSONClientConnection));
+	if (connection != NULL && (connection->host = (char *) malloc(strlen(host) + 1)) != NULL) {
+		strcpy(connection->host, host);
+		connection->port = port;
+		memcpy(&connection->address, result->ai_addr, sizeof(connection->address));
+		connection->address.sin_port = htons((unsigned short) port);
+		connection->sock = -1;
+		connection->next = client->connections;
+		client->connections = connection;
+	}
+	else {
+		free(connection);
+		connection = NULL;
+	}
+
+	freeaddrinfo(result);
+	return connection;
+}
+
+static int client_connect(JSONClientConnection *connection) {
+	int noDelay = 1;
+#ifdef _WIN32
+	DWORD timeout = JSON_CLIENT_TIMEOUT;
+#else
+	struct timeval timeout;
+
+	timeout.tv_sec = JSON_CLIENT_TIMEOUT / 1000;
+	timeout.tv_usec = (JSON_CLIENT_TIMEOUT % 1000) * 1000;
+#endif
+
+	connection->sock = (int) socket(PF_INET, SOCK_STREAM, 0);
+	if (connection->sock < 0) {
+		return FALSE;
+	}
+
+	// requests are small and sent whole, so waiting to coalesce them only adds latency
+	setsockopt(connection->sock, IPPROTO_TCP, TCP_NODELAY, (const char *) &noDelay, sizeof(noDelay));
+	setsockopt(connection->sock, SOL_SOCKET, SO_RCVTIMEO, (const char *) &timeout, sizeof(timeout));
+	setsockopt(connection->sock, SOL_SOCKET, SO_SNDTIMEO, (const char *) &timeout, sizeof(timeout));
+
+	if (connect(connection->sock, (struct sockaddr *) &connection->address, sizeof(connection->address)) != 0) {
+		client_close(connection);
+		return FALSE;
+	}
+
+	return TRUE;
+}
+
+/**
+ * Appends a request to the request buffer.
+ */
+static int client_append_request(JSONClient *client, const char *host, int port, JSONClientRequest *request) {
+	const char *contentType = (request->contentType != NULL) ? request->contentType : JSON_CLIENT_DEFAULT_TYPE;
+	int bodyLength = (request->body != NULL) ? request->bodyLength : 0;
+	int headerSize = strlen(request->method) + strlen(request->url) + strlen(host) + strlen(contentType) + 128;
+	int len = 0;
+
+	if (!client_reserve(&client->request, &client->requestSize, client->requestLength, headerSize + bodyLength)) {
+		return FALSE;
+	}
+
+	if (request->body != NULL) {
+		len = sprintf(&client->request[client->requestLength], "%s %s HTTP/1.1\r\nHost: %s:%d\r\nContent-Type: %s\r\nContent-Length: %d\r\n\r\n", request->method, request->url, host, port, contentType, bodyLength);
+	}
+	else {
+		len = sprintf(&client->request[client->requestLength], "%s %s HTTP/1.1\r\nHost: %s:%d\r\n\r\n", request->method, request->url, host, port);
+	}
+	client->requestLength += len;
+
+	if (bodyLength > 0) {
+		memcpy(&client->request[client->requestLength], request->body, bodyLength);
+		client->requestLength += bodyLength;
+	}
+
+	return TRUE;
+}
+
+/**
+ * Returns TRUE if the header line starting at buf, and ending before end, has the given name (in lower case).
+ */
+static int client_header_is(const char *buf, const char *end, const char *name) {
+	int i = 0;
+
+	for (i = 0; name[i] != '\0'; i++) {
+		if (buf + i >= end || tolower((unsigned char) buf[i]) != name[i]) {
+			return FALSE;
+		}
+	}
+	return TRUE;
+}
+
+/**
+ * Returns TRUE if the header value starting at buf, and ending before end, contains the given word (in lower case).
+ */
+static int client_header_has(const char *buf, const char *end, const char *word) {
+	int wordLength = strlen(word);
+	int i = 0;
+
+	for (; buf + wordLength <= end; buf++) {
+		for (i = 0; i < wordLength && tolower((unsigned char) buf[i]) == word[i]; i++) {
+		}
+		if (i == wordLength) {
+			return TRUE;
+		}
+	}
+	return FALSE;
+}
+
+/**
+ * Scans the chunks of a body with chunked transfer encoding. Returns the length of the encoded body if it has been
+ * received completely, 0 if more data is needed, or -1 if it is not valid.
+ */
+static int client_chunked_length(const char *buf, int len) {
+	int pos = 0;
+
+	while (1) {
+		long size = 0;
+		int digits = 0;
+
+		while (pos < len && isxdigit((unsigned char) buf[pos])) {
+			size = size * 16 + (isdigit((unsigned char) buf[pos]) ? buf[pos] - '0' : tolower((unsigned char) buf[pos]) - 'a' + 10);
+			pos++;
+			if (++digits > 7) {
+				return -1;
+			}
+		}
+		// skip any chunk extensions
+		while (pos < len && buf[pos] != '\n') {
+			pos++;
+		}
+		if (pos >= len) {
+			return 0;
+		}
+		if (digits == 0) {
+			return -1;
+		}
+		pos++;
+
+		if (size == 0) {
+			// skip any trailer fields, until an empty line
+			while (1) {
+				int lineStart = pos;
+
+				while (pos < len && buf[pos] != '\n') {
+					pos++;
+				}
+				if (pos >= len) {
+					return 0;
+				}
+				pos++;
+				if (pos - lineStart <= 2) {
+					return pos;
+				}
+			}
+		}
+
+		pos += size + 2;	// the data, and its CRLF
+		if (pos > len) {
+			return 0;
+		}
+	}
+}
+
+/**
+ * Removes the chunked transfer encoding of a complete body, in place. Returns the length of the decoded body.
+ */
+static int client_dechunk(char *buf, int len) {
+	int pos = 0;
+	int written = 0;
+
+	while (pos < len) {
+		long size = strtol(&buf[pos], NULL, 16);
+
+		while (pos < len && buf[pos] != '\n') {
+			pos++;
+		}
+		pos++;
+		if (size <= 0) {
+			break;
+		}
+		memmove(&buf[written], &buf[pos], size);
+		written += size;
+		pos += size + 2;
+	}
+
+	return written;
+}
+
+/**
+ * Parses the response which starts at buf. Returns its length if it has been received completely, 0 if more data is
+ * needed, or -1 if it is not valid. If closed is TRUE, the connection has been closed, which ends a body of unknown
+ * length. The body is decoded in place, and its position and decoded length are returned.
+ */
+static int client_parse_response(char *buf, int len, int closed, int *status, int *bodyStart, int *bodyLength, int *keepAlive) {
+	const char *line = NULL;
+	const char *headersEnd = NULL;
+	int contentLength = -1;
+	int chunked = FALSE;
+	int total = 0;
+	int i = 0;
+
+	for (i = 3; i < len && i < JSON_CLIENT_MAX_HEADERS; i++) {
+		if (buf[i] == '\n' && buf[i - 1] == '\r' && buf[i - 2] == '\n' && buf[i - 3] == '\r') {
+			headersEnd = &buf[i + 1];
+			break;
+		}
+	}
+	if (headersEnd == NULL) {
+		return (len >= JSON_CLIENT_MAX_HEADERS) ? -1 : 0;
+	}
+	if (strncmp(buf, "HTTP/1.", 7) != 0 || len < 12 || !isdigit((unsigned char) buf[9])) {
+		return -1;
+	}
+
+	*status = atoi(&buf[9]);
+	*keepAlive = (buf[7] == '1');		// the default is to keep HTTP/1.1 connections open, but not HTTP/1.0 connections
+	*bodyStart = (int) (headersEnd - buf);
+
+	line = strchr(buf, '\n') + 1;
+	while (line < headersEnd - 2) {
+		const char *end = line;
+
+		while (*end != '\r' && *end != '\n') {
+			end++;
+		}
+		if (client_header_is(line, end, "content-length:")) {
+			contentLength = atoi(line + 15);
+		}
+		else if (client_header_is(line, end, "transfer-encoding:")) {
+			chunked = client_header_has(line + 18, end, "chunked");
+		}
+		else if (client_header_is(line, end, "connection:")) {
+			if (client_header_has(line + 11, end, "close")) {
+				*keepAlive = FALSE;
+			}
+			else if (client_header_has(line + 11, end, "keep-alive")) {
+				*keepAlive = TRUE;
+			}
+		}
+		line = end + 2;
+	}
+
+	if ((*status >= 100 && *status < 200) || *status == 204 || *status == 304) {
+		*bodyLength = 0;
+		return *bodyStart;
+	}
+	else if (chunked) {
+		total = client_chunked_length(headersEnd, len - *bodyStart);
+		if (total <= 0) {
+			return total;
+		}
+		*bodyLength = client_dechunk(&buf[*bodyStart], total);
+		return *bodyStart + total;
+	}
+	else if (contentLength >= 0) {
+		if (len - *bodyStart < contentLength) {
+			return 0;
+		}
+		*bodyLength = contentLength;
+		return *bodyStart + contentLength;
+	}
+	else if (closed) {
+		*bodyLength = len - *bodyStart;
+		*keepAlive = FALSE;
+		return len;
+	}
+
+	return 0;
+}
+
+/**
+ * Sends the request buffer on an open connection, and reads the responses to the given requests. Returns the number of
+ * complete responses. The connection is closed if it fails, or if the server closes it.
+ */
+static int client_exchange(JSONClient *client, JSONClientConnection *connection, JSONClientRequest *requests, int numberOfRequests) {
+	int sent = 0;
+	int pos = client->replyLength;
+	int done = 0;
+	int closed = FALSE;
+	int n = 0;
+
+	while (sent < client->requestLength) {
+		n = send(connection->sock, &client->request[sent], client->requestLength - sent, JSON_CLIENT_SEND_FLAGS);
+		if (n <= 0) {
+			client_close(connection);
+			return 0;
+		}
+		sent += n;
+	}
+
+	while (done < numberOfRequests) {
+		int status = 0;
+		int bodyStart = 0;
+		int bodyLength = 0;
+		int keepAlive = FALSE;
+		int len = client_parse_response(&client->reply[pos], client->replyLength - pos, closed, &status, &bodyStart, &bodyLength, &keepAlive);
+
+		if (len > 0) {
+			requests[done].status = status;
+			requests[done].responseOffset = pos + bodyStart;
+			requests[done].responseLength = bodyLength;
+			pos += len;
+			done++;
+			if (!keepAlive) {
+				client_close(connection);
+				break;
+			}
+			continue;
+		}
+		if (len < 0 || closed) {
+			client_close(connection);
+			break;
+		}
+
+		if (!client_reserve(&client->reply, &client->replySize, client->replyLength, JSON_CLIENT_BUFFER_SIZE / 2)) {
+			client_close(connection);
+			break;
+		}
+		n = recv(connection->sock, &client->reply[client->replyLength], client->replySize - client->replyLength - 1, 0);
+		if (n > 0) {
+			client->replyLength += n;
+		}
+		else if (n == 0) {
+			closed = TRUE;
+		}
+		else {
+			client_close(connection);
+			break;
+		}
+	}
+
+	// anything after the last complete response is discarded
+	client->replyLength = pos;
+
+	return done;
+}
+
+int jsonClientBatch(JSONClient *client, const char *host, int port, JSONClientRequest *requests, int numberOfRequests) {
+	JSONClientConnection *connection = client_connection(client, host, port);
+	int first = 0;
+	int i = 0;
+
+	client->replyLength = 0;
+	for (i = 0; i < numberOfRequests; i++) {
+		requests[i].status = -1;
+		requests[i].response = NULL;
+		requests[i].responseOffset = 0;
+		requests[i].responseLength = 0;
+	}
+
+	while (connection != NULL && first < numberOfRequests) {
+		int count = (numberOfRequests - first < JSON_CLIENT_MAX_PIPELINE) ? numberOfRequests - first : JSON_CLIENT_MAX_PIPELINE;
+		int done = 0;
+		int attempt = 0;
+
+		client->requestLength = 0;
+		for (i = first; i < first + count; i++) {
+			if (!client_append_request(client, host, port, &requests[i])) {
+				count = i - first;
+				break;
+			}
+		}
+		if (count == 0) {
+			break;
+		}
+
+		for (attempt = 0; attempt < 2 && done == 0; attempt++) {
+			int reused = (connection->sock >= 0);
+
+			if (!reused && !client_connect(connection)) {
+				break;
+			}
+			done = client_exchange(client, connection, &requests[first], count);
+
+			// an open connection may have been closed by the server since it was last used, so it is tried again once,
+			// on a new connection; a new connection which fails is not
+			if (!reused) {
+				break;
+			}
+		}
+
+		if (done == 0) {
+			break;
+		}
+		first += done;
+	}
+
+	// the responses can only be given as pointers once the reply buffer has stopped growing
+	for (i = 0; i < first; i++) {
+		requests[i].response = &client->reply[requests[i].responseOffset];
+		requests[i].response[requests[i].responseLength] = '\0';
+	}
+
+	return first;
+}
+
+int jsonClientRequest(JSONClient *client, const char *host, int port, JSONClientRequest *request) {
+	jsonClientBatch(client, host, port, request, 1);
+	return request->status;
+}
+
+#endif
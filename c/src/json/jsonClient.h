@@ -0,0 +1,117 @@
+/**
+ * Rapid-prototyping protection schemes with IEC 61850
+ *
+ * Copyright (c) 2014 Steven Blair
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include "ctypes.h"
+#if JSON_INTERFACE == 1
+
+#ifndef JSON_CLIENT_H
+#define JSON_CLIENT_H
+
+#ifdef __cplusplus /* If this is a C++ compiler, use C linkage */
+extern "C" {
+#endif
+
+
+#ifdef _WIN32
+#include <winsock2.h>
+#else
+#include <netinet/in.h>
+#endif
+
+#define JSON_CLIENT_BUFFER_SIZE			16384	// initial size of the request and reply buffers, which grow as needed
+#define JSON_CLIENT_MAX_PIPELINE		64		// requests of a batch which are sent before their responses are read
+#define JSON_CLIENT_TIMEOUT				5000	// ms; a request fails if the server does not respond within this time
+#define JSON_CLIENT_MAX_HEADERS			8192	// bytes; limit of the status line and headers of each response
+
+/**
+ * An open (or closed, if sock is -1) HTTP/1.1 connection to a server. The address is resolved once, when the connection
+ * is first used, rather than for every request.
+ */
+typedef struct JSONClientConnection {
+	char *host;
+	int port;
+	struct sockaddr_in address;
+	int sock;
+	struct JSONClientConnection *next;
+} JSONClientConnection;
+
+/**
+ * An HTTP request, and its response. The response body is decoded (i.e., chunked transfer encoding is removed) and
+ * null-terminated. It points into the reply buffer of the client, so it is only valid until the next request.
+ */
+typedef struct JSONClientRequest {
+	const char *method;				// "GET" or "POST"
+	const char *url;				// e.g., "/C1/LN0.Mod.stVal"
+	const char *contentType;		// NULL for text/plain
+	const char *body;				// NULL if there is no body
+	int bodyLength;
+	int status;						// HTTP status code of the response, or -1 if there was no response
+	char *response;
+	int responseOffset;				// position of the response in the reply buffer of the client
+	int responseLength;
+} JSONClientRequest;
+
+/**
+ * A reusable HTTP client. Connections are kept open after each request (HTTP/1.1 keep-alive), and reused for later
+ * requests to the same server. Each client has a single reply buffer, which grows to fit the largest response, so no
+ * memory is allocated for each request. A client must only be used by one thread at a time.
+ */
+typedef struct JSONClient {
+	JSONClientConnection *connections;
+	char *request;					// requests of the current batch, as sent
+	int requestLength;
+	int requestSize;
+	char *reply;					// responses of the current batch, as received, and then decoded in place
+	int replyLength;
+	int replySize;
+} JSONClient;
+
+/**
+ * Returns a new client, with no open connections, or NULL if memory cannot be allocated.
+ */
+JSONClient *createJSONClient();
+
+/**
+ * Closes all of the connections of a client, and frees it.
+ */
+void freeJSONClient(JSONClient *client);
+
+/**
+ * Sends a request to host:port, using an open connection if there is one, and waits for the response. Returns the
+ * HTTP status code, or -1 if no response was received.
+ */
+int jsonClientRequest(JSONClient *client, const char *host, int port, JSONClientRequest *request);
+
+/**
+ * Sends a batch of requests to host:port, with HTTP pipelining: up to JSON_CLIENT_MAX_PIPELINE requests are sent
+ * together, before any of their responses are read, so that the batch only waits for one round trip per
+ * JSON_CLIENT_MAX_PIPELINE requests. Returns the number of responses received; requests without a response have a
+ * status of -1.
+ */
+int jsonClientBatch(JSONClient *client, const char *host, int port, JSONClientRequest *requests, int numberOfRequests);
+
+
+#ifdef __cplusplus /* If this is a C++ compiler, end C linkage */
+}
+#endif
+
+#endif /* JSON_CLIENT_H */
+
+#endif
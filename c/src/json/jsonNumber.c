@@ -0,0 +1,459 @@
+/**
+ * Rapid-prototyping protection schemes with IEC 61850
+ *
+ * Copyright (c) 2014 Steven Blair
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include "ctypes.h"
+#if JSON_INTERFACE == 1
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "jsonNumber.h"
+
+#define JSON_NUMBER_FIXED_MAX_DIGITS	21		// numbers with more integer digits than this are printed in exponent form
+#define JSON_NUMBER_FIXED_MIN_EXPONENT	-6		// as are numbers smaller than 1e-6
+
+#define FLOAT_MANTISSA_BITS				23
+#define FLOAT_EXPONENT_BITS				8
+#define FLOAT_BIAS						127
+#define FLOAT_POW5_INV_BITCOUNT			59
+#define FLOAT_POW5_BITCOUNT				61
+
+// floor(2^(pow5bits(i) - 1 + FLOAT_POW5_INV_BITCOUNT) / 5^i) + 1
+static const unsigned long long FLOAT_POW5_INV_SPLIT[31] = {
+	576460752303423489ULL, 461168601842738791ULL, 368934881474191033ULL, 295147905179352826ULL, 472236648286964522ULL,
+	377789318629571618ULL, 302231454903657294ULL, 483570327845851670ULL, 386856262276681336ULL, 309485009821345069ULL,
+	495176015714152110ULL, 396140812571321688ULL, 316912650057057351ULL, 507060240091291761ULL, 405648192073033409ULL,
+	324518553658426727ULL, 519229685853482763ULL, 415383748682786211ULL, 332306998946228969ULL, 531691198313966350ULL,
+	425352958651173080ULL, 340282366920938464ULL, 544451787073501542ULL, 435561429658801234ULL, 348449143727040987ULL,
+	557518629963265579ULL, 446014903970612463ULL, 356811923176489971ULL, 570899077082383953ULL, 456719261665907162ULL,
+	365375409332725730ULL
+};
+
+// 5^i, scaled to FLOAT_POW5_BITCOUNT bits
+static const unsigned long long FLOAT_POW5_SPLIT[47] = {
+	1152921504606846976ULL, 1441151880758558720ULL, 1801439850948198400ULL, 2251799813685248000ULL,
+	1407374883553280000ULL, 1759218604441600000ULL, 2199023255552000000ULL, 1374389534720000000ULL,
+	1717986918400000000ULL, 2147483648000000000ULL, 1342177280000000000ULL, 1677721600000000000ULL,
+	2097152000000000000ULL, 1310720000000000000ULL, 1638400000000000000ULL, 2048000000000000000ULL,
+	1280000000000000000ULL, 1600000000000000000ULL, 2000000000000000000ULL, 1250000000000000000ULL,
+	1562500000000000000ULL, 1953125000000000000ULL, 1220703125000000000ULL, 1525878906250000000ULL,
+	1907348632812500000ULL, 1192092895507812500ULL, 1490116119384765625ULL, 1862645149230957031ULL,
+	1164153218269348144ULL, 1455191522836685180ULL, 1818989403545856475ULL, 2273736754432320594ULL,
+	1421085471520200371ULL, 1776356839400250464ULL, 2220446049250313080ULL, 1387778780781445675ULL,
+	1734723475976807094ULL, 2168404344971008868ULL, 1355252715606880542ULL, 1694065894508600678ULL,
+	2117582368135750847ULL, 1323488980084844279ULL, 1654361225106055349ULL, 2067951531382569187ULL,
+	1292469707114105741ULL, 1615587133892632177ULL, 2019483917365790221ULL
+};
+
+static const char jsonDigitPairs[201] =
+	"00010203040506070809"
+	"10111213141516171819"
+	"20212223242526272829"
+	"30313233343536373839"
+	"40414243444546474849"
+	"50515253545556575859"
+	"60616263646566676869"
+	"70717273747576777879"
+	"80818283848586878889"
+	"90919293949596979899";
+
+int jsonFormatBoolean(char *buf, unsigned char value) {
+	if (value) {
+		memcpy(buf, "true", 5);
+		return 4;
+	}
+	memcpy(buf, "false", 6);
+	return 5;
+}
+
+/**
+ * Writes the digits of value, two at a time, into the end of a temporary buffer, then copies them to buf.
+ */
+int jsonFormatUint64(char *buf, unsigned long long value) {
+	char digits[20];
+	int pos = 20;
+	int len = 0;
+
+	while (value >= 100) {
+		unsigned int pair = (unsigned int) (value % 100);
+		value /= 100;
+		pos -= 2;
+		memcpy(&digits[pos], &jsonDigitPairs[pair * 2], 2);
+	}
+	if (value >= 10) {
+		pos -= 2;
+		memcpy(&digits[pos], &jsonDigitPairs[value * 2], 2);
+	}
+	else {
+		pos--;
+		digits[pos] = (char) ('0' + value);
+	}
+
+	len = 20 - pos;
+	memcpy(buf, &digits[pos], len);
+	buf[len] = '\0';
+
+	return len;
+}
+
+int jsonFormatUint32(char *buf, unsigned int value) {
+	char digits[10];
+	int pos = 10;
+	int len = 0;
+
+	// 32-bit division is much cheaper than 64-bit division on some platforms
+	while (value >= 100) {
+		unsigned int pair = value % 100;
+		value /= 100;
+		pos -= 2;
+		memcpy(&digits[pos], &jsonDigitPairs[pair * 2], 2);
+	}
+	if (value >= 10) {
+		pos -= 2;
+		memcpy(&digits[pos], &jsonDigitPairs[value * 2], 2);
+	}
+	else {
+		pos--;
+		digits[pos] = (char) ('0' + value);
+	}
+
+	len = 10 - pos;
+	memcpy(buf, &digits[pos], len);
+	buf[len] = '\0';
+
+	return len;
+}
+
+int jsonFormatInt32(char *buf, int value) {
+	if (value < 0) {
+		buf[0] = '-';
+		return jsonFormatUint32(&buf[1], 0U - (unsigned int) value) + 1;
+	}
+	return jsonFormatUint32(buf, (unsigned int) value);
+}
+
+int jsonFormatInt64(char *buf, long long value) {
+	if (value < 0) {
+		buf[0] = '-';
+		return jsonFormatUint64(&buf[1], 0ULL - (unsigned long long) value) + 1;
+	}
+	return jsonFormatUint64(buf, (unsigned long long) value);
+}
+
+/**
+ * Prints sign * digits * 10^exponent, where digits has no more than 17 decimal digits. Numbers are printed in fixed
+ * notation, unless they are very large or very small.
+ */
+static int jsonFormatDecimal(char *buf, unsigned char negative, unsigned long long digits, int exponent) {
+	char text[20];
+	int numberOfDigits = jsonFormatUint64(text, digits);
+	int point = numberOfDigits + exponent;		// position of the decimal point, relative to the first digit
+	int len = 0;
+
+	if (negative) {
+		buf[len++] = '-';
+	}
+
+	if (exponent >= 0 && point <= JSON_NUMBER_FIXED_MAX_DIGITS) {
+		// integral value
+		memcpy(&buf[len], text, numberOfDigits);
+		len += numberOfDigits;
+		memset(&buf[len], '0', exponent);
+		len += exponent;
+		memcpy(&buf[len], ".0", 2);
+		len += 2;
+	}
+	else if (point > 0 && point <= JSON_NUMBER_FIXED_MAX_DIGITS) {
+		memcpy(&buf[len], text, point);
+		len += point;
+		buf[len++] = '.';
+		memcpy(&buf[len], &text[point], numberOfDigits - point);
+		len += numberOfDigits - point;
+	}
+	else if (point <= 0 && point > JSON_NUMBER_FIXED_MIN_EXPONENT) {
+		buf[len++] = '0';
+		buf[len++] = '.';
+		memset(&buf[len], '0', -point);
+		len += -point;
+		memcpy(&buf[len], text, numberOfDigits);
+		len += numberOfDigits;
+	}
+	else {
+		buf[len++] = text[0];
+		if (numberOfDigits > 1) {
+			buf[len++] = '.';
+			memcpy(&buf[len], &text[1], numberOfDigits - 1);
+			len += numberOfDigits - 1;
+		}
+		buf[len++] = 'e';
+		len += jsonFormatInt32(&buf[len], point - 1);
+	}
+
+	buf[len] = '\0';
+
+	return len;
+}
+
+static int jsonFormatNull(char *buf) {
+	memcpy(buf, "null", 5);
+	return 4;
+}
+
+// Helper functions for Ryu, for 32-bit floating point values.
+
+static unsigned int pow5factor_32(unsigned int value) {
+	unsigned int count = 0;
+
+	while (value % 5 == 0) {
+		value /= 5;
+		count++;
+	}
+
+	return count;
+}
+
+static int multipleOfPowerOf5_32(unsigned int value, unsigned int p) {
+	return pow5factor_32(value) >= p;
+}
+
+static int multipleOfPowerOf2_32(unsigned int value, unsigned int p) {
+	return (value & ((1U << p) - 1)) == 0;
+}
+
+// returns ceil(log2(5^e)), or 1 if e is 0; valid for 0 <= e <= 3528
+static int pow5bits(int e) {
+	return (int) ((((unsigned int) e) * 1217359) >> 19) + 1;
+}
+
+// returns floor(log10(2^e)); valid for 0 <= e <= 1650
+static unsigned int log10Pow2(int e) {
+	return (((unsigned int) e) * 78913) >> 18;
+}
+
+// returns floor(log10(5^e)); valid for 0 <= e <= 2620
+static unsigned int log10Pow5(int e) {
+	return (((unsigned int) e) * 732923) >> 20;
+}
+
+static unsigned int mulShift32(unsigned int m, unsigned long long factor, int shift) {
+	unsigned int factorLo = (unsigned int) factor;
+	unsigned int factorHi = (unsigned int) (factor >> 32);
+	unsigned long long bits0 = (unsigned long long) m * factorLo;
+	unsigned long long bits1 = (unsigned long long) m * factorHi;
+	unsigned long long sum = (bits0 >> 32) + bits1;
+
+	return (unsigned int) (sum >> (shift - 32));
+}
+
+static unsigned int mulPow5InvDivPow2(unsigned int m, unsigned int q, int j) {
+	return mulShift32(m, FLOAT_POW5_INV_SPLIT[q], j);
+}
+
+static unsigned int mulPow5divPow2(unsigned int m, unsigned int i, int j) {
+	return mulShift32(m, FLOAT_POW5_SPLIT[i], j);
+}
+
+int jsonFormatFloat32(char *buf, float value) {
+	unsigned int bits = 0;
+	unsigned int ieeeMantissa = 0;
+	unsigned int ieeeExponent = 0;
+	unsigned char negative = 0;
+	int e2 = 0;
+	unsigned int m2 = 0;
+	unsigned int mv, mp, mm, mmShift;
+	unsigned int vr, vp, vm;
+	int e10 = 0;
+	int vmIsTrailingZeros = 0;
+	int vrIsTrailingZeros = 0;
+	unsigned int lastRemovedDigit = 0;
+	int removed = 0;
+	int acceptBounds = 0;
+	unsigned int output = 0;
+
+	memcpy(&bits, &value, sizeof(float));
+	ieeeMantissa = bits & ((1U << FLOAT_MANTISSA_BITS) - 1);
+	ieeeExponent = (bits >> FLOAT_MANTISSA_BITS) & ((1U << FLOAT_EXPONENT_BITS) - 1);
+	negative = (unsigned char) (bits >> (FLOAT_MANTISSA_BITS + FLOAT_EXPONENT_BITS));
+
+	if (ieeeExponent == ((1U << FLOAT_EXPONENT_BITS) - 1)) {
+		return jsonFormatNull(buf);
+	}
+	if (ieeeExponent == 0 && ieeeMantissa == 0) {
+		return jsonFormatDecimal(buf, negative, 0, 0);
+	}
+
+	if (ieeeExponent == 0) {
+		e2 = 1 - FLOAT_BIAS - FLOAT_MANTISSA_BITS - 2;
+		m2 = ieeeMantissa;
+	}
+	else {
+		e2 = (int) ieeeExponent - FLOAT_BIAS - FLOAT_MANTISSA_BITS - 2;
+		m2 = (1U << FLOAT_MANTISSA_BITS) | ieeeMantissa;
+	}
+	acceptBounds = (m2 & 1) == 0;
+
+	// step 2: determine the interval of valid decimal representations
+	mv = 4 * m2;
+	mp = 4 * m2 + 2;
+	mmShift = ieeeMantissa != 0 || ieeeExponent <= 1;
+	mm = 4 * m2 - 1 - mmShift;
+
+	// step 3: convert to a decimal power base
+	if (e2 >= 0) {
+		unsigned int q = log10Pow2(e2);
+		int k = FLOAT_POW5_INV_BITCOUNT + pow5bits(q) - 1;
+		int i = -e2 + (int) q + k;
+
+		e10 = (int) q;
+		vr = mulPow5InvDivPow2(mv, q, i);
+		vp = mulPow5InvDivPow2(mp, q, i);
+		vm = mulPow5InvDivPow2(mm, q, i);
+		if (q != 0 && (vp - 1) / 10 <= vm / 10) {
+			// needed to compute the rounding of the last digit, if the loop below removes no digits
+			int l = FLOAT_POW5_INV_BITCOUNT + pow5bits(q - 1) - 1;
+			lastRemovedDigit = mulPow5InvDivPow2(mv, q - 1, -e2 + (int) q - 1 + l) % 10;
+		}
+		if (q <= 9) {
+			// only one of mp, mv, and mm can be a multiple of 5, if any
+			if (mv % 5 == 0) {
+				vrIsTrailingZeros = multipleOfPowerOf5_32(mv, q);
+			}
+			else if (acceptBounds) {
+				vmIsTrailingZeros = multipleOfPowerOf5_32(mm, q);
+			}
+			else {
+				vp -= multipleOfPowerOf5_32(mp, q);
+			}
+		}
+	}
+	else {
+		unsigned int q = log10Pow5(-e2);
+		int i = -e2 - (int) q;
+		int k = pow5bits(i) - FLOAT_POW5_BITCOUNT;
+		int j = (int) q - k;
+
+		e10 = (int) q + e2;
+		vr = mulPow5divPow2(mv, i, j);
+		vp = mulPow5divPow2(mp, i, j);
+		vm = mulPow5divPow2(mm, i, j);
+		if (q != 0 && (vp - 1) / 10 <= vm / 10) {
+			j = (int) q - 1 - (pow5bits(i + 1) - FLOAT_POW5_BITCOUNT);
+			lastRemovedDigit = mulPow5divPow2(mv, i + 1, j) % 10;
+		}
+		if (q <= 1) {
+			// mv = 4 * m2 always has at least two trailing zero bits
+			vrIsTrailingZeros = 1;
+			if (acceptBounds) {
+				vmIsTrailingZeros = mmShift == 1;
+			}
+			else {
+				vp--;
+			}
+		}
+		else if (q < 31) {
+			vrIsTrailingZeros = multipleOfPowerOf2_32(mv, q - 1);
+		}
+	}
+
+	// step 4: find the shortest decimal representation in the interval
+	if (vmIsTrailingZeros || vrIsTrailingZeros) {
+		while (vp / 10 > vm / 10) {
+			vmIsTrailingZeros &= vm % 10 == 0;
+			vrIsTrailingZeros &= lastRemovedDigit == 0;
+			lastRemovedDigit = vr % 10;
+			vr /= 10;
+			vp /= 10;
+			vm /= 10;
+			removed++;
+		}
+		if (vmIsTrailingZeros) {
+			while (vm % 10 == 0) {
+				vrIsTrailingZeros &= lastRemovedDigit == 0;
+				lastRemovedDigit = vr % 10;
+				vr /= 10;
+				vp /= 10;
+				vm /= 10;
+				removed++;
+			}
+		}
+		if (vrIsTrailingZeros && lastRemovedDigit == 5 && vr % 2 == 0) {
+			// round even if the exact number is .....50..0
+			lastRemovedDigit = 4;
+		}
+		output = vr + ((vr == vm && (!acceptBounds || !vmIsTrailingZeros)) || lastRemovedDigit >= 5);
+	}
+	else {
+		// the common case, where no trailing zeros need to be tracked
+		while (vp / 10 > vm / 10) {
+			lastRemovedDigit = vr % 10;
+			vr /= 10;
+			vp /= 10;
+			vm /= 10;
+			removed++;
+		}
+		output = vr + (vr == vm || lastRemovedDigit >= 5);
+	}
+
+	// remove any trailing zeros which remain, so that integral values are printed as such
+	e10 += removed;
+	while (output != 0 && output % 10 == 0) {
+		output /= 10;
+		e10++;
+	}
+
+	return jsonFormatDecimal(buf, negative, output, e10);
+}
+
+int jsonFormatFloat64(char *buf, double value) {
+	char text[JSON_NUMBER_MAX_LENGTH];
+	unsigned long long digits = 0;
+	int exponent = 0;
+	int precision = 0;
+	int i = 0;
+
+	if (value != value || value - value != 0.0) {
+		return jsonFormatNull(buf);
+	}
+
+	for (precision = 14; precision < 17; precision++) {
+		snprintf(text, sizeof(text), "%.*e", precision, value);
+		if (strtod(text, NULL) == value) {
+			break;
+		}
+	}
+
+	// the text has the form "-d.ddde-xx"; collect the digits, and find the exponent of the last one
+	i = text[0] == '-' ? 1 : 0;
+	for (; text[i] != 'e'; i++) {
+		if (text[i] != '.') {
+			digits = digits * 10 + (unsigned long long) (text[i] - '0');
+		}
+	}
+	exponent = atoi(&text[i + 1]) - precision;
+
+	while (digits != 0 && digits % 10 == 0) {
+		digits /= 10;
+		exponent++;
+	}
+
+	return jsonFormatDecimal(buf, text[0] == '-', digits, digits == 0 ? 0 : exponent);
+}
+
+#endif
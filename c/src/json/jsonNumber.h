@@ -0,0 +1,61 @@
+/**
+ * Rapid-prototyping protection schemes with IEC 61850
+ *
+ * Copyright (c) 2014 Steven Blair
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include "ctypes.h"
+#if JSON_INTERFACE == 1
+
+#ifndef JSON_NUMBER_H
+#define JSON_NUMBER_H
+
+#ifdef __cplusplus /* If this is a C++ compiler, use C linkage */
+extern "C" {
+#endif
+
+
+#define JSON_NUMBER_MAX_LENGTH			32		// longest text of any number, including the terminating null character
+
+// Formatting of numbers for JSON output, without the locale and varargs handling of sprintf(). Each function writes the
+// text and a terminating null character to buf, and returns the number of characters written, excluding the null.
+//
+// Floating point values are printed with the fewest significant digits which read back as the same value, using the
+// Ryu algorithm for FLOAT32 (see https://github.com/ulfjack/ryu). Integral values keep a trailing ".0", so that they are
+// still parsed as floating point numbers. NaN and infinite values, which JSON cannot represent, are printed as null.
+
+int jsonFormatBoolean(char *buf, unsigned char value);
+int jsonFormatInt32(char *buf, int value);
+int jsonFormatUint32(char *buf, unsigned int value);
+int jsonFormatInt64(char *buf, long long value);
+int jsonFormatUint64(char *buf, unsigned long long value);
+int jsonFormatFloat32(char *buf, float value);
+
+/**
+ * FLOAT64 values use the shortest of 15, 16, or 17 significant digits which reads back as the same value, which is the
+ * shortest representation for all normal values which can be written with 15 or fewer significant digits.
+ */
+int jsonFormatFloat64(char *buf, double value);
+
+
+#ifdef __cplusplus /* If this is a C++ compiler, end C linkage */
+}
+#endif
+
+#endif /* JSON_NUMBER_H */
+
+#endif
@@ -0,0 +1,368 @@
+/**
+ * Rapid-prototyping protection schemes with IEC 61850
+ *
+ * Copyright (c) 2014 Steven Blair
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include "ctypes.h"
+#if JSON_INTERFACE == 1
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "json.h"
+#include "jsonSubscribe.h"
+
+#define JSON_SUBSCRIBE_MAX_PATH			512
+#define JSON_SUBSCRIBE_EVENT_START		"data: {"
+#define JSON_SUBSCRIBE_EVENT_END		"}\n\n"
+#define JSON_SUBSCRIBE_KEEPALIVE		":\n\n"		// an SSE comment, which clients ignore
+#define JSON_SUBSCRIBE_DCHG				1
+#define JSON_SUBSCRIBE_QCHG				2
+
+static unsigned long long subscription_now() {
+#ifdef _WIN32
+	return (unsigned long long) GetTickCount64();
+#else
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (unsigned long long) ts.tv_sec * 1000ULL + (unsigned long long) ts.tv_nsec / 1000000ULL;
+#endif
+}
+
+static unsigned char subscription_trigger(Item *item) {
+	return ((item->dchg == TRIGGER_OPTION_TRUE) ? JSON_SUBSCRIBE_DCHG : 0) | ((item->qchg == TRIGGER_OPTION_TRUE) ? JSON_SUBSCRIBE_QCHG : 0);
+}
+
+static int subscription_append_path(char *path, int pathLen, char separator, const char *name) {
+	int len = strlen(name);
+
+	if (pathLen + len + 2 > JSON_SUBSCRIBE_MAX_PATH) {
+		return -1;
+	}
+	path[pathLen] = separator;
+	memcpy(&path[pathLen + 1], name, len + 1);
+
+	return pathLen + len + 1;
+}
+
+/**
+ * Internal helper function. Finds target within item, and returns the length of its object reference in path, or -1 if
+ * not found. The trigger options of target and all of its ancestors are combined in trigger.
+ */
+static int subscription_find(Item *item, Item *target, char *path, int pathLen, char separator, unsigned char *trigger) {
+	unsigned char inherited = *trigger;
+	int i = 0;
+
+	if (item == target) {
+		return pathLen;
+	}
+
+	for (i = 0; item->items != NULL && i < item->numberOfItems; i++) {
+		int len = subscription_append_path(path, pathLen, separator, item->items[i].objectRef);
+		int found = -1;
+
+		if (len < 0) {
+			continue;
+		}
+		*trigger = inherited | subscription_trigger(&item->items[i]);
+		found = subscription_find(&item->items[i], target, path, len, '.', trigger);
+		if (found >= 0) {
+			return found;
+		}
+	}
+
+	*trigger = inherited;
+	path[pathLen] = '\0';
+	return -1;
+}
+
+static int subscription_count_triggered(Item *item, unsigned char trigger) {
+	int count = 0;
+	int i = 0;
+
+	trigger |= subscription_trigger(item);
+
+	if (item->type != BASIC_TYPE_CONSTRUCTED) {
+		return (trigger != 0) ? 1 : 0;
+	}
+
+	for (i = 0; item->items != NULL && i < item->numberOfItems; i++) {
+		count += subscription_count_triggered(&item->items[i], trigger);
+	}
+
+	return count;
+}
+
+static int subscription_add_item(JSONSubscription *subscription, Item *item, char *path) {
+	JSONSubscribedItem *subscribed = NULL;
+	int i = 0;
+
+	for (i = 0; i < subscription->numberOfItems; i++) {
+		if (subscription->items[i].item == item) {
+			return 0;
+		}
+	}
+
+	if (subscription->numberOfItems == subscription->sizeOfItems) {
+		int size = (subscription->sizeOfItems > 0) ? subscription->sizeOfItems * 2 : 16;
+		JSONSubscribedItem *items = (JSONSubscribedItem *) realloc(subscription->items, size * sizeof(JSONSubscribedItem));
+
+		if (items == NULL) {
+			return 0;
+		}
+		subscription->items = items;
+		subscription->sizeOfItems = size;
+	}
+
+	subscribed = &subscription->items[subscription->numberOfItems];
+	subscribed->objectRef = (char *) malloc(strlen(path) + 1);
+	if (subscribed->objectRef == NULL) {
+		return 0;
+	}
+	strcpy(subscribed->objectRef, path);
+	subscribed->item = item;
+	subscribed->value = itemValueSignature(item);
+	subscription->numberOfItems++;
+
+	return 1;
+}
+
+static int subscription_add_tree(JSONSubscription *subscription, Item *item, char *path, int pathLen, char separator, unsigned char trigger, unsigned char all) {
+	int count = 0;
+	int i = 0;
+
+	trigger |= subscription_trigger(item);
+
+	if (item->type != BASIC_TYPE_CONSTRUCTED) {
+		if (item->data != NULL && (trigger != 0 || all)) {
+			return subscription_add_item(subscription, item, path);
+		}
+		return 0;
+	}
+
+	for (i = 0; item->items != NULL && i < item->numberOfItems; i++) {
+		int len = subscription_append_path(path, pathLen, separator, item->items[i].objectRef);
+
+		if (len < 0) {
+			continue;
+		}
+		count += subscription_add_tree(subscription, &item->items[i], path, len, '.', trigger, all);
+	}
+	path[pathLen] = '\0';
+
+	return count;
+}
+
+/**
+ * Internal helper function. Sends one event with the attributes which have changed since the last event, or with all
+ * attributes. Returns the number of attributes sent.
+ */
+static int subscription_send(JSONSubscription *subscription, unsigned char all) {
+	char buf[JSON_SUBSCRIBE_BUFFER_SIZE];
+	int len = 0;
+	int count = 0;
+	int i = 0;
+
+	for (i = 0; i < subscription->numberOfItems; i++) {
+		JSONSubscribedItem *subscribed = &subscription->items[i];
+		unsigned long long value = itemValueSignature(subscribed->item);
+		int refLen = 0;
+
+		if (value == subscribed->value && !all) {
+			continue;
+		}
+		subscribed->value = value;
+
+		// an event may be sent in several chunks, because it is a single line
+		refLen = strlen(subscribed->objectRef);
+		if (len + refLen + JSON_SUBSCRIBE_MAX_VALUE + 16 > JSON_SUBSCRIBE_BUFFER_SIZE) {
+			mg_send_data(subscription->conn, buf, len);
+			len = 0;
+		}
+
+		if (count == 0) {
+			memcpy(&buf[len], JSON_SUBSCRIBE_EVENT_START, strlen(JSON_SUBSCRIBE_EVENT_START));
+			len += strlen(JSON_SUBSCRIBE_EVENT_START);
+		}
+		else {
+			buf[len++] = ',';
+		}
+		buf[len++] = '"';
+		memcpy(&buf[len], subscribed->objectRef, refLen);
+		len += refLen;
+		buf[len++] = '"';
+		buf[len++] = ':';
+		len += itemToJSON(&buf[len], subscribed->item);
+		count++;
+	}
+
+	if (count == 0 && all) {
+		memcpy(&buf[len], JSON_SUBSCRIBE_EVENT_START, strlen(JSON_SUBSCRIBE_EVENT_START));
+		len += strlen(JSON_SUBSCRIBE_EVENT_START);
+	}
+	if (count > 0 || all) {
+		memcpy(&buf[len], JSON_SUBSCRIBE_EVENT_END, strlen(JSON_SUBSCRIBE_EVENT_END));
+		len += strlen(JSON_SUBSCRIBE_EVENT_END);
+		mg_send_data(subscription->conn, buf, len);
+	}
+
+	return count;
+}
+
+JSONSubscription *createJSONSubscription(struct mg_connection *conn, int period) {
+	JSONSubscription *subscription = (JSONSubscription *) calloc(1, sizeof(JSONSubscription));
+
+	if (subscription == NULL) {
+		return NULL;
+	}
+
+	if (period <= 0) {
+		period = JSON_SUBSCRIBE_DEFAULT_PERIOD;
+	}
+	else if (period < JSON_SUBSCRIBE_MIN_PERIOD) {
+		period = JSON_SUBSCRIBE_MIN_PERIOD;
+	}
+
+	subscription->conn = conn;
+	subscription->period = period;
+	subscription->lastSent = subscription_now();
+	subscription->nextUpdate = subscription->lastSent + period;
+
+	return subscription;
+}
+
+int jsonSubscriptionAdd(JSONSubscription *subscription, Item *ied, char *objectRef) {
+	char path[JSON_SUBSCRIBE_MAX_PATH];
+	Item *target = getItemFromPath(ied->objectRef, objectRef);
+	int i = 0;
+
+	// TODO must consider AP
+	if (target == NULL || ied->items == NULL || ied->items[0].items == NULL) {
+		return -1;
+	}
+
+	for (i = 0; i < ied->items[0].numberOfItems; i++) {
+		Item *ld = &ied->items[0].items[i];
+		unsigned char trigger = subscription_trigger(ld);
+		int len = strlen(ld->objectRef);
+
+		if (len + 1 > JSON_SUBSCRIBE_MAX_PATH) {
+			continue;
+		}
+		memcpy(path, ld->objectRef, len + 1);
+
+		len = subscription_find(ld, target, path, len, '/', &trigger);
+		if (len >= 0) {
+			// attributes without trigger options are only watched if they are subscribed to explicitly
+			unsigned char all = (subscription_count_triggered(target, trigger) == 0);
+
+			return subscription_add_tree(subscription, target, path, len, (target == ld) ? '/' : '.', trigger, all);
+		}
+	}
+
+	return -1;
+}
+
+void jsonSubscriptionSendAll(JSONSubscription *subscription) {
+	subscription_send(subscription, TRUE);
+	subscription->lastSent = subscription_now();
+}
+
+int pollJSONSubscriptions(JSONSubscription *subscription_list) {
+	JSONSubscription *subscription = subscription_list;
+	unsigned long long now = 0;
+	unsigned long long nextUpdate = ~0ULL;
+
+	if (subscription == NULL) {
+		return -1;
+	}
+
+	now = subscription_now();
+
+	while (subscription != NULL) {
+		if (now >= subscription->nextUpdate) {
+			subscription->nextUpdate += subscription->period;
+			if (subscription->nextUpdate <= now) {
+				subscription->nextUpdate = now + subscription->period;
+			}
+
+			// a slow client receives fewer events, each with all of the changes since the last one it was sent
+			if (mg_get_queued_length(subscription->conn) <= JSON_SUBSCRIBE_MAX_QUEUED) {
+				if (subscription_send(subscription, FALSE) > 0) {
+					subscription->lastSent = now;
+				}
+				else if (now - subscription->lastSent >= JSON_SUBSCRIBE_KEEPALIVE_TIME) {
+					mg_send_data(subscription->conn, JSON_SUBSCRIBE_KEEPALIVE, strlen(JSON_SUBSCRIBE_KEEPALIVE));
+					subscription->lastSent = now;
+				}
+			}
+		}
+
+		if (subscription->nextUpdate < nextUpdate) {
+			nextUpdate = subscription->nextUpdate;
+		}
+		subscription = subscription->next;
+	}
+
+	return (int) (nextUpdate - now);
+}
+
+JSONSubscription *addJSONSubscription(JSONSubscription *subscription_list, JSONSubscription *add) {
+	add->next = subscription_list;
+	return add;
+}
+
+JSONSubscription *removeJSONSubscription(JSONSubscription *subscription_list, JSONSubscription *remove) {
+	JSONSubscription *subscription = subscription_list;
+
+	if (subscription_list == NULL || remove == NULL) {
+		return subscription_list;
+	}
+
+	if (subscription_list == remove) {
+		return remove->next;
+	}
+
+	while (subscription->next != NULL) {
+		if (subscription->next == remove) {
+			subscription->next = remove->next;
+			break;
+		}
+		subscription = subscription->next;
+	}
+
+	return subscription_list;
+}
+
+void freeJSONSubscription(JSONSubscription *subscription) {
+	int i = 0;
+
+	if (subscription == NULL) {
+		return;
+	}
+
+	for (i = 0; i < subscription->numberOfItems; i++) {
+		free(subscription->items[i].objectRef);
+	}
+	free(subscription->items);
+	free(subscription);
+}
+
+#endif
@@ -0,0 +1,108 @@
+/**
+ * Rapid-prototyping protection schemes with IEC 61850
+ *
+ * Copyright (c) 2014 Steven Blair
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include "ctypes.h"
+#if JSON_INTERFACE == 1
+
+#ifndef JSON_SUBSCRIBE_H
+#define JSON_SUBSCRIBE_H
+
+#ifdef __cplusplus /* If this is a C++ compiler, use C linkage */
+extern "C" {
+#endif
+
+
+#include "dataModelIndex.h"
+
+#define JSON_SUBSCRIBE_DEFAULT_PERIOD	100		// ms; changes within one period are sent as a single event
+#define JSON_SUBSCRIBE_MIN_PERIOD		10		// ms
+#define JSON_SUBSCRIBE_KEEPALIVE_TIME	15000	// ms; must be less than the mongoose idle_timeout_ms option
+#define JSON_SUBSCRIBE_MAX_QUEUED		65536	// bytes; events are delayed, and coalesced, while more than this is unsent
+#define JSON_SUBSCRIBE_BUFFER_SIZE		8192
+#define JSON_SUBSCRIBE_MAX_VALUE		1040	// space reserved for one formatted value, e.g., a Unicode string
+
+/**
+ * A data attribute which is watched for changes.
+ */
+typedef struct JSONSubscribedItem {
+	Item *item;
+	char *objectRef;				// reference sent to the client, e.g., "C1/MMXU1.PhV.phsA.cVal.mag.f"
+	unsigned long long value;		// itemValueSignature() of the last value sent to the client
+} JSONSubscribedItem;
+
+/**
+ * An open Server-Sent Events response, which pushes the data attributes that have changed once per period. Each
+ * event is a single JSON object of object references and values, e.g.:
+ *
+ *     data: {"C1/MMXU1.PhV.phsA.cVal.mag.f":6350.853}
+ */
+typedef struct JSONSubscription {
+	struct mg_connection *conn;
+	JSONSubscribedItem *items;
+	int numberOfItems;
+	int sizeOfItems;
+	int period;						// ms
+	unsigned long long nextUpdate;	// ms
+	unsigned long long lastSent;	// ms
+	struct JSONSubscription *next;
+} JSONSubscription;
+
+/**
+ * Creates an empty subscription for a connection. The period is limited to JSON_SUBSCRIBE_MIN_PERIOD, and is
+ * JSON_SUBSCRIBE_DEFAULT_PERIOD if zero. Returns NULL if memory cannot be allocated.
+ */
+JSONSubscription *createJSONSubscription(struct mg_connection *conn, int period);
+
+/**
+ * Adds the data attributes within objectRef, e.g., "C1/MMXU1.PhV", to a subscription. Only attributes with dchg or qchg
+ * trigger options (or within a data attribute with these options) are watched, as for reports; if there are none within
+ * objectRef, all of its attributes are watched. Attributes which are already watched are not added again.
+ *
+ * Returns the number of attributes added, or -1 if objectRef is not a Logical Device, or an item within one, of ied.
+ */
+int jsonSubscriptionAdd(JSONSubscription *subscription, Item *ied, char *objectRef);
+
+/**
+ * Sends the current value of every watched attribute as one event, e.g., when a subscription starts.
+ */
+void jsonSubscriptionSendAll(JSONSubscription *subscription);
+
+/**
+ * Sends an event for each subscription in the list which has changed values and has reached the end of its period,
+ * or a comment if nothing has been sent for JSON_SUBSCRIBE_KEEPALIVE_TIME. Must be called from the thread which
+ * polls the server of the connections. Returns the number of milliseconds until the next subscription is due, so that
+ * the server can wait for network events until then, or -1 if the list is empty.
+ */
+int pollJSONSubscriptions(JSONSubscription *subscription_list);
+
+JSONSubscription *addJSONSubscription(JSONSubscription *subscription_list, JSONSubscription *add);
+
+JSONSubscription *removeJSONSubscription(JSONSubscription *subscription_list, JSONSubscription *remove);
+
+void freeJSONSubscription(JSONSubscription *subscription);
+
+
+#ifdef __cplusplus /* If this is a C++ compiler, end C linkage */
+}
+#endif
+
+#endif /* JSON_SUBSCRIBE_H */
+
+#endif
@@ -0,0 +1,557 @@
+/**
+ * Rapid-prototyping protection schemes with IEC 61850
+ *
+ * Copyright (c) 2014 Steven Blair
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include "ctypes.h"
+#if JSON_INTERFACE == 1
+
+#include <stdarg.h>
+#include "json.h"
+#include "jsonCbor.h"
+#include "jsonNumber.h"
+#include "jsonWriter.h"
+#if JSON_COMPRESSION == 1
+#include <zlib.h>
+#endif
+
+#define JSON_WRITER_HAS_ITEMS(item)		((item)->type == BASIC_TYPE_CONSTRUCTED && (item)->numberOfItems > 0)
+
+JSONWriter *createJSONWriter(struct mg_connection *conn, Item *root, JSONWriterContent content, unsigned char pretty) {
+	JSONWriter *writer = (JSONWriter *) malloc(sizeof(JSONWriter));
+
+	if (writer != NULL) {
+		writer->conn = conn;
+		writer->output = NULL;
+		writer->outputLength = 0;
+		writer->outputSize = 0;
+		writer->content = content;
+		writer->pretty = pretty;
+		writer->flushed = FALSE;
+		writer->since = 0;
+		writer->binary = FALSE;
+		writer->name = NULL;
+		writer->member = FALSE;
+		writer->compressor = NULL;
+		writer->len = 0;
+		jsonWriterReset(writer, root);
+	}
+
+	return writer;
+}
+
+void freeJSONWriter(JSONWriter *writer) {
+	if (writer == NULL) {
+		return;
+	}
+#if JSON_COMPRESSION == 1
+	if (writer->compressor != NULL) {
+		deflateEnd(writer->compressor);
+		free(writer->compressor);
+	}
+#endif
+	free(writer);
+}
+
+unsigned char jsonWriterCompress(JSONWriter *writer, JSONContentEncoding encoding) {
+#if JSON_COMPRESSION == 1
+	z_stream *stream = NULL;
+
+	if (encoding == JSON_ENCODING_IDENTITY || writer->compressor != NULL || writer->member) {
+		return FALSE;
+	}
+
+	stream = (z_stream *) calloc(1, sizeof(z_stream));
+	if (stream == NULL) {
+		return FALSE;
+	}
+
+	// adding 16 to the window size selects the gzip header and trailer, rather than zlib
+	if (deflateInit2(stream, JSON_COMPRESSION_LEVEL, Z_DEFLATED, (encoding == JSON_ENCODING_GZIP) ? MAX_WBITS + 16 : MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+		free(stream);
+		return FALSE;
+	}
+	writer->compressor = stream;
+
+	return TRUE;
+#else
+	return FALSE;
+#endif
+}
+
+void jsonWriterReset(JSONWriter *writer, Item *root) {
+	writer->depth = 0;
+	writer->stack[0].item = root;
+	writer->stack[0].next = -1;
+	writer->stack[0].written = 0;
+}
+
+/**
+ * Returns the name written for an item; the root may be renamed.
+ */
+static const char *jsonWriterName(JSONWriter *writer, Item *item, int depth) {
+	return (depth == 0 && writer->name != NULL) ? writer->name : item->objectRef;
+}
+
+/**
+ * Sends a chunk of output, or appends it to the output in memory.
+ */
+static void jsonWriterSend(JSONWriter *writer, const char *data, int len) {
+	if (writer->conn != NULL) {
+		mg_send_data(writer->conn, data, len);
+	}
+	else if (writer->outputSize >= 0) {
+		if (writer->outputLength + len + 1 > writer->outputSize) {
+			int size = writer->outputSize > 0 ? writer->outputSize : JSON_WRITER_BUFFER_SIZE;
+			char *output = NULL;
+
+			while (size < writer->outputLength + len + 1) {
+				size *= 2;
+			}
+			output = (char *) realloc(writer->output, size);
+			if (output == NULL) {
+				// give up, and discard all output
+				free(writer->output);
+				writer->output = NULL;
+				writer->outputSize = -1;
+				return;
+			}
+			writer->output = output;
+			writer->outputSize = size;
+		}
+
+		memcpy(&writer->output[writer->outputLength], data, len);
+		writer->outputLength += len;
+		writer->output[writer->outputLength] = '\0';
+	}
+
+	writer->flushed = TRUE;
+}
+
+#if JSON_COMPRESSION == 1
+/**
+ * Compresses data, and sends each full buffer of compressed output. With Z_FINISH, the rest of the compressed stream is
+ * sent. The writer is only flushed once compressed output has been sent, so that the walk continues while the
+ * compressor is still collecting input.
+ */
+static void jsonWriterDeflate(JSONWriter *writer, const char *data, int len, int flush) {
+	z_stream *stream = writer->compressor;
+	char out[JSON_WRITER_BUFFER_SIZE];
+	int result = Z_OK;
+
+	stream->next_in = (Bytef *) data;
+	stream->avail_in = len;
+
+	do {
+		stream->next_out = (Bytef *) out;
+		stream->avail_out = sizeof(out);
+		result = deflate(stream, flush);
+		if (sizeof(out) - stream->avail_out > 0) {
+			jsonWriterSend(writer, out, sizeof(out) - stream->avail_out);
+		}
+	} while (stream->avail_out == 0 && result == Z_OK);
+}
+#endif
+
+/**
+ * Passes a chunk of output to the compressor, if there is one, or sends it.
+ */
+static void jsonWriterEmit(JSONWriter *writer, const char *data, int len) {
+#if JSON_COMPRESSION == 1
+	if (writer->compressor != NULL) {
+		jsonWriterDeflate(writer, data, len, Z_NO_FLUSH);
+		return;
+	}
+#endif
+	jsonWriterSend(writer, data, len);
+}
+
+void jsonWriterFlush(JSONWriter *writer) {
+	if (writer->len > 0) {
+		jsonWriterEmit(writer, writer->buf, writer->len);
+		writer->len = 0;
+	}
+}
+
+void jsonWriterWrite(JSONWriter *writer, const char *data, int len) {
+	if (len > JSON_WRITER_BUFFER_SIZE - writer->len) {
+		jsonWriterFlush(writer);
+	}
+
+	if (len > JSON_WRITER_BUFFER_SIZE) {
+		// too large to buffer, so send as a chunk of its own
+		jsonWriterEmit(writer, data, len);
+	}
+	else if (len > 0) {
+		memcpy(&writer->buf[writer->len], data, len);
+		writer->len += len;
+	}
+}
+
+void jsonWriterPrintf(JSONWriter *writer, const char *format, ...) {
+	va_list args;
+	int space = JSON_WRITER_BUFFER_SIZE - writer->len;
+	int len = 0;
+
+	va_start(args, format);
+	len = vsnprintf(&writer->buf[writer->len], space, format, args);
+	va_end(args);
+
+	if (len < 0) {
+		return;
+	}
+	else if (len < space) {
+		writer->len += len;
+		return;
+	}
+
+	// the text was truncated, so start a new chunk and print it again
+	jsonWriterFlush(writer);
+
+	if (len < JSON_WRITER_BUFFER_SIZE) {
+		va_start(args, format);
+		writer->len = vsnprintf(writer->buf, JSON_WRITER_BUFFER_SIZE, format, args);
+		va_end(args);
+	}
+	else {
+		char *text = (char *) malloc(len + 1);
+
+		if (text != NULL) {
+			va_start(args, format);
+			vsnprintf(text, len + 1, format, args);
+			va_end(args);
+
+			jsonWriterEmit(writer, text, len);
+			free(text);
+		}
+	}
+}
+
+/**
+ * Writes the value of a leaf item, in the same format as itemToJSON(). String values may be of any length.
+ */
+static void jsonWriterValue(JSONWriter *writer, Item *item) {
+	char valueBuf[JSON_NUMBER_MAX_LENGTH];
+
+	switch (item->type) {
+		case BASIC_TYPE_CONSTRUCTED:
+			return;
+		case BASIC_TYPE_OCTET_STRING:
+			jsonWriterWrite(writer, (const char *) item->data, strlen((const char *) item->data));
+			return;
+		case BASIC_TYPE_VISIBLE_STRING:
+		case BASIC_TYPE_CURRENCY:
+			jsonWriterPrintf(writer, "\"%s\"", (CTYPE_VISSTRING255) item->data);
+			return;
+		case BASIC_TYPE_UNICODE_STRING:
+			jsonWriterPrintf(writer, "\"%ls\"", (wchar_t *) item->data);
+			return;
+		default:
+			jsonWriterWrite(writer, valueBuf, itemToJSON(valueBuf, item));
+			return;
+	}
+}
+
+/**
+ * Writes the value of a leaf item as CBOR.
+ */
+static void jsonWriterBinaryValue(JSONWriter *writer, Item *item) {
+	unsigned char valueBuf[JSON_CBOR_MAX_HEAD];
+	int len = itemCBORLength(item);
+
+	if (len <= JSON_CBOR_MAX_HEAD) {
+		jsonWriterWrite(writer, (const char *) valueBuf, itemToCBOR(valueBuf, item));
+	}
+	else {
+		unsigned char *value = (unsigned char *) malloc(len);
+
+		if (value != NULL) {
+			jsonWriterWrite(writer, (const char *) value, itemToCBOR(value, item));
+			free(value);
+		}
+	}
+}
+
+/**
+ * Writes the name of an item, and the start of its map of sub-items or its value, as CBOR.
+ */
+static void jsonWriterBinaryOpen(JSONWriter *writer, Item *item, int depth) {
+	unsigned char head[JSON_CBOR_MAX_HEAD + 1];
+	const char *name = jsonWriterName(writer, item, depth);
+	int nameLen = strlen(name);
+	int len = 0;
+
+	if (depth == 0 && !writer->member) {
+		head[len++] = JSON_CBOR_MAP_START;
+	}
+	len += cborEncodeHead(&head[len], JSON_CBOR_MAJOR_TEXT, nameLen);
+	jsonWriterWrite(writer, (const char *) head, len);
+	jsonWriterWrite(writer, name, nameLen);
+
+	if (item->type == BASIC_TYPE_CONSTRUCTED) {
+		head[0] = JSON_CBOR_MAP_START;
+		jsonWriterWrite(writer, (const char *) head, 1);
+	}
+	else {
+		jsonWriterBinaryValue(writer, item);
+	}
+}
+
+static void jsonWriterBinaryClose(JSONWriter *writer, Item *item, int depth) {
+	const char end[2] = {(char) JSON_CBOR_BREAK, (char) JSON_CBOR_BREAK};
+
+	jsonWriterWrite(writer, end, ((item->type == BASIC_TYPE_CONSTRUCTED) ? 1 : 0) + ((depth == 0 && !writer->member) ? 1 : 0));
+}
+
+/**
+ * Writes the optional attributes of an item description. Each attribute starts on a new line, after the given
+ * indentation, if the output is prettified.
+ */
+static void jsonWriterAttributes(JSONWriter *writer, Item *item, int tab) {
+	const char *separator = writer->pretty ? ",\n    %*s\"%s\" : " : ",%*s\"%s\":";
+
+	if (!writer->pretty) {
+		tab = 0;
+	}
+
+	if (item->lnClass != NULL) {
+		jsonWriterPrintf(writer, separator, tab, "", "lnClass");
+		jsonWriterPrintf(writer, "\"%s\"", item->lnClass);
+	}
+	if (item->CDC != NULL) {
+		jsonWriterPrintf(writer, separator, tab, "", "CDC");
+		jsonWriterPrintf(writer, "\"%s\"", item->CDC);
+	}
+	if (item->FC != NULL) {
+		jsonWriterPrintf(writer, separator, tab, "", "FC");
+		jsonWriterPrintf(writer, "\"%s\"", item->FC);
+	}
+	if (item->dchg != TRIGGER_OPTION_NOT_SPECIFIED) {
+		jsonWriterPrintf(writer, separator, tab, "", "dchg");
+		jsonWriterPrintf(writer, "%s", item->dchg == TRIGGER_OPTION_TRUE ? "true" : "false");
+	}
+	if (item->qchg != TRIGGER_OPTION_NOT_SPECIFIED) {
+		jsonWriterPrintf(writer, separator, tab, "", "qchg");
+		jsonWriterPrintf(writer, "%s", item->qchg == TRIGGER_OPTION_TRUE ? "true" : "false");
+	}
+}
+
+/**
+ * Writes everything which precedes the sub-items of an item.
+ */
+static void jsonWriterOpen(JSONWriter *writer, Item *item, int depth) {
+	if (writer->binary) {
+		jsonWriterBinaryOpen(writer, item, depth);
+	}
+	else if (writer->content == JSON_WRITER_VALUES) {
+		if (writer->pretty) {
+			if (depth == 0) {
+				jsonWriterPrintf(writer, JSON_WRITER_HAS_ITEMS(item) ? "%s    \"%s\" : {\n" : "%s    \"%s\" : ", writer->member ? "" : "{\n", jsonWriterName(writer, item, depth));
+			}
+			else {
+				jsonWriterPrintf(writer, item->type == BASIC_TYPE_CONSTRUCTED ? "    %*s\"%s\" : {" : "    %*s\"%s\" : ", depth * 4, " ", item->objectRef);
+				if (JSON_WRITER_HAS_ITEMS(item)) {
+					jsonWriterWrite(writer, "\n", 1);
+				}
+			}
+		}
+		else {
+			if (depth == 0) {
+				jsonWriterPrintf(writer, JSON_WRITER_HAS_ITEMS(item) ? "%s\"%s\":{" : "%s\"%s\":", writer->member ? "" : "{", jsonWriterName(writer, item, depth));
+			}
+			else {
+				jsonWriterPrintf(writer, item->type == BASIC_TYPE_CONSTRUCTED ? "\"%s\":{" : "\"%s\":", item->objectRef);
+			}
+		}
+
+		if (!JSON_WRITER_HAS_ITEMS(item)) {
+			jsonWriterValue(writer, item);
+		}
+	}
+	else if (writer->pretty) {
+		int tab = depth * 8;
+
+		if (depth == 0) {
+			jsonWriterPrintf(writer, "{\n    \"name\" : \"%s\",\n    \"type\" : \"%s\"", item->objectRef, item->typeSCL);
+		}
+		else {
+			jsonWriterPrintf(writer, "%*s{\n    %*s\"name\" : \"%s\",\n    %*s\"type\" : \"%s\"", tab, " ", tab, " ", item->objectRef, tab, " ", item->typeSCL);
+		}
+		jsonWriterAttributes(writer, item, tab);
+
+		if (depth > 0 || writer->content == JSON_WRITER_DIRECTORY) {
+			jsonWriterPrintf(writer, ",\n    %*s\"items\" : [", tab, "");
+			if (JSON_WRITER_HAS_ITEMS(item)) {
+				jsonWriterWrite(writer, "\n", 1);
+			}
+		}
+	}
+	else {
+		jsonWriterPrintf(writer, "{\"name\":\"%s\",\"type\":\"%s\"", item->objectRef, item->typeSCL);
+		jsonWriterAttributes(writer, item, 0);
+
+		if (depth > 0 || writer->content == JSON_WRITER_DIRECTORY) {
+			jsonWriterWrite(writer, ",\"items\":[", 10);
+		}
+	}
+}
+
+/**
+ * Writes the separator between two sub-items.
+ */
+static void jsonWriterSeparator(JSONWriter *writer) {
+	if (writer->binary) {
+		return;
+	}
+	else if (writer->pretty) {
+		jsonWriterWrite(writer, ",\n", 2);
+	}
+	else {
+		jsonWriterWrite(writer, ",", 1);
+	}
+}
+
+/**
+ * Writes everything which follows the sub-items of an item.
+ */
+static void jsonWriterClose(JSONWriter *writer, Item *item, int depth) {
+	if (writer->binary) {
+		jsonWriterBinaryClose(writer, item, depth);
+	}
+	else if (writer->content == JSON_WRITER_VALUES) {
+		if (writer->pretty) {
+			if (depth == 0) {
+				jsonWriterPrintf(writer, "%s%s", JSON_WRITER_HAS_ITEMS(item) ? "\n    }" : "", writer->member ? "" : "\n}");
+			}
+			else if (item->type == BASIC_TYPE_CONSTRUCTED) {
+				jsonWriterPrintf(writer, "\n    %*s}", depth * 4, " ");
+			}
+		}
+		else {
+			if (depth == 0) {
+				jsonWriterPrintf(writer, "%s%s", JSON_WRITER_HAS_ITEMS(item) ? "}" : "", writer->member ? "" : "}");
+			}
+			else if (item->type == BASIC_TYPE_CONSTRUCTED) {
+				jsonWriterWrite(writer, "}", 1);
+			}
+		}
+	}
+	else if (writer->pretty) {
+		int tab = depth * 8;
+
+		if (depth == 0) {
+			if (writer->content == JSON_WRITER_DIRECTORY) {
+				jsonWriterPrintf(writer, JSON_WRITER_HAS_ITEMS(item) ? "\n   ]" : "]");
+			}
+			jsonWriterWrite(writer, "\n}", 2);
+		}
+		else if (JSON_WRITER_HAS_ITEMS(item)) {
+			jsonWriterPrintf(writer, "\n    %*s]\n%*s}", tab, " ", tab, " ");
+		}
+		else {
+			jsonWriterPrintf(writer, "]\n%*s}", tab, " ");
+		}
+	}
+	else {
+		if (depth > 0 || writer->content == JSON_WRITER_DIRECTORY) {
+			jsonWriterWrite(writer, "]", 1);
+		}
+		jsonWriterWrite(writer, "}", 1);
+	}
+}
+
+/**
+ * Returns the number of sub-items of the item at the given depth which are to be written.
+ */
+static int jsonWriterNumberOfItems(JSONWriter *writer, Item *item, int depth) {
+	if (!JSON_WRITER_HAS_ITEMS(item) || depth + 1 >= JSON_WRITER_MAX_DEPTH) {
+		return 0;
+	}
+	if (depth == 0 && writer->content == JSON_WRITER_DEFINITION) {
+		return 0;
+	}
+
+	return item->numberOfItems;
+}
+
+unsigned char jsonWriterStep(JSONWriter *writer) {
+	writer->flushed = FALSE;
+
+	while (writer->depth >= 0 && !writer->flushed) {
+		JSONWriterFrame *frame = &writer->stack[writer->depth];
+
+		if (frame->next < 0) {
+			jsonWriterOpen(writer, frame->item, writer->depth);
+			frame->next = 0;
+		}
+		else if (frame->next < jsonWriterNumberOfItems(writer, frame->item, writer->depth)) {
+			Item *item = &frame->item->items[frame->next];
+
+			frame->next++;
+			if (writer->since != 0 && item->version <= writer->since) {
+				continue;
+			}
+			if (frame->written > 0) {
+				jsonWriterSeparator(writer);
+			}
+			frame->written++;
+			writer->depth++;
+			writer->stack[writer->depth].item = item;
+			writer->stack[writer->depth].next = -1;
+			writer->stack[writer->depth].written = 0;
+		}
+		else {
+			jsonWriterClose(writer, frame->item, writer->depth);
+			writer->depth--;
+		}
+	}
+
+	if (writer->depth < 0) {
+		if (!writer->member) {
+			jsonWriterFlush(writer);
+#if JSON_COMPRESSION == 1
+			if (writer->compressor != NULL) {
+				jsonWriterDeflate(writer, NULL, 0, Z_FINISH);
+			}
+#endif
+		}
+		return TRUE;
+	}
+
+	return FALSE;
+}
+
+char *jsonWriterToString(Item *root, JSONWriterContent content, unsigned char pretty, int *len) {
+	JSONWriter *writer = createJSONWriter(NULL, root, content, pretty);
+	char *output = NULL;
+
+	if (writer == NULL) {
+		return NULL;
+	}
+
+	while (!jsonWriterStep(writer)) {
+	}
+
+	output = writer->output;
+	*len = writer->outputLength;
+	freeJSONWriter(writer);
+
+	return output;
+}
+
+#endif
@@ -0,0 +1,152 @@
+/**
+ * Rapid-prototyping protection schemes with IEC 61850
+ *
+ * Copyright (c) 2014 Steven Blair
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include "ctypes.h"
+#if JSON_INTERFACE == 1
+
+#ifndef JSON_WRITER_H
+#define JSON_WRITER_H
+
+#ifdef __cplusplus /* If this is a C++ compiler, use C linkage */
+extern "C" {
+#endif
+
+
+#include "dataModelIndex.h"
+#include "mongoose.h"
+
+#define JSON_WRITER_BUFFER_SIZE			8192	// size of each chunk of HTTP output, and the limit of unsent output per connection
+#define JSON_WRITER_MAX_DEPTH			32		// items nested more deeply are written without their sub-items
+
+/**
+ * The kind of response written for an Item hierarchy.
+ */
+typedef enum {
+	JSON_WRITER_VALUES = 0,			// values of all items, as itemTreeToJSON()
+	JSON_WRITER_DEFINITION,			// description of the root item only, as itemDescriptionTreeToJSON(buf, root, FALSE)
+	JSON_WRITER_DIRECTORY			// description of all items, as itemDescriptionTreeToJSON(buf, root, TRUE)
+} JSONWriterContent;
+
+/**
+ * Content coding of a response body, negotiated from the Accept-Encoding request header (see JSON_COMPRESSION).
+ */
+typedef enum {
+	JSON_ENCODING_IDENTITY = 0,
+	JSON_ENCODING_GZIP,
+	JSON_ENCODING_DEFLATE			// the zlib format, as HTTP specifies for "deflate"
+} JSONContentEncoding;
+
+#define JSON_WRITER_ENCODINGS			3
+
+/**
+ * Position within one level of the Item hierarchy.
+ */
+typedef struct JSONWriterFrame {
+	Item *item;
+	int next;					// index of the next sub-item to write, or -1 if the item has not been opened
+	int written;				// number of sub-items written
+} JSONWriterFrame;
+
+/**
+ * Streams the JSON representation of an Item hierarchy to an HTTP connection, as chunked output of bounded size.
+ *
+ * The tree is walked with an explicit stack, rather than by recursion, so that the walk can be suspended whenever a
+ * chunk has been queued and resumed when mongoose has sent it. Memory use is therefore independent of the size of the
+ * response. The output is identical to that of the corresponding buffer-based functions in json.h.
+ */
+typedef struct JSONWriter {
+	struct mg_connection *conn;	// destination of the output, or NULL to collect the output in memory
+	char *output;				// output collected in memory, if conn is NULL
+	int outputLength;
+	int outputSize;
+	JSONWriterContent content;
+	unsigned char pretty;		// include whitespace, as JSON_OUTPUT_PRETTIFY
+	unsigned char flushed;		// a chunk has been queued during the current step
+	unsigned long long since;	// if non-zero, only items with a later version are written (see updateItemVersions())
+	unsigned char binary;		// write CBOR rather than JSON (see jsonCbor.h); only for JSON_WRITER_VALUES
+	const char *name;			// if not NULL, written instead of the name of the root item
+	unsigned char member;		// write the root as a member of an object which the caller opens and closes; only for JSON_WRITER_VALUES
+	struct z_stream_s *compressor;	// if not NULL, the output is compressed before it is sent (see jsonWriterCompress())
+	int depth;					// index of the top of the stack, or -1 when the walk is complete
+	JSONWriterFrame stack[JSON_WRITER_MAX_DEPTH];
+	int len;
+	char buf[JSON_WRITER_BUFFER_SIZE];
+} JSONWriter;
+
+/**
+ * Allocates a writer for the hierarchy starting at root. If conn is NULL, the output is collected in memory instead.
+ * Returns NULL if memory cannot be allocated.
+ */
+JSONWriter *createJSONWriter(struct mg_connection *conn, Item *root, JSONWriterContent content, unsigned char pretty);
+
+/**
+ * Frees a writer, and its compressor.
+ */
+void freeJSONWriter(JSONWriter *writer);
+
+/**
+ * Compresses all further output with the given content coding, as a single gzip or zlib stream which is completed when
+ * the whole response has been written. Only for writers which are not written as a member. Returns FALSE, and leaves
+ * the output uncompressed, for JSON_ENCODING_IDENTITY, if JSON_COMPRESSION is 0, or if memory cannot be allocated.
+ */
+unsigned char jsonWriterCompress(JSONWriter *writer, JSONContentEncoding encoding);
+
+/**
+ * Restarts the walk at a new root, keeping any buffered output, so that several hierarchies can be written to one
+ * response (see the member field).
+ */
+void jsonWriterReset(JSONWriter *writer, Item *root);
+
+/**
+ * Writes the whole hierarchy starting at root to a new null-terminated string, which the caller must free(). The length
+ * of the string is returned in len. Returns NULL if memory cannot be allocated.
+ */
+char *jsonWriterToString(Item *root, JSONWriterContent content, unsigned char pretty, int *len);
+
+/**
+ * Walks the hierarchy until at least one chunk of output has been queued with mg_send_data(). Returns TRUE when the
+ * whole response has been queued, and FALSE if jsonWriterStep() must be called again. If the root is written as a
+ * member, the remaining output is left in the buffer for the caller to flush.
+ */
+unsigned char jsonWriterStep(JSONWriter *writer);
+
+/**
+ * Appends data to the output, queueing a chunk if the buffer is full.
+ */
+void jsonWriterWrite(JSONWriter *writer, const char *data, int len);
+
+/**
+ * Appends formatted text to the output, queueing a chunk if the buffer is full. Text of any length is allowed.
+ */
+void jsonWriterPrintf(JSONWriter *writer, const char *format, ...);
+
+/**
+ * Queues all buffered output as a chunk, or appends it to the output in memory.
+ */
+void jsonWriterFlush(JSONWriter *writer);
+
+
+#ifdef __cplusplus /* If this is a C++ compiler, end C linkage */
+}
+#endif
+
+#endif /* JSON_WRITER_H */
+
+#endif
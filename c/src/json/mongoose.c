@@ -97,9 +97,15 @@ typedef struct _stati64 file_stat_t;
 #include <netdb.h>
 #include <arpa/inet.h>  // For inet_pton() when USE_IPV6 is defined
 #include <netinet/in.h>
+#include <netinet/tcp.h>
 #include <sys/socket.h>
 #include <sys/select.h>
 #define closesocket(x) close(x)
+#if defined(__linux__) && !defined(NO_EPOLL)
+#define USE_EPOLL
+#include <sys/epoll.h>
+#include <poll.h>
+#endif
 typedef int sock_t;
 typedef pthread_mutex_t mutex_t;
 typedef struct stat file_stat_t;
@@ -290,6 +296,10 @@ struct mg_server {
   void *server_data;
   void *ssl_ctx;    // SSL context
   sock_t ctl[2];    // Control socketpair. Used to wake up from select() call
+#ifdef USE_EPOLL
+  int epoll_fd;           // Listening, control and client sockets
+  time_t last_expiry_check;
+#endif
 };
 
 // Expandable IO buffer
@@ -331,10 +341,53 @@ struct connection {
   int request_len;  // Request length, including last \r\n after last header
   int flags;        // CONN_* flags: CONN_CLOSE, CONN_SPOOL_DONE, etc
   void *ssl;        // SSL descriptor
+#ifdef USE_EPOLL
+  uint32_t epoll_events;  // Events currently registered with epoll
+#endif
 };
 
 static void close_local_endpoint(struct connection *conn);
 
+#ifdef USE_EPOLL
+static void add_to_epoll(struct mg_server *server, sock_t sock, void *ptr) {
+  struct epoll_event ev;
+  ev.events = EPOLLIN;
+  ev.data.ptr = ptr;
+  epoll_ctl(server->epoll_fd, EPOLL_CTL_ADD, sock, &ev);
+}
+
+// Connections always wait for input, and wait for output only while there
+// is data queued, so that an idle server is never woken up
+static void update_epoll(struct connection *conn) {
+  struct epoll_event ev;
+  uint32_t events = EPOLLIN;
+
+  if ((conn->remote_iobuf.len > 0 && !(conn->flags & CONN_BUFFER)) ||
+      conn->endpoint_type == EP_FILE) {
+    events |= EPOLLOUT;
+  }
+  if (events != conn->epoll_events) {
+    ev.events = events;
+    ev.data.ptr = conn;
+    epoll_ctl(conn->server->epoll_fd, conn->epoll_events == 0 ?
+              EPOLL_CTL_ADD : EPOLL_CTL_MOD, conn->client_sock, &ev);
+    conn->epoll_events = events;
+  }
+}
+#endif
+
+// Called when output is queued from outside the connection's own events,
+// e.g. by a handler pushing data to an open connection
+static void conn_output_queued(struct connection *conn) {
+#ifdef USE_EPOLL
+  if (!(conn->epoll_events & EPOLLOUT)) {
+    update_epoll(conn);
+  }
+#else
+  (void) conn;
+#endif
+}
+
 static const struct {
   const char *extension;
   size_t ext_len;
@@ -735,6 +788,7 @@ static void write_chunk(struct connection *conn, const char *buf, int len) {
   spool(&conn->remote_iobuf, chunk_size, n);
   spool(&conn->remote_iobuf, buf, len);
   spool(&conn->remote_iobuf, "\r\n", 2);
+  conn_output_queued(conn);
 }
 
 int mg_vprintf(struct mg_connection *conn, const char *fmt, va_list ap,
@@ -1146,6 +1200,10 @@ static void open_cgi_endpoint(struct connection *conn, const char *prog) {
                     prog, blk.buf, blk.vars, dir, fds[1]) > 0) {
     conn->endpoint_type = EP_CGI;
     conn->endpoint.cgi_sock = fds[0];
+#ifdef USE_EPOLL
+    // The low bit tells CGI output apart from the client socket
+    add_to_epoll(conn->server, fds[0], (char *) conn + 1);
+#endif
     spool(&conn->remote_iobuf, cgi_status, sizeof(cgi_status) - 1);
     conn->flags |= CONN_BUFFER;
   } else {
@@ -1308,8 +1366,13 @@ static struct connection *accept_new_connection(struct mg_server *server) {
     conn = NULL;
 #endif
   } else {
+    int on = 1;
     set_close_on_exec(sock);
     set_non_blocking_mode(sock);
+    // Responses are spooled whole, so Nagle's algorithm only delays the last
+    // segment of each write, until the client's delayed ACK for the previous
+    // one. This stalls pipelined requests on a keep-alive connection.
+    setsockopt(sock, IPPROTO_TCP, TCP_NODELAY, (const char *) &on, sizeof(on));
     conn->server = server;
     conn->client_sock = sock;
     sockaddr_to_string(conn->mg_conn.remote_ip,
@@ -1325,6 +1388,11 @@ static struct connection *accept_new_connection(struct mg_server *server) {
 
 static void close_conn(struct connection *conn) {
   DBG(("%p %d %d", conn, conn->flags, conn->endpoint_type));
+  if (conn->endpoint_type == EP_USER && conn->mg_conn.connection_param != NULL) {
+    // Let an unfinished handler release its per-connection state
+    conn->mg_conn.wsbits = 1;
+    conn->endpoint.uh->handler(&conn->mg_conn);
+  }
   LINKED_LIST_REMOVE(&conn->link);
   closesocket(conn->client_sock);
   free(conn->request);            // It's OK to free(NULL), ditto below
@@ -1568,7 +1636,14 @@ static int should_keep_alive(const struct mg_connection *conn) {
 }
 
 int mg_write(struct mg_connection *c, const void *buf, int len) {
-  return spool(&((struct connection *) c)->remote_iobuf, buf, len);
+  struct connection *conn = (struct connection *) c;
+  int n = spool(&conn->remote_iobuf, buf, len);
+  conn_output_queued(conn);
+  return n;
+}
+
+int mg_get_queued_length(const struct mg_connection *c) {
+  return ((const struct connection *) c)->remote_iobuf.len;
 }
 
 void mg_send_status(struct mg_connection *c, int status) {
@@ -3612,6 +3687,157 @@ static void execute_iteration(struct mg_server *server) {
   }
 }
 
+#ifdef USE_EPOLL
+#define EPOLL_MAX_EVENTS 64
+
+// Returns the connection if it must be closed. Connections are only closed
+// after all events of a batch have been processed, because a CGI connection
+// has events for both its client and CGI sockets, and the second event must
+// not use a freed connection
+static struct connection *process_epoll_event(struct mg_server *server,
+                                              struct epoll_event *ev,
+                                              time_t current_time) {
+  struct connection *conn;
+
+  if (ev->data.ptr == &server->ctl[1]) {
+    execute_iteration(server);
+  } else if (ev->data.ptr == &server->listening_sock) {
+    while ((conn = accept_new_connection(server)) != NULL) {
+      conn->birth_time = conn->last_activity_time = current_time;
+      update_epoll(conn);
+    }
+#ifndef NO_CGI
+  } else if ((uintptr_t) ev->data.ptr & 1) {
+    conn = (struct connection *) ((char *) ev->data.ptr - 1);
+    if (conn->flags & CONN_CLOSE) {
+      return conn;  // already closing, from an earlier event in the batch
+    }
+    read_from_cgi(conn);
+    if (conn->flags & CONN_CLOSE) {
+      return conn;
+    }
+    update_epoll(conn);
+#endif
+  } else {
+    conn = (struct connection *) ev->data.ptr;
+    if (conn->flags & CONN_CLOSE) {
+      return conn;
+    }
+    if (ev->events & (EPOLLIN | EPOLLERR | EPOLLHUP)) {
+      conn->last_activity_time = current_time;
+      read_from_client(conn);
+    }
+    if ((ev->events & EPOLLOUT) && !(conn->flags & CONN_BUFFER)) {
+      if (conn->endpoint_type == EP_FILE) {
+        transfer_file_data(conn);
+      }
+      conn->last_activity_time = current_time;
+      write_to_client(conn);
+    }
+    if (conn->flags & CONN_CLOSE) {
+      return conn;
+    }
+    update_epoll(conn);
+  }
+
+  return NULL;
+}
+
+// Idle connections are closed at most once per second, rather than scanning
+// every connection each time the server is polled
+static void expire_connections(struct mg_server *server, time_t current_time) {
+  struct ll *lp, *tmp;
+  struct connection *conn;
+  time_t expire_time = current_time -
+    atoi(server->config_options[IDLE_TIMEOUT_MS]) / 1000;
+
+  if (current_time == server->last_expiry_check) return;
+  server->last_expiry_check = current_time;
+
+  LINKED_LIST_FOREACH(&server->active_connections, lp, tmp) {
+    conn = LINKED_LIST_ENTRY(lp, struct connection, link);
+    if (conn->mg_conn.is_websocket) {
+      ping_idle_websocket_connection(conn, current_time);
+      update_epoll(conn);
+    }
+    if ((conn->flags & CONN_CLOSE) || conn->last_activity_time < expire_time) {
+      close_conn(conn);
+    }
+  }
+}
+
+static time_t poll_server_epoll(struct mg_server *server, int milliseconds) {
+  struct epoll_event events[EPOLL_MAX_EVENTS];
+  struct connection *closing[EPOLL_MAX_EVENTS], *conn;
+  time_t current_time;
+  int i, j, n, num_closing = 0;
+
+  n = epoll_wait(server->epoll_fd, events, EPOLL_MAX_EVENTS, milliseconds);
+  current_time = time(NULL);
+  for (i = 0; i < n; i++) {
+    conn = process_epoll_event(server, &events[i], current_time);
+    if (conn != NULL) {
+      for (j = 0; j < num_closing && closing[j] != conn; j++) {}
+      if (j == num_closing) {
+        closing[num_closing++] = conn;
+      }
+    }
+  }
+  for (j = 0; j < num_closing; j++) {
+    close_conn(closing[j]);
+  }
+  expire_connections(server, current_time);
+
+  return current_time;
+}
+
+unsigned int mg_poll_server(struct mg_server *server, int milliseconds) {
+  if (server->listening_sock == INVALID_SOCKET) return 0;
+  return (unsigned int) poll_server_epoll(server, milliseconds);
+}
+
+unsigned int mg_poll_servers(struct mg_server **servers, int num_servers,
+                             int milliseconds) {
+  struct pollfd stack_fds[16], *fds = stack_fds;
+  time_t current_time = 0;
+  int i, n, num_listening = 0;
+
+  if (num_servers > (int) ARRAY_SIZE(stack_fds) &&
+      (fds = (struct pollfd *) calloc(num_servers, sizeof(*fds))) == NULL) {
+    return 0;
+  }
+
+  // Each server's epoll descriptor becomes readable when it has events
+  for (i = 0; i < num_servers; i++) {
+    fds[i].fd = servers[i]->listening_sock != INVALID_SOCKET ?
+      servers[i]->epoll_fd : -1;
+    fds[i].events = POLLIN;
+    fds[i].revents = 0;
+    if (fds[i].fd >= 0) num_listening++;
+  }
+
+  if (num_listening > 0) {
+    n = poll(fds, num_servers, milliseconds);
+    current_time = time(NULL);
+    for (i = 0; i < num_servers; i++) {
+      if (fds[i].fd < 0) continue;
+      if (n > 0 && (fds[i].revents & POLLIN)) {
+        poll_server_epoll(servers[i], 0);
+      } else {
+        expire_connections(servers[i], current_time);
+      }
+    }
+  }
+
+  if (fds != stack_fds) free(fds);
+
+  return (unsigned int) current_time;
+}
+
+int mg_get_poll_fd(struct mg_server *server) {
+  return server->epoll_fd;
+}
+#else
 void add_to_set(sock_t sock, fd_set *set, sock_t *max_fd) {
   FD_SET(sock, set);
   if (sock > *max_fd) {
@@ -3619,47 +3845,45 @@ void add_to_set(sock_t sock, fd_set *set, sock_t *max_fd) {
   }
 }
 
-unsigned int mg_poll_server(struct mg_server *server, int milliseconds) {
+static void add_server_to_sets(struct mg_server *server, fd_set *read_set,
+                               fd_set *write_set, sock_t *max_fd) {
   struct ll *lp, *tmp;
   struct connection *conn;
-  struct timeval tv;
-  fd_set read_set, write_set;
-  sock_t max_fd = -1;
-  time_t current_time = time(NULL), expire_time = current_time -
-    atoi(server->config_options[IDLE_TIMEOUT_MS]) / 1000;
 
-  if (server->listening_sock == INVALID_SOCKET) return 0;
-
-  FD_ZERO(&read_set);
-  FD_ZERO(&write_set);
-  add_to_set(server->listening_sock, &read_set, &max_fd);
-  add_to_set(server->ctl[1], &read_set, &max_fd);
+  add_to_set(server->listening_sock, read_set, max_fd);
+  add_to_set(server->ctl[1], read_set, max_fd);
 
   LINKED_LIST_FOREACH(&server->active_connections, lp, tmp) {
     conn = LINKED_LIST_ENTRY(lp, struct connection, link);
-    add_to_set(conn->client_sock, &read_set, &max_fd);
+    add_to_set(conn->client_sock, read_set, max_fd);
     if (conn->endpoint_type == EP_FILE) {
       transfer_file_data(conn);
     } else if (conn->endpoint_type == EP_CGI) {
-      add_to_set(conn->endpoint.cgi_sock, &read_set, &max_fd);
+      add_to_set(conn->endpoint.cgi_sock, read_set, max_fd);
     }
     if (conn->remote_iobuf.len > 0 && !(conn->flags & CONN_BUFFER)) {
-      add_to_set(conn->client_sock, &write_set, &max_fd);
+      add_to_set(conn->client_sock, write_set, max_fd);
     } else if (conn->flags & CONN_CLOSE) {
       close_conn(conn);
     }
   }
+}
 
-  tv.tv_sec = milliseconds / 1000;
-  tv.tv_usec = (milliseconds % 1000) * 1000;
+static void process_server_sets(struct mg_server *server, fd_set *read_set,
+                                fd_set *write_set, int ready,
+                                time_t current_time) {
+  struct ll *lp, *tmp;
+  struct connection *conn;
+  time_t expire_time = current_time -
+    atoi(server->config_options[IDLE_TIMEOUT_MS]) / 1000;
 
-  if (select(max_fd + 1, &read_set, &write_set, NULL, &tv) > 0) {
-    if (FD_ISSET(server->ctl[1], &read_set)) {
+  if (ready) {
+    if (FD_ISSET(server->ctl[1], read_set)) {
       execute_iteration(server);
     }
 
     // Accept new connections
-    if (FD_ISSET(server->listening_sock, &read_set)) {
+    if (FD_ISSET(server->listening_sock, read_set)) {
       while ((conn = accept_new_connection(server)) != NULL) {
         conn->birth_time = conn->last_activity_time = current_time;
       }
@@ -3668,17 +3892,17 @@ unsigned int mg_poll_server(struct mg_server *server, int milliseconds) {
     // Read/write from clients
     LINKED_LIST_FOREACH(&server->active_connections, lp, tmp) {
       conn = LINKED_LIST_ENTRY(lp, struct connection, link);
-      if (FD_ISSET(conn->client_sock, &read_set)) {
+      if (FD_ISSET(conn->client_sock, read_set)) {
         conn->last_activity_time = current_time;
         read_from_client(conn);
       }
 #ifndef NO_CGI
       if (conn->endpoint_type == EP_CGI &&
-          FD_ISSET(conn->endpoint.cgi_sock, &read_set)) {
+          FD_ISSET(conn->endpoint.cgi_sock, read_set)) {
         read_from_cgi(conn);
       }
 #endif
-      if (FD_ISSET(conn->client_sock, &write_set) &&
+      if (FD_ISSET(conn->client_sock, write_set) &&
           !(conn->flags & CONN_BUFFER)) {
         conn->last_activity_time = current_time;
         write_to_client(conn);
@@ -3696,10 +3920,53 @@ unsigned int mg_poll_server(struct mg_server *server, int milliseconds) {
       close_conn(conn);
     }
   }
+}
+
+unsigned int mg_poll_server(struct mg_server *server, int milliseconds) {
+  return mg_poll_servers(&server, 1, milliseconds);
+}
+
+unsigned int mg_poll_servers(struct mg_server **servers, int num_servers,
+                             int milliseconds) {
+  struct timeval tv;
+  fd_set read_set, write_set;
+  sock_t max_fd = -1;
+  time_t current_time = time(NULL);
+  int i, ready, num_listening = 0;
+
+  FD_ZERO(&read_set);
+  FD_ZERO(&write_set);
+
+  for (i = 0; i < num_servers; i++) {
+    if (servers[i]->listening_sock != INVALID_SOCKET) {
+      add_server_to_sets(servers[i], &read_set, &write_set, &max_fd);
+      num_listening++;
+    }
+  }
+
+  if (num_listening == 0) return 0;
+
+  tv.tv_sec = milliseconds / 1000;
+  tv.tv_usec = (milliseconds % 1000) * 1000;
+
+  ready = select(max_fd + 1, &read_set, &write_set, NULL, &tv) > 0;
+
+  for (i = 0; i < num_servers; i++) {
+    if (servers[i]->listening_sock != INVALID_SOCKET) {
+      process_server_sets(servers[i], &read_set, &write_set, ready,
+                          current_time);
+    }
+  }
 
   return (unsigned int) current_time;
 }
 
+int mg_get_poll_fd(struct mg_server *server) {
+  (void) server;
+  return -1;
+}
+#endif  // USE_EPOLL
+
 void mg_destroy_server(struct mg_server **server) {
   int i;
   struct ll *lp, *tmp;
@@ -3710,6 +3977,9 @@ void mg_destroy_server(struct mg_server **server) {
     closesocket((*server)->listening_sock);
     closesocket((*server)->ctl[0]);
     closesocket((*server)->ctl[1]);
+#ifdef USE_EPOLL
+    close((*server)->epoll_fd);
+#endif
     LINKED_LIST_FOREACH(&(*server)->active_connections, lp, tmp) {
       free(LINKED_LIST_ENTRY(lp, struct connection, link));
     }
@@ -3937,6 +4207,9 @@ const char *mg_set_option(struct mg_server *server, const char *name,
         error_msg = "Cannot bind to port";
       } else {
         set_non_blocking_mode(server->listening_sock);
+#ifdef USE_EPOLL
+        add_to_epoll(server, server->listening_sock, &server->listening_sock);
+#endif
       }
 #ifndef _WIN32
     } else if (ind == RUN_AS_USER) {
@@ -3977,6 +4250,11 @@ void mg_set_listening_socket(struct mg_server *server, int sock) {
     closesocket(server->listening_sock);
   }
   server->listening_sock = sock;
+#ifdef USE_EPOLL
+  if (sock != INVALID_SOCKET) {
+    add_to_epoll(server, sock, &server->listening_sock);
+  }
+#endif
 }
 
 int mg_get_listening_socket(struct mg_server *server) {
@@ -4010,6 +4288,12 @@ struct mg_server *mg_create_server(void *server_data) {
     mg_socketpair(server->ctl);
   } while (server->ctl[0] == INVALID_SOCKET);
 
+#ifdef USE_EPOLL
+  server->epoll_fd = epoll_create(64);
+  set_close_on_exec(server->epoll_fd);
+  add_to_epoll(server, server->ctl[1], &server->ctl[1]);
+#endif
+
   server->server_data = server_data;
   server->listening_sock = INVALID_SOCKET;
   set_default_option_values(server->config_options);
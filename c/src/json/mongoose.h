@@ -64,6 +64,13 @@ struct mg_server *mg_create_server(void *server_param);
 void mg_destroy_server(struct mg_server **);
 const char *mg_set_option(struct mg_server *, const char *opt, const char *val);
 unsigned int mg_poll_server(struct mg_server *, int milliseconds);
+// Polls several servers with a single select(), so that one thread can serve
+// all of them. Each server must only be polled by one thread.
+unsigned int mg_poll_servers(struct mg_server **, int num_servers,
+                             int milliseconds);
+// Returns a descriptor which becomes readable when the server has events to
+// process (the server's epoll descriptor on Linux), or -1 if there is none.
+int mg_get_poll_fd(struct mg_server *);
 void mg_add_uri_handler(struct mg_server *, const char *uri, mg_handler_t);
 void mg_set_http_error_handler(struct mg_server *, mg_handler_t);
 const char **mg_get_valid_option_names(void);
@@ -80,6 +87,13 @@ void mg_send_header(struct mg_connection *, const char *name, const char *val);
 void mg_send_data(struct mg_connection *, const void *data, int data_len);
 void mg_printf_data(struct mg_connection *, const char *format, ...);
 
+// Number of bytes queued for the client which have not yet been sent. A URI
+// handler which returns 0 is called again after each write to the client, and
+// can use this to limit how much of a long response is buffered. If such a
+// handler sets connection_param, it is also called once with wsbits set to 1
+// if the connection is closed before the handler returns non-zero.
+int mg_get_queued_length(const struct mg_connection *);
+
 int mg_websocket_write(struct mg_connection *, int opcode,
                        const char *data, size_t data_len);
 
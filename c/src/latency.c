@@ -0,0 +1,393 @@
+/**
+ * Rapid-prototyping protection schemes with IEC 61850
+ *
+ * Copyright (c) 2014 Steven Blair
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include "latency.h"
+
+#if LATENCY_STATS_SUPPORTED == 1
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#ifdef __linux__
+#include <sys/socket.h>
+#include <sys/ioctl.h>
+#include <net/if.h>
+#include <linux/if_packet.h>
+#include <linux/sockios.h>
+#include <linux/net_tstamp.h>
+#include <linux/errqueue.h>
+#endif
+
+#define LATENCY_CLOCK_OFFSET_REFRESH	1024	// number of received frames between measurements of CLOCK_REALTIME - CLOCK_MONOTONIC
+
+struct latencyFrame {
+	unsigned long long received;
+	unsigned long long dispatched;
+	unsigned long long decoded;
+	int hasReceiveTimestamp;
+};
+
+struct latencyTxPending {
+	struct latencyStats *stats;
+	const char *name;
+	unsigned long long sent;
+};
+
+static LATENCY_THREAD_LOCAL struct latencyFrame currentFrame;
+static LATENCY_THREAD_LOCAL unsigned int clockOffsetAge = 0;
+static long long clockOffset = 0;			// CLOCK_REALTIME - CLOCK_MONOTONIC, in ns
+
+static struct latencyTxPending txPending[LATENCY_TX_PENDING_SIZE];
+static CTYPE_INT32U txCount = 0;
+
+static struct latencyStats *statsList = NULL;
+
+static const char *stageNames[LATENCY_STAGES] = {"receive", "decode", "callback", "total", "transmit"};
+
+static unsigned long long timespec_to_ns(const struct timespec *ts) {
+	return (unsigned long long) ts->tv_sec * 1000000000ULL + (unsigned long long) ts->tv_nsec;
+}
+
+unsigned long long latency_now() {
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return timespec_to_ns(&ts);
+}
+
+static void latency_update_clock_offset() {
+	struct timespec realtime;
+	struct timespec monotonic;
+
+	clock_gettime(CLOCK_MONOTONIC, &monotonic);
+	clock_gettime(CLOCK_REALTIME, &realtime);
+
+	clockOffset = (long long) (timespec_to_ns(&realtime) - timespec_to_ns(&monotonic));
+}
+
+void latency_init() {
+	latency_update_clock_offset();
+	memset(txPending, 0, sizeof(txPending));
+	txCount = 0;
+}
+
+int latency_enable_socket_timestamps(int fd, const char *interfaceName) {
+#ifdef __linux__
+	int flags = SOF_TIMESTAMPING_RX_SOFTWARE | SOF_TIMESTAMPING_TX_SOFTWARE | SOF_TIMESTAMPING_SOFTWARE | SOF_TIMESTAMPING_OPT_ID | SOF_TIMESTAMPING_OPT_TSONLY;
+	struct hwtstamp_config config;
+	struct ifreq ifr;
+
+	// hardware timestamps must also be enabled in the network interface driver
+	if (interfaceName != NULL) {
+		memset(&config, 0, sizeof(config));
+		memset(&ifr, 0, sizeof(ifr));
+		config.tx_type = HWTSTAMP_TX_ON;
+		config.rx_filter = HWTSTAMP_FILTER_ALL;
+		strncpy(ifr.ifr_name, interfaceName, IFNAMSIZ - 1);
+		ifr.ifr_data = (char *) &config;
+
+		if (ioctl(fd, SIOCSHWTSTAMP, &ifr) == 0) {
+			int hardwareFlags = flags | SOF_TIMESTAMPING_RX_HARDWARE | SOF_TIMESTAMPING_TX_HARDWARE | SOF_TIMESTAMPING_RAW_HARDWARE;
+
+			if (setsockopt(fd, SOL_SOCKET, SO_TIMESTAMPING, &hardwareFlags, sizeof(hardwareFlags)) == 0) {
+				return 2;
+			}
+		}
+	}
+
+	// fall back to software timestamps, which are always available on Linux
+	if (setsockopt(fd, SOL_SOCKET, SO_TIMESTAMPING, &flags, sizeof(flags)) == 0) {
+		return 1;
+	}
+#endif
+
+	return 0;
+}
+
+static int latency_bucket(unsigned long long ns) {
+	int msb = 0;
+
+	if (ns < LATENCY_SUB_BUCKETS) {
+		return (int) ns;
+	}
+
+#if defined(__GNUC__)
+	msb = 63 - __builtin_clzll(ns);
+#else
+	{
+		unsigned long long v = ns;
+		while (v >>= 1) {
+			msb++;
+		}
+	}
+#endif
+
+	if (msb > LATENCY_MAX_MSB) {
+		return LATENCY_HISTOGRAM_BUCKETS - 1;
+	}
+
+	return ((msb - LATENCY_SUB_BUCKET_BITS + 1) << LATENCY_SUB_BUCKET_BITS) | (int) ((ns >> (msb - LATENCY_SUB_BUCKET_BITS)) & (LATENCY_SUB_BUCKETS - 1));
+}
+
+// returns the largest value which is stored in the specified bucket
+static unsigned long long latency_bucket_upper_bound(int bucket) {
+	int group = bucket >> LATENCY_SUB_BUCKET_BITS;
+	int sub = bucket & (LATENCY_SUB_BUCKETS - 1);
+	int shift = 0;
+
+	if (group == 0) {
+		return (unsigned long long) bucket;
+	}
+
+	shift = group - 1;
+	return (((unsigned long long) (LATENCY_SUB_BUCKETS + sub + 1)) << shift) - 1;
+}
+
+static void latency_register(struct latencyStats *stats, const char *name) {
+	if (stats->name == NULL) {
+		stats->name = name;
+#if defined(__GNUC__)
+		// stats may be registered concurrently by receive worker threads (see packet_ring_start_workers())
+		do {
+			stats->next = statsList;
+		} while (!__sync_bool_compare_and_swap(&statsList, stats->next, stats));
+#else
+		stats->next = statsList;
+		statsList = stats;
+#endif
+	}
+}
+
+void latency_record(struct latencyStats *stats, const char *name, enum latencyStage stage, unsigned long long ns) {
+	struct latencyHistogram *h = &stats->stage[stage];
+
+	latency_register(stats, name);
+
+	if (h->count == 0 || ns < h->min) {
+		h->min = ns;
+	}
+	if (ns > h->max) {
+		h->max = ns;
+	}
+	h->sum += ns;
+	h->count++;
+	h->buckets[latency_bucket(ns)]++;
+}
+
+void latency_frame_received_ns(unsigned long long realtimeNs) {
+	if (clockOffsetAge++ % LATENCY_CLOCK_OFFSET_REFRESH == 0) {
+		latency_update_clock_offset();
+	}
+
+	currentFrame.received = realtimeNs - clockOffset;
+	currentFrame.hasReceiveTimestamp = 1;
+}
+
+void latency_frame_received(const struct timeval *kernelTimestamp) {
+	if (kernelTimestamp == NULL) {
+		currentFrame.received = latency_now();
+	}
+	else {
+		latency_frame_received_ns((unsigned long long) kernelTimestamp->tv_sec * 1000000000ULL + (unsigned long long) kernelTimestamp->tv_usec * 1000ULL);
+	}
+	currentFrame.hasReceiveTimestamp = 1;
+}
+
+void latency_frame_dispatched() {
+	currentFrame.dispatched = latency_now();
+
+	// frames which were not passed through latency_frame_received() are timed from here
+	if (!currentFrame.hasReceiveTimestamp || currentFrame.received > currentFrame.dispatched) {
+		currentFrame.received = currentFrame.dispatched;
+	}
+	currentFrame.hasReceiveTimestamp = 0;
+}
+
+void latency_frame_decoded() {
+	currentFrame.decoded = latency_now();
+}
+
+void latency_frame_done(struct latencyStats *stats, const char *name) {
+	unsigned long long done = latency_now();
+
+	latency_record(stats, name, LATENCY_STAGE_RECEIVE, currentFrame.dispatched - currentFrame.received);
+	latency_record(stats, name, LATENCY_STAGE_DECODE, currentFrame.decoded - currentFrame.dispatched);
+	latency_record(stats, name, LATENCY_STAGE_CALLBACK, done - currentFrame.decoded);
+	latency_record(stats, name, LATENCY_STAGE_TOTAL, done - currentFrame.received);
+}
+
+void latency_transmit_start(struct latencyStats *stats, const char *name) {
+	struct latencyTxPending *pending = &txPending[txCount & (LATENCY_TX_PENDING_SIZE - 1)];
+
+	pending->stats = stats;
+	pending->name = name;
+	pending->sent = latency_now();
+	txCount++;
+}
+
+int latency_transmit_poll(int fd) {
+	int messages = 0;
+#ifdef __linux__
+	unsigned char control[256];
+	struct msghdr msg;
+	struct cmsghdr *cmsg;
+	struct timespec *ts = NULL;
+	struct sock_extended_err *serr = NULL;
+
+	while (1) {
+		memset(&msg, 0, sizeof(msg));
+		msg.msg_control = control;
+		msg.msg_controllen = sizeof(control);
+
+		if (recvmsg(fd, &msg, MSG_ERRQUEUE | MSG_DONTWAIT) < 0) {
+			break;
+		}
+		messages++;
+
+		ts = NULL;
+		serr = NULL;
+		for (cmsg = CMSG_FIRSTHDR(&msg); cmsg != NULL; cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+			if (cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SO_TIMESTAMPING) {
+				ts = (struct timespec *) CMSG_DATA(cmsg);
+			}
+			else if (cmsg->cmsg_level == SOL_PACKET && cmsg->cmsg_type == PACKET_TX_TIMESTAMP) {
+				serr = (struct sock_extended_err *) CMSG_DATA(cmsg);
+			}
+		}
+
+		if (ts != NULL && serr != NULL && serr->ee_origin == SO_EE_ORIGIN_TIMESTAMPING) {
+			struct latencyTxPending *pending = &txPending[serr->ee_data & (LATENCY_TX_PENDING_SIZE - 1)];
+			struct timespec *stamp = (ts[2].tv_sec != 0 || ts[2].tv_nsec != 0) ? &ts[2] : &ts[0];	// prefer raw hardware timestamp
+			unsigned long long left = timespec_to_ns(stamp) - clockOffset;
+
+			if (pending->stats != NULL && left >= pending->sent) {
+				latency_record(pending->stats, pending->name, LATENCY_STAGE_TRANSMIT, left - pending->sent);
+				pending->stats = NULL;
+			}
+		}
+	}
+#endif
+
+	return messages;
+}
+
+unsigned long long latency_percentile(struct latencyHistogram *h, double percentile) {
+	unsigned long long target = 0;
+	unsigned long long cumulative = 0;
+	unsigned long long value = 0;
+	int i = 0;
+
+	if (h->count == 0) {
+		return 0;
+	}
+
+	target = (unsigned long long) ((percentile / 100.0) * (double) h->count + 0.5);
+	if (target < 1) {
+		target = 1;
+	}
+
+	for (i = 0; i < LATENCY_HISTOGRAM_BUCKETS; i++) {
+		cumulative += h->buckets[i];
+		if (cumulative >= target) {
+			value = latency_bucket_upper_bound(i);
+			break;
+		}
+	}
+
+	// the bucket bound may be outside the observed range
+	if (value > h->max) {
+		value = h->max;
+	}
+	if (value < h->min) {
+		value = h->min;
+	}
+
+	return value;
+}
+
+struct latencyStats *latency_get_stats() {
+	return statsList;
+}
+
+void latency_reset() {
+	struct latencyStats *stats = statsList;
+
+	while (stats != NULL) {
+		memset(stats->stage, 0, sizeof(stats->stage));
+		stats = stats->next;
+	}
+}
+
+int latencyStatsToJSON(char *buf, int maxLength) {
+	struct latencyStats *stats = statsList;
+	int len = 0;
+	int i = 0;
+
+	len += snprintf(&buf[len], maxLength - len, "{\"latency\":[");
+	if (len >= maxLength) {
+		return -1;
+	}
+
+	while (stats != NULL) {
+		len += snprintf(&buf[len], maxLength - len, "{\"name\":\"%s\"", stats->name);
+		if (len >= maxLength) {
+			return -1;
+		}
+
+		for (i = 0; i < LATENCY_STAGES; i++) {
+			struct latencyHistogram *h = &stats->stage[i];
+
+			if (h->count == 0) {
+				continue;
+			}
+
+			len += snprintf(&buf[len], maxLength - len, ",\"%s\":{\"count\":%u,\"min\":%llu,\"mean\":%llu,\"p50\":%llu,\"p90\":%llu,\"p99\":%llu,\"p99.9\":%llu,\"max\":%llu}",
+				stageNames[i],
+				h->count,
+				h->min,
+				h->sum / h->count,
+				latency_percentile(h, 50.0),
+				latency_percentile(h, 90.0),
+				latency_percentile(h, 99.0),
+				latency_percentile(h, 99.9),
+				h->max);
+
+			if (len >= maxLength) {
+				return -1;
+			}
+		}
+
+		len += snprintf(&buf[len], maxLength - len, "}%s", (stats->next != NULL) ? "," : "");
+		if (len >= maxLength) {
+			return -1;
+		}
+
+		stats = stats->next;
+	}
+
+	len += snprintf(&buf[len], maxLength - len, "]}");
+	if (len >= maxLength) {
+		return -1;
+	}
+
+	return len;
+}
+
+#endif
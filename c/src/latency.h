@@ -0,0 +1,144 @@
+/**
+ * Rapid-prototyping protection schemes with IEC 61850
+ *
+ * Copyright (c) 2014 Steven Blair
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef LATENCY_H
+#define LATENCY_H
+
+#ifdef __cplusplus /* If this is a C++ compiler, use C linkage */
+extern "C" {
+#endif
+
+#include "ctypes.h"
+
+#if LATENCY_STATS_SUPPORTED == 1
+
+#include <sys/time.h>
+
+#define LATENCY_SUB_BUCKET_BITS		3		// each power-of-two range is split into 8 buckets, giving 12.5% resolution
+#define LATENCY_SUB_BUCKETS			(1 << LATENCY_SUB_BUCKET_BITS)
+#define LATENCY_MAX_MSB				47		// values above 2^48 ns (about 78 hours) are stored in the last bucket
+#define LATENCY_HISTOGRAM_BUCKETS	((LATENCY_MAX_MSB - LATENCY_SUB_BUCKET_BITS + 2) * LATENCY_SUB_BUCKETS)
+#define LATENCY_TX_PENDING_SIZE		64		// must be a power of two
+
+#ifdef _MSC_VER
+#define LATENCY_THREAD_LOCAL		__declspec(thread)
+#else
+#define LATENCY_THREAD_LOCAL		__thread
+#endif
+
+enum latencyStage {
+	LATENCY_STAGE_RECEIVE = 0,		// NIC (kernel or hardware timestamp) to gse_sv_packet_filter()
+	LATENCY_STAGE_DECODE,			// gse_sv_packet_filter() to dataset decoded
+	LATENCY_STAGE_CALLBACK,			// dataset decoded to datasetDecodeDone() returned
+	LATENCY_STAGE_TOTAL,			// NIC to datasetDecodeDone() returned
+	LATENCY_STAGE_TRANSMIT,			// send() called to frame leaving (kernel or hardware transmit timestamp)
+	LATENCY_STAGES
+};
+
+struct latencyHistogram {
+	CTYPE_INT32U count;
+	unsigned long long min;
+	unsigned long long max;
+	unsigned long long sum;
+	CTYPE_INT32U buckets[LATENCY_HISTOGRAM_BUCKETS];
+};
+
+struct latencyStats {
+	const char *name;								// path of the control block, or subscription, in the data model
+	struct latencyHistogram stage[LATENCY_STAGES];
+	struct latencyStats *next;						// list of all stats which have recorded at least one value
+};
+
+/**
+ * Records the reference time for subsequent calls to latency_now(). Must be called before any other latency function.
+ */
+void latency_init();
+
+/**
+ * Returns the present CLOCK_MONOTONIC time in nanoseconds.
+ */
+unsigned long long latency_now();
+
+/**
+ * Enables SO_TIMESTAMPING on a socket. Hardware timestamps are used if interfaceName is not NULL and the driver supports
+ * them, otherwise software timestamps are used. Returns 2 for hardware timestamps, 1 for software timestamps, or 0 if
+ * kernel timestamps are not available. Hardware timestamps are only comparable if the PHC is synchronised to the
+ * system clock (e.g., with phc2sys).
+ */
+int latency_enable_socket_timestamps(int fd, const char *interfaceName);
+
+/**
+ * Pipeline stage stamps for the frame presently being processed by the calling thread. kernelTimestamp is the
+ * CLOCK_REALTIME receive time from the kernel (e.g., from pcap_pkthdr or SCM_TIMESTAMPING), or NULL if not available.
+ */
+void latency_frame_received(const struct timeval *kernelTimestamp);
+void latency_frame_received_ns(unsigned long long realtimeNs);
+void latency_frame_dispatched();
+void latency_frame_decoded();
+void latency_frame_done(struct latencyStats *stats, const char *name);
+
+/**
+ * Transmit stamps. latency_transmit_start() must be called immediately before every send() on the socket fd, so that
+ * transmit timestamps returned by the kernel can be matched to the control block which sent the frame.
+ * latency_transmit_poll() reads the timestamps waiting on the socket's error queue, and returns how many were read.
+ * While any are waiting, poll() reports POLLERR for the socket (and libpcap reads fail), so receive loops on the same
+ * socket must also call it, with LATENCY_TRANSMIT_DRAIN(), because hardware timestamps arrive after send() returns.
+ */
+void latency_transmit_start(struct latencyStats *stats, const char *name);
+int latency_transmit_poll(int fd);
+
+void latency_record(struct latencyStats *stats, const char *name, enum latencyStage stage, unsigned long long ns);
+unsigned long long latency_percentile(struct latencyHistogram *h, double percentile);
+struct latencyStats *latency_get_stats();
+void latency_reset();
+
+/**
+ * Prints the percentiles of all registered stats, in nanoseconds, as JSON. Returns the number of characters printed,
+ * or -1 if maxLength is not large enough.
+ */
+int latencyStatsToJSON(char *buf, int maxLength);
+
+#define LATENCY_FRAME_RECEIVED(ts)					latency_frame_received(ts)
+#define LATENCY_FRAME_RECEIVED_NS(ns)				latency_frame_received_ns(ns)
+#define LATENCY_FRAME_DISPATCHED()					latency_frame_dispatched()
+#define LATENCY_FRAME_DECODED()						latency_frame_decoded()
+#define LATENCY_FRAME_DONE(stats, name)				latency_frame_done(stats, name)
+#define LATENCY_TRANSMIT_START(stats, name)			latency_transmit_start(stats, name)
+#define LATENCY_TRANSMIT_POLL(fd)					latency_transmit_poll(fd)
+#define LATENCY_TRANSMIT_DRAIN(fd)					latency_transmit_poll(fd)
+
+#else
+
+#define LATENCY_FRAME_RECEIVED(ts)
+#define LATENCY_FRAME_RECEIVED_NS(ns)
+#define LATENCY_FRAME_DISPATCHED()
+#define LATENCY_FRAME_DECODED()
+#define LATENCY_FRAME_DONE(stats, name)
+#define LATENCY_TRANSMIT_START(stats, name)
+#define LATENCY_TRANSMIT_POLL(fd)
+#define LATENCY_TRANSMIT_DRAIN(fd)					0
+
+#endif
+
+#ifdef __cplusplus /* If this is a C++ compiler, end C linkage */
+}
+#endif
+
+#endif
@@ -26,6 +26,7 @@
 	#include <pcap.h>
 #endif
 #include "iec61850.h"
+#include "netBackend.h"
 #if HIGH_LEVEL_INTERFACE == 1
 #include "interface.h"
 #endif
@@ -36,7 +37,6 @@
 
 #define BUFFER_LENGTH	2048
 
-pcap_t *fp;
 char errbuf[PCAP_ERRBUF_SIZE];
 unsigned char buf[BUFFER_LENGTH] = {0};
 int len = 0;
@@ -45,8 +45,7 @@ void packet_handler(u_char *param, const struct pcap_pkthdr *header, const u_cha
 	gse_sv_packet_filter((unsigned char *) pkt_data, header->len);
 }
 
-pcap_t *initWinpcap() {
-	pcap_t *fpl;
+const char *initWinpcap() {
     pcap_if_t *alldevs;
     pcap_if_t *used_if;
 
@@ -72,20 +71,14 @@ pcap_t *initWinpcap() {
 #endif
     fflush(stdout);
 
-	if ((fpl = pcap_open_live(used_if->name,	// name of the device
-							 65536,				// portion of the packet to capture. It doesn't matter in this case
-							 1,					// promiscuous mode (nonzero means promiscuous)
-							 1000,				// read timeout
-							 errbuf				// error buffer
-							 )) == NULL)
-	{
-		fprintf(stderr, "\nUnable to open the adapter. %s is not supported by WinPcap\n", alldevs->name);
+	if (netBackendPcap.open(&netBackendPcap, used_if->name) != 0) {
 		exit(2);
 	}
+	netBackend = &netBackendPcap;
 
     //pcap_freealldevs(alldevs);
 
-	return fpl;
+	return used_if->name;
 }
 #endif
 
@@ -100,7 +93,7 @@ int main() {
     int len = 0;
 
 	initialise_iec61850();
-	fp = initWinpcap();
+	initWinpcap();
 
 	srand(time(NULL));
 	float valueGSE = (float) rand() / (float) RAND_MAX;
@@ -109,7 +102,7 @@ int main() {
 	// test GOOSE
 	E1Q1SB1.S1.C1.TVTRa_1.Vol.instMag.f = valueGSE;
 	len = E1Q1SB1.S1.C1.LN0.ItlPositions.send(buf, 0, 512);
-	pcap_sendpacket(fp, buf, len);
+	net_backend_send(netBackend, buf, len);
 
 	gse_sv_packet_filter(buf, len);
 	printf("GSE test: %s\n", D1Q1SB4.S1.C1.RSYNa_1.gse_inputs_ItlPositions.E1Q1SB1_C1_Positions.C1_TVTR_1_Vol_instMag.f == valueGSE ? "passed" : "failed");
@@ -159,7 +152,7 @@ int main() {
 		len = E1Q1SB1.S1.C1.LN0.rmxuCB.update(buf);
 
 		if (len > 0) {
-			pcap_sendpacket(fp, buf, len);
+			net_backend_send(netBackend, buf, len);
 			gse_sv_packet_filter(buf, len);
 
 			printf("SV test: %s\n", D1Q1SB4.S1.C1.exampleMMXU_1.sv_inputs_rmxuCB.E1Q1SB1_C1_rmxu[15].C1_RMXU_1_AmpLocPhsA.instMag.f == valueSV ? "passed" : "failed");
@@ -167,7 +160,7 @@ int main() {
 		}
 	}
 
-	pcap_close(fp);
+	netBackend->close(netBackend);
 
 	return 0;
 #endif
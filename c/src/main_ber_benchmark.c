@@ -0,0 +1,153 @@
+/**
+ * Rapid-prototyping protection schemes with IEC 61850
+ *
+ * Copyright (c) 2014 Steven Blair
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+// Microbenchmark of the generic BER integer functions in ctypes.c against the width-specialised versions in
+// berInteger.h. Each test encodes (length and content) and decodes a set of pseudo-random values which cover all
+// encoded lengths, checks that the values survive the round trip, and prints the mean time per value.
+
+#include "ctypes.h"
+#include "berInteger.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define BENCHMARK_VALUES		4096
+#define BENCHMARK_ITERATIONS	2000
+
+unsigned char benchmarkBuf[BENCHMARK_VALUES * 10];
+unsigned long long benchmarkValues[BENCHMARK_VALUES];
+volatile unsigned long long benchmarkSink = 0;		// prevents the compiler from removing the decode loops
+
+double benchmark_now() {
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (double) ts.tv_sec * 1e9 + (double) ts.tv_nsec;
+}
+
+// random values with a uniformly distributed number of significant bits, so that every encoded length is tested
+void benchmark_init_values(int bits) {
+	int i = 0;
+
+	for (i = 0; i < BENCHMARK_VALUES; i++) {
+		int significantBits = rand() % bits + 1;
+		unsigned long long value = ((unsigned long long) rand() << 40) ^ ((unsigned long long) rand() << 20) ^ (unsigned long long) rand();
+
+		benchmarkValues[i] = (significantBits >= 64) ? value : (value & ((1ULL << significantBits) - 1));
+		if (rand() & 1) {
+			benchmarkValues[i] = ~benchmarkValues[i];	// negative, for signed types
+		}
+	}
+}
+
+void benchmark_report(const char *type, double genericNs, double specialisedNs, int errors) {
+	printf("%-8s generic: %7.2f ns, specialised: %7.2f ns, speed-up: %5.2fx%s\n",
+		type,
+		genericNs,
+		specialisedNs,
+		genericNs / specialisedNs,
+		errors ? ", ROUND-TRIP ERRORS" : "");
+}
+
+#define BENCHMARK_TYPE(name, ctype, width, suffix)																		\
+void benchmark_##suffix() {																								\
+	double start = 0.0;																									\
+	double genericNs = 0.0;																								\
+	double specialisedNs = 0.0;																							\
+	int errors = 0;																										\
+	int i = 0;																											\
+	int n = 0;																											\
+	int offset = 0;																										\
+	ctype value;																										\
+	ctype decoded;																										\
+																														\
+	benchmark_init_values(width);																						\
+																														\
+	start = benchmark_now();																							\
+	for (n = 0; n < BENCHMARK_ITERATIONS; n++) {																		\
+		offset = 0;																										\
+		for (i = 0; i < BENCHMARK_VALUES; i++) {																		\
+			value = (ctype) benchmarkValues[i];																			\
+			benchmarkBuf[offset] = ber_integer_length(&value, sizeof(ctype));											\
+			ber_encode_integer(&benchmarkBuf[offset + 1], &value, sizeof(ctype));										\
+			offset += benchmarkBuf[offset] + 1;																			\
+		}																												\
+		offset = 0;																										\
+		for (i = 0; i < BENCHMARK_VALUES; i++) {																		\
+			ber_decode_integer(&benchmarkBuf[offset + 1], benchmarkBuf[offset], &decoded, sizeof(ctype));				\
+			benchmarkSink += (unsigned long long) decoded;																\
+			offset += benchmarkBuf[offset] + 1;																			\
+		}																												\
+	}																													\
+	genericNs = (benchmark_now() - start) / ((double) BENCHMARK_ITERATIONS * BENCHMARK_VALUES);						\
+																														\
+	start = benchmark_now();																							\
+	for (n = 0; n < BENCHMARK_ITERATIONS; n++) {																		\
+		offset = 0;																										\
+		for (i = 0; i < BENCHMARK_VALUES; i++) {																		\
+			benchmarkBuf[offset] = ber_encode_integer_##suffix(&benchmarkBuf[offset + 1], (ctype) benchmarkValues[i]);	\
+			offset += benchmarkBuf[offset] + 1;																			\
+		}																												\
+		offset = 0;																										\
+		for (i = 0; i < BENCHMARK_VALUES; i++) {																		\
+			decoded = ber_decode_integer_##suffix(&benchmarkBuf[offset + 1], benchmarkBuf[offset]);					\
+			benchmarkSink += (unsigned long long) decoded;																\
+			offset += benchmarkBuf[offset] + 1;																			\
+		}																												\
+	}																													\
+	specialisedNs = (benchmark_now() - start) / ((double) BENCHMARK_ITERATIONS * BENCHMARK_VALUES);					\
+																														\
+	offset = 0;																											\
+	for (i = 0; i < BENCHMARK_VALUES; i++) {																			\
+		decoded = ber_decode_integer_##suffix(&benchmarkBuf[offset + 1], benchmarkBuf[offset]);						\
+		if (decoded != (ctype) benchmarkValues[i] || benchmarkBuf[offset] != ber_integer_length_##suffix(decoded)) {	\
+			errors++;																									\
+		}																												\
+		offset += benchmarkBuf[offset] + 1;																				\
+	}																													\
+																														\
+	benchmark_report(name, genericNs, specialisedNs, errors);															\
+}
+
+BENCHMARK_TYPE("INT8", signed char, 8, int8)
+BENCHMARK_TYPE("INT16", CTYPE_INT16, 16, int16)
+BENCHMARK_TYPE("INT32", CTYPE_INT32, 32, int32)
+BENCHMARK_TYPE("INT64", long long, 64, int64)
+BENCHMARK_TYPE("INT8U", CTYPE_INT8U, 8, int8u)
+BENCHMARK_TYPE("INT16U", CTYPE_INT16U, 16, int16u)
+BENCHMARK_TYPE("INT32U", CTYPE_INT32U, 32, int32u)
+BENCHMARK_TYPE("INT64U", unsigned long long, 64, int64u)
+
+int main() {
+	srand(61850);
+
+	printf("mean time to encode and decode one value (%d values, %d iterations)\n", BENCHMARK_VALUES, BENCHMARK_ITERATIONS);
+
+	benchmark_int8();
+	benchmark_int16();
+	benchmark_int32();
+	benchmark_int64();
+	benchmark_int8u();
+	benchmark_int16u();
+	benchmark_int32u();
+	benchmark_int64u();
+
+	return 0;
+}
@@ -0,0 +1,108 @@
+/**
+ * Rapid-prototyping protection schemes with IEC 61850
+ *
+ * Copyright (c) 2014 Steven Blair
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+// Benchmark of whole-frame encoding and decoding, using the control blocks of the example SCD file. Only the public
+// library API is used, so the same program can be built against older versions of the library for comparison.
+
+#include "iec61850.h"
+#include <stdio.h>
+#include <time.h>
+
+#define BENCHMARK_FRAMES		200000
+#define BENCHMARK_MAX_FRAME		1600
+
+unsigned char frameBuf[BENCHMARK_MAX_FRAME];
+
+double benchmark_now() {
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (double) ts.tv_sec * 1e9 + (double) ts.tv_nsec;
+}
+
+void benchmark_gse(const char *name, struct gseControl *gseControl) {
+	double start = 0.0;
+	double encodeNs = 0.0;
+	double decodeNs = 0.0;
+	int len = 0;
+	int i = 0;
+
+	start = benchmark_now();
+	for (i = 0; i < BENCHMARK_FRAMES; i++) {
+		E1Q1SB1.S1.C1.MMXUa_1.Amps.int1 = i;
+		len = gseControl->send(frameBuf, (i & 0xFF) == 0, 1000);
+	}
+	encodeNs = (benchmark_now() - start) / BENCHMARK_FRAMES;
+
+	start = benchmark_now();
+	for (i = 0; i < BENCHMARK_FRAMES; i++) {
+		gse_sv_packet_filter(frameBuf, len);
+	}
+	decodeNs = (benchmark_now() - start) / BENCHMARK_FRAMES;
+
+	printf("GSE %-18s %4d bytes, encode: %7.1f ns, decode: %7.1f ns\n", name, len, encodeNs, decodeNs);
+}
+
+void benchmark_sv(const char *name, struct svControl *svControl) {
+	double start = 0.0;
+	double encodeNs = 0.0;
+	double decodeNs = 0.0;
+	int len = 0;
+	int frames = 0;
+	int i = 0;
+
+	// update() is called once per sample, and returns a frame every noASDU samples
+	start = benchmark_now();
+	for (i = 0; i < BENCHMARK_FRAMES * svControl->noASDU; i++) {
+		E1Q1SB1.S1.C1.exampleRMXU_1.AmpLocPhsA.instMag.f = (float) i;
+		if (svControl->update(frameBuf) > 0) {
+			frames++;
+		}
+	}
+	encodeNs = (benchmark_now() - start) / frames;
+
+	len = 0;
+	while (len <= 0) {
+		len = svControl->update(frameBuf);
+	}
+
+	start = benchmark_now();
+	for (i = 0; i < BENCHMARK_FRAMES; i++) {
+		gse_sv_packet_filter(frameBuf, len);
+	}
+	decodeNs = (benchmark_now() - start) / BENCHMARK_FRAMES;
+
+	printf("SV  %-18s %4d bytes, encode: %7.1f ns, decode: %7.1f ns (%d ASDUs per frame)\n", name, len, encodeNs, decodeNs, svControl->noASDU);
+}
+
+int main() {
+	initialise_iec61850();
+
+	printf("mean time per frame (%d frames)\n", BENCHMARK_FRAMES);
+
+	benchmark_gse("Performance", &E1Q1SB1.S1.C1.LN0.Performance);
+	benchmark_gse("ItlPositions", &E1Q1SB1.S1.C1.LN0.ItlPositions);
+	benchmark_gse("AnotherPositions", &E1Q1SB1.S1.C1.LN0.AnotherPositions);
+	benchmark_sv("PerformanceSV", &E1Q1SB1.S1.C1.LN0.PerformanceSV);
+	benchmark_sv("Volt", &E1Q1SB1.S1.C1.LN0.Volt);
+	benchmark_sv("rmxuCB", &E1Q1SB1.S1.C1.LN0.rmxuCB);
+
+	return 0;
+}
@@ -0,0 +1,232 @@
+/**
+ * Rapid-prototyping protection schemes with IEC 61850
+ *
+ * Copyright (c) 2014 Steven Blair
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+// Benchmark of JSON serialisation of the data model. The values of all leaf items of E1Q1SB1 are set to pseudo-random
+// values of realistic magnitude, then:
+//  1. each leaf value is formatted with the sprintf()-based code which itemToJSON() used previously, and with
+//     itemToJSON() itself, and
+//  2. the whole IED is printed with itemTreeToJSON(), as for an HTTP GET of the IED.
+// The second test only uses the public API, so the same program can be built against older versions of the library for
+// comparison.
+
+#include "iec61850.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+
+#if JSON_INTERFACE == 1
+#include "json\json.h"
+
+#define BENCHMARK_MAX_LEAVES		20000
+#define BENCHMARK_VALUE_ITERATIONS	200
+#define BENCHMARK_TREE_ITERATIONS	2000
+
+Item *leaves[BENCHMARK_MAX_LEAVES];
+int numberOfLeaves = 0;
+char printBuf[ACSI_RESPONSE_MAX_SIZE];
+volatile int benchmarkSink = 0;		// prevents the compiler from removing the formatting loops
+
+double benchmark_now() {
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (double) ts.tv_sec * 1e9 + (double) ts.tv_nsec;
+}
+
+double benchmark_random() {
+	return (double) rand() / (double) RAND_MAX;
+}
+
+// sets a leaf to a random value, with a random number of significant digits or bits
+void benchmark_set_value(Item *item) {
+	double magnitude = pow(10.0, rand() % 8 - 2) * benchmark_random();
+	unsigned long long bits = ((unsigned long long) rand() << 40) ^ ((unsigned long long) rand() << 20) ^ (unsigned long long) rand();
+
+	bits >>= rand() % 64;
+
+	switch (item->type) {
+		case BASIC_TYPE_BOOLEAN:
+			*(CTYPE_BOOLEAN *) item->data = (CTYPE_BOOLEAN) (rand() & 1);
+			break;
+		case BASIC_TYPE_INT8:
+			*(CTYPE_INT8 *) item->data = (CTYPE_INT8) bits;
+			break;
+		case BASIC_TYPE_INT16:
+			*(CTYPE_INT16 *) item->data = (CTYPE_INT16) bits;
+			break;
+		case BASIC_TYPE_INT32:
+			*(CTYPE_INT32 *) item->data = (CTYPE_INT32) bits;
+			break;
+		case BASIC_TYPE_INT64:
+			*(CTYPE_INT64 *) item->data = (CTYPE_INT64) bits;
+			break;
+		case BASIC_TYPE_INT8U:
+			*(CTYPE_INT8U *) item->data = (CTYPE_INT8U) bits;
+			break;
+		case BASIC_TYPE_INT16U:
+			*(CTYPE_INT16U *) item->data = (CTYPE_INT16U) bits;
+			break;
+		case BASIC_TYPE_INT24U:
+			*(CTYPE_INT24U *) item->data = (CTYPE_INT24U) (bits & 0xFFFFFF);
+			break;
+		case BASIC_TYPE_INT32U:
+			*(CTYPE_INT32U *) item->data = (CTYPE_INT32U) bits;
+			break;
+		case BASIC_TYPE_FLOAT32:
+			*(CTYPE_FLOAT32 *) item->data = (CTYPE_FLOAT32) ((rand() & 1) ? magnitude : -magnitude);
+			break;
+		case BASIC_TYPE_FLOAT64:
+			*(CTYPE_FLOAT64 *) item->data = (rand() & 1) ? magnitude : -magnitude;
+			break;
+		case BASIC_TYPE_ENUMERATED:
+		case BASIC_TYPE_CODED_ENUM:
+			*(CTYPE_ENUM *) item->data = (CTYPE_ENUM) (rand() % 8);
+			break;
+		default:
+			break;
+	}
+}
+
+void benchmark_find_leaves(Item *item) {
+	int i = 0;
+
+	if (item->type != BASIC_TYPE_CONSTRUCTED) {
+		if (numberOfLeaves < BENCHMARK_MAX_LEAVES && item->data != NULL) {
+			benchmark_set_value(item);
+			leaves[numberOfLeaves++] = item;
+		}
+		return;
+	}
+
+	for (i = 0; i < item->numberOfItems; i++) {
+		benchmark_find_leaves(&item->items[i]);
+	}
+}
+
+// the previous implementation of itemToJSON(), for numeric and boolean values
+int benchmark_sprintf_value(char *buf, Item *item) {
+	void *data = item->data;
+
+	switch (item->type) {
+		case BASIC_TYPE_BOOLEAN:
+			return sprintf(buf, *(CTYPE_BOOLEAN *) data == FALSE ? "false" : "true");
+		case BASIC_TYPE_INT8:
+			return sprintf(buf, "%d", *((CTYPE_INT8 *) data));
+		case BASIC_TYPE_INT16:
+			return sprintf(buf, "%hd", *((CTYPE_INT16 *) data));
+		case BASIC_TYPE_INT32:
+			return sprintf(buf, "%d", *((CTYPE_INT32 *) data));
+		case BASIC_TYPE_INT64:
+			return sprintf(buf, "%ld", *((CTYPE_INT64 *) data));
+		case BASIC_TYPE_INT8U:
+			return sprintf(buf, "%u", *((CTYPE_INT8U *) data));
+		case BASIC_TYPE_INT16U:
+			return sprintf(buf, "%hu", *((CTYPE_INT16U *) data));
+		case BASIC_TYPE_INT24U:
+			return sprintf(buf, "%u", *((CTYPE_INT24U *) data));
+		case BASIC_TYPE_INT32U:
+			return sprintf(buf, "%u", *((CTYPE_INT32U *) data));
+		case BASIC_TYPE_FLOAT32:
+			return sprintf(buf, "%f", *((CTYPE_FLOAT32 *) data));
+		case BASIC_TYPE_FLOAT64:
+			return sprintf(buf, "%lf", *((CTYPE_FLOAT64 *) data));
+		case BASIC_TYPE_ENUMERATED:
+		case BASIC_TYPE_CODED_ENUM:
+			return sprintf(buf, "%u", *((CTYPE_ENUM *) data));
+		default:
+			return itemToJSON(buf, item);
+	}
+}
+
+void benchmark_values() {
+	double start = 0.0;
+	double sprintfNs = 0.0;
+	double fastNs = 0.0;
+	int n = 0;
+	int i = 0;
+
+	start = benchmark_now();
+	for (n = 0; n < BENCHMARK_VALUE_ITERATIONS; n++) {
+		for (i = 0; i < numberOfLeaves; i++) {
+			benchmarkSink += benchmark_sprintf_value(printBuf, leaves[i]);
+		}
+	}
+	sprintfNs = (benchmark_now() - start) / ((double) BENCHMARK_VALUE_ITERATIONS * numberOfLeaves);
+
+	start = benchmark_now();
+	for (n = 0; n < BENCHMARK_VALUE_ITERATIONS; n++) {
+		for (i = 0; i < numberOfLeaves; i++) {
+			benchmarkSink += itemToJSON(printBuf, leaves[i]);
+		}
+	}
+	fastNs = (benchmark_now() - start) / ((double) BENCHMARK_VALUE_ITERATIONS * numberOfLeaves);
+
+	printf("leaf values (%d)    sprintf: %7.1f ns, itemToJSON(): %7.1f ns, speed-up: %5.2fx\n", numberOfLeaves, sprintfNs, fastNs, sprintfNs / fastNs);
+}
+
+void benchmark_tree(Item *ied) {
+	double start = 0.0;
+	double treeUs = 0.0;
+	int len = 0;
+	int n = 0;
+
+	start = benchmark_now();
+	for (n = 0; n < BENCHMARK_TREE_ITERATIONS; n++) {
+		len = itemTreeToJSON(printBuf, ied);
+		benchmarkSink += len;
+	}
+	treeUs = (benchmark_now() - start) / (1000.0 * BENCHMARK_TREE_ITERATIONS);
+
+	if (len < 0) {
+		printf("itemTreeToJSON()    buffer overrun; increase ACSI_RESPONSE_MAX_SIZE\n");
+	}
+	else {
+		printf("itemTreeToJSON()    %d bytes, %7.2f us per dump, %6.1f MB/s\n", len, treeUs, len / treeUs);
+	}
+}
+
+int main() {
+	Item *ied = NULL;
+
+	initialise_iec61850();
+	srand(61850);
+
+	ied = getIED("E1Q1SB1");
+	if (ied == NULL) {
+		printf("IED E1Q1SB1 not found\n");
+		return 1;
+	}
+	benchmark_find_leaves(ied);
+
+	benchmark_values();
+	benchmark_tree(ied);
+
+	return 0;
+}
+
+#else
+
+int main() {
+	printf("set JSON_INTERFACE to 1 in ctypes.h\n");
+	return 1;
+}
+
+#endif
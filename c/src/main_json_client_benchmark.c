@@ -0,0 +1,148 @@
+/**
+ * Rapid-prototyping protection schemes with IEC 61850
+ *
+ * Copyright (c) 2014 Steven Blair
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+// Benchmark of HTTP requests to a local ACSI server. The same GET of a single value is made:
+//  1. with wget(), which opens a new connection and sends an HTTP/1.0 request each time, as send_http_request_get()
+//     did previously,
+//  2. with jsonClientRequest(), which reuses one HTTP/1.1 keep-alive connection, and
+//  3. with jsonClientBatch(), which also pipelines up to JSON_CLIENT_MAX_PIPELINE requests per round trip.
+
+#include "iec61850.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <time.h>
+
+#if JSON_INTERFACE == 1
+#include "json\json.h"
+#include "json\jsonClient.h"
+
+#define BENCHMARK_PORT				8001
+#define BENCHMARK_URL				"/C1/LN0.Mod.stVal"
+#define BENCHMARK_REQUESTS			20000
+#define BENCHMARK_BATCH				256
+
+char *wget(const char *host, int port, int *len, const char *fmt, ...);
+
+JSONClientRequest batch[BENCHMARK_BATCH];
+
+double benchmark_now() {
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (double) ts.tv_sec * 1e9 + (double) ts.tv_nsec;
+}
+
+void benchmark_print(const char *name, int ok, double ns) {
+	printf("%-22s %6d ok of %d, %8.1f us per request, %9.0f requests/s\n", name, ok, BENCHMARK_REQUESTS, ns / 1000.0 / BENCHMARK_REQUESTS, BENCHMARK_REQUESTS / (ns / 1e9));
+}
+
+void benchmark_wget() {
+	double start = benchmark_now();
+	int ok = 0;
+	int len = 0;
+	int i = 0;
+
+	for (i = 0; i < BENCHMARK_REQUESTS; i++) {
+		char *reply = wget("localhost", BENCHMARK_PORT, &len, "GET %s HTTP/1.0\r\n\r\n", BENCHMARK_URL);
+		if (reply != NULL && len > 12 && strncmp(&reply[9], "200", 3) == 0) {
+			ok++;
+		}
+		free(reply);
+	}
+
+	benchmark_print("wget()", ok, benchmark_now() - start);
+}
+
+void benchmark_keep_alive(JSONClient *client) {
+	JSONClientRequest request;
+	double start = benchmark_now();
+	int ok = 0;
+	int i = 0;
+
+	memset(&request, 0, sizeof(request));
+	request.method = "GET";
+	request.url = BENCHMARK_URL;
+
+	for (i = 0; i < BENCHMARK_REQUESTS; i++) {
+		if (jsonClientRequest(client, "localhost", BENCHMARK_PORT, &request) == 200) {
+			ok++;
+		}
+	}
+
+	benchmark_print("jsonClientRequest()", ok, benchmark_now() - start);
+}
+
+void benchmark_pipelined(JSONClient *client) {
+	double start = benchmark_now();
+	int ok = 0;
+	int i = 0;
+	int j = 0;
+
+	for (i = 0; i < BENCHMARK_BATCH; i++) {
+		batch[i].method = "GET";
+		batch[i].url = BENCHMARK_URL;
+	}
+
+	for (i = 0; i < BENCHMARK_REQUESTS; i += BENCHMARK_BATCH) {
+		int n = (BENCHMARK_REQUESTS - i < BENCHMARK_BATCH) ? BENCHMARK_REQUESTS - i : BENCHMARK_BATCH;
+
+		jsonClientBatch(client, "localhost", BENCHMARK_PORT, batch, n);
+		for (j = 0; j < n; j++) {
+			if (batch[j].status == 200) {
+				ok++;
+			}
+		}
+	}
+
+	benchmark_print("jsonClientBatch()", ok, benchmark_now() - start);
+}
+
+int main() {
+	JSONClient *client = NULL;
+
+	initialise_iec61850();
+	start_json_interface();
+	usleep(500000);
+
+	client = createJSONClient();
+	if (client == NULL) {
+		return 1;
+	}
+
+	printf("GET http://localhost:%d%s\n", BENCHMARK_PORT, BENCHMARK_URL);
+	benchmark_wget();
+	benchmark_keep_alive(client);
+	benchmark_pipelined(client);
+
+	freeJSONClient(client);
+
+	return 0;
+}
+
+#else
+
+int main() {
+	printf("set JSON_INTERFACE to 1 in ctypes.h\n");
+	return 1;
+}
+
+#endif
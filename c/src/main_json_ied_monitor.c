@@ -30,6 +30,7 @@
 #include <pcap.h>
 #include <math.h>
 #include "iec61850.h"
+#include "netBackend.h"
 
 #if JSON_INTERFACE == 1
 #include "json\mongoose.h"
@@ -39,7 +40,6 @@
 
 #define BUFFER_LENGTH	2048
 
-pcap_t *fp;
 char errbuf[PCAP_ERRBUF_SIZE];
 unsigned char buf[BUFFER_LENGTH] = {0};
 int len = 0;
@@ -65,8 +65,7 @@ void packet_handler(u_char *param, const struct pcap_pkthdr *header, const u_cha
 	gse_sv_packet_filter((unsigned char *) pkt_data, header->len);
 }
 
-pcap_t *init_pcap() {
-	pcap_t *fpl;
+void init_pcap() {
     pcap_if_t *alldevs;
     pcap_if_t *used_if;
 
@@ -92,20 +91,12 @@ pcap_t *init_pcap() {
 #endif
     fflush(stdout);
 
-	if ((fpl = pcap_open_live(used_if->name,	// name of the device
-							 65536,				// portion of the packet to capture. It doesn't matter in this case
-							 1,					// promiscuous mode (nonzero means promiscuous)
-							 1000,				// read timeout
-							 errbuf				// error buffer
-							 )) == NULL)
-	{
-		fprintf(stderr, "\nUnable to open the adapter. %s is not supported by WinPcap\n", alldevs->name);
+	if (netBackendPcap.open(&netBackendPcap, used_if->name) != 0) {
 		exit(2);
 	}
+	netBackend = &netBackendPcap;
 
 //    pcap_freealldevs(alldevs);
-
-	return fpl;
 }
 
 
@@ -124,7 +115,7 @@ float getRand() {
 
 int main() {
 	initialise_iec61850();
-	fp = init_pcap();
+	init_pcap();
 
 #if JSON_INTERFACE == 1
 	start_json_interface();
@@ -264,15 +255,19 @@ int main() {
 			JSON.S1.C1.IEC_61850_9_2LETCTR_3.Amp.instMag.i = toI(relays[0]->A1.phsA.cVal.mag.f, harmonic(1, 1.0, theta - phi, + TWO_PI_OVER_THREE) + harmonic(2, 0.01, theta - phi, - TWO_PI_OVER_THREE) + harmonic(3, 0.05, theta - phi, 0) + harmonic(5, 0.05, theta - phi, - TWO_PI_OVER_THREE) + harmonic(7, 0.03, theta - phi, + TWO_PI_OVER_THREE) + harmonic(9, 0.03, theta - phi, 0));
 			JSON.S1.C1.IEC_61850_9_2LETCTR_4.Amp.instMag.i = JSON.S1.C1.IEC_61850_9_2LETCTR_1.Amp.instMag.i + JSON.S1.C1.IEC_61850_9_2LETCTR_2.Amp.instMag.i + JSON.S1.C1.IEC_61850_9_2LETCTR_3.Amp.instMag.i;
 
+			lockDataModel();
 			len = sv_update_JSON_C1_MSVCB01(bufOut);
+			unlockDataModel();
 			if (len > 0) {
-				pcap_sendpacket(fp, bufOut, len);
+				net_backend_send(netBackend, bufOut, len);
 			}
 		}
 
+		lockDataModel();
 		len = gse_send_JSON_C1_MGSECB01(bufOut, 1, 255);
+		unlockDataModel();
 		if (len > 0) {
-			pcap_sendpacket(fp, bufOut, len);
+			net_backend_send(netBackend, bufOut, len);
 		}
 #else
 		usleep(1000000);
@@ -280,7 +275,7 @@ int main() {
 	}
 #endif
 
-	pcap_close(fp);
+	netBackend->close(netBackend);
 
 	return 0;
 }
@@ -0,0 +1,235 @@
+/**
+ * Rapid-prototyping protection schemes with IEC 61850
+ *
+ * Copyright (c) 2014 Steven Blair
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+
+// Worst-case GOOSE reaction time, with the default receive loop (libpcap, or the packet ring, waiting in the kernel with
+// a 1 ms timeout) or with the real-time profile (locked memory, pinned SCHED_FIFO threads and a busy-polling receive
+// loop on an AF_PACKET socket). A transmit thread sends a GOOSE frame with a new stNum every millisecond, and the
+// receive thread records the time from each send to the subscriber's datasetDecodeDone() callback.
+//
+// usage: realtime_benchmark [interface] [default|realtime] [frames] [rxCpu] [txCpu]
+//
+// The receive and transmit CPUs must be different in the real-time profile, because the receive thread never yields.
+
+#include "iec61850.h"
+#include "interface.h"
+#include "realtime.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+
+#if REALTIME_PROFILE_SUPPORTED == 1 && defined(__linux__)
+
+#define BENCHMARK_PERIOD_NS		1000000
+#define BENCHMARK_BUCKET_NS		100					// histogram resolution
+#define BENCHMARK_BUCKETS		100000				// the last bucket also holds all times above 10 ms
+#define BENCHMARK_RX_PRIORITY	80
+#define BENCHMARK_TX_PRIORITY	70
+
+struct realtimeProfile profile = {0, -1, 0, -1, 0, 0};
+int benchmarkFrames = 10000;
+volatile int running = 1;
+
+volatile unsigned long long sendTime = 0;
+volatile CTYPE_INT32U sendStNum = 0;
+CTYPE_INT32U receivedStNum = 0;
+
+CTYPE_INT32U histogram[BENCHMARK_BUCKETS];
+unsigned long long count = 0;
+unsigned long long sum = 0;
+unsigned long long min = ~0ULL;
+unsigned long long max = 0;
+
+unsigned long long benchmark_now() {
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (unsigned long long) ts.tv_sec * 1000000000ULL + (unsigned long long) ts.tv_nsec;
+}
+
+// called on the receive thread
+void benchmark_received(CTYPE_INT32U timeAllowedToLive, CTYPE_TIMESTAMP T, CTYPE_INT32U stNum, CTYPE_INT32U sqNum) {
+	unsigned long long ns = benchmark_now() - sendTime;
+	unsigned long long bucket = ns / BENCHMARK_BUCKET_NS;
+
+	// frames are seen twice on the loopback interface, and frames sent before the benchmark started are ignored
+	if (stNum != sendStNum || stNum == receivedStNum) {
+		return;
+	}
+	receivedStNum = stNum;
+
+	histogram[(bucket < BENCHMARK_BUCKETS) ? bucket : BENCHMARK_BUCKETS - 1]++;
+	count++;
+	sum += ns;
+	if (ns < min) {
+		min = ns;
+	}
+	if (ns > max) {
+		max = ns;
+	}
+}
+
+void *benchmark_transmit(void *arg) {
+	struct timespec next;
+	int i = 0;
+
+	realtime_apply_tx(&profile);
+
+	clock_gettime(CLOCK_MONOTONIC, &next);
+	for (i = 0; i < benchmarkFrames; i++) {
+		next.tv_nsec += BENCHMARK_PERIOD_NS;
+		if (next.tv_nsec >= 1000000000L) {
+			next.tv_nsec -= 1000000000L;
+			next.tv_sec++;
+		}
+		clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &next, NULL);
+
+		// the encoder increments stNum on a status change
+		sendStNum = E1Q1SB1.S1.C1.LN0.ItlPositions.stNum + 1;
+		sendTime = benchmark_now();
+		interface_gse_send_E1Q1SB1_C1_ItlPositions(1, 1000);
+	}
+
+	// allows the last frame to arrive
+	next.tv_sec++;
+	clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &next, NULL);
+	running = 0;
+
+	return NULL;
+}
+
+unsigned long long benchmark_percentile(double percentile) {
+	unsigned long long target = (unsigned long long) (percentile / 100.0 * count);
+	unsigned long long seen = 0;
+	int i = 0;
+
+	for (i = 0; i < BENCHMARK_BUCKETS; i++) {
+		seen += histogram[i];
+		if (seen > target) {
+			return (unsigned long long) (i + 1) * BENCHMARK_BUCKET_NS;
+		}
+	}
+
+	return max;
+}
+
+void benchmark_report(const char *profileName) {
+	unsigned long long rangeStart = 0;
+	unsigned long long rangeEnd = 1000;
+	int i = 0;
+
+	if (count == 0) {
+		printf("no frames received\n");
+		return;
+	}
+
+	printf("%s profile: %llu frames, reaction time (ns) min: %llu, mean: %llu, p50: %llu, p99: %llu, p99.9: %llu, p99.99: %llu, max: %llu\n",
+		profileName,
+		count,
+		min,
+		sum / count,
+		benchmark_percentile(50.0),
+		benchmark_percentile(99.0),
+		benchmark_percentile(99.9),
+		benchmark_percentile(99.99),
+		max);
+
+	// power-of-two ranges from 1 us, so that the tail is visible
+	while (rangeStart < (unsigned long long) BENCHMARK_BUCKETS * BENCHMARK_BUCKET_NS) {
+		unsigned long long frames = 0;
+
+		for (i = (int) (rangeStart / BENCHMARK_BUCKET_NS); i < (int) (rangeEnd / BENCHMARK_BUCKET_NS) && i < BENCHMARK_BUCKETS; i++) {
+			frames += histogram[i];
+		}
+		if (frames > 0) {
+			printf("  %6llu - %6llu us: %llu\n", rangeStart / 1000, rangeEnd / 1000, frames);
+		}
+
+		rangeStart = rangeEnd;
+		rangeEnd *= 2;
+	}
+}
+
+int main(int argc, char **argv) {
+	const char *source = (argc > 1) ? argv[1] : NULL;
+	int realtime = (argc > 2 && strcmp(argv[2], "realtime") == 0);
+	pthread_t transmitThread;
+
+	if (argc > 3) {
+		benchmarkFrames = atoi(argv[3]);
+	}
+	if (realtime) {
+		profile.lockMemory = 1;
+		profile.rxCpu = (argc > 4) ? atoi(argv[4]) : 1;
+		profile.rxPriority = BENCHMARK_RX_PRIORITY;
+		profile.txCpu = (argc > 5) ? atoi(argv[5]) : 2;
+		profile.txPriority = BENCHMARK_TX_PRIORITY;
+		profile.busyPollMicroseconds = 50;
+
+		if (profile.rxCpu == profile.txCpu) {
+			fprintf(stderr, "rxCpu and txCpu must be different\n");
+			return 1;
+		}
+	}
+
+	if (realtime) {
+		startWithBackend(&netBackendRawSocket, source);
+	}
+	else {
+#if PACKET_RING_SUPPORTED == 1
+		startWithBackend(&netBackendPacketRing, source);
+#else
+		startWithBackend(&netBackendPcap, source);
+#endif
+	}
+	D1Q1SB4.S1.C1.RSYNa_1.gse_inputs_ItlPositions.datasetDecodeDone = &benchmark_received;
+
+	if (realtime && realtime_apply_rx(&profile, netBackend) != 0) {
+		fprintf(stderr, "real-time profile only partially applied\n");
+	}
+	realtime_prefault(histogram, sizeof(histogram));
+
+	pthread_create(&transmitThread, NULL, benchmark_transmit, NULL);
+	if (realtime) {
+		realtime_receive_loop(netBackend, &running);
+	}
+	else {
+		while (running) {
+			readPacketTimeout();
+		}
+	}
+	pthread_join(transmitThread, NULL);
+
+	benchmark_report(realtime ? "real-time" : "default");
+	stop();
+
+	return 0;
+}
+
+#else
+
+int main() {
+	printf("set REALTIME_PROFILE_SUPPORTED to 1 in ctypes.h (Linux only)\n");
+	return 0;
+}
+
+#endif
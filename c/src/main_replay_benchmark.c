@@ -0,0 +1,472 @@
+/**
+ * Rapid-prototyping protection schemes with IEC 61850
+ *
+ * Copyright (c) 2014 Steven Blair
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+// Decode benchmark which replays a pcap or pcapng capture. All GOOSE and SV frames are preloaded into memory, and
+// then passed to gse_sv_packet_filter() as fast as possible, a given number of times. Results are reported for the
+// whole capture, for GOOSE and SV frames separately, and for each control block (identified by its gocbRef or svID).
+//
+// usage: main_replay_benchmark <capture.pcap | capture.pcapng> [repeats]
+
+#include "iec61850.h"
+#include "decodePacket.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#ifdef _WIN32
+#include <intrin.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#if defined(__i386__) || defined(__x86_64__)
+#include <x86intrin.h>
+#endif
+#endif
+
+#define REPLAY_DEFAULT_REPEATS		100
+#define REPLAY_MAX_STREAMS			256
+#define REPLAY_MAX_NAME				130		// gocbRef and svID are at most 129 characters
+
+#define REPLAY_TYPE_GOOSE			0
+#define REPLAY_TYPE_SV				1
+
+#define PCAP_MAGIC					0xA1B2C3D4
+#define PCAP_MAGIC_NS				0xA1B23C4D
+#define PCAPNG_BLOCK_SHB			0x0A0D0D0A
+#define PCAPNG_BLOCK_IDB			0x00000001
+#define PCAPNG_BLOCK_PACKET			0x00000002
+#define PCAPNG_BLOCK_SPB			0x00000003
+#define PCAPNG_BLOCK_EPB			0x00000006
+
+struct replayFrame {
+	unsigned char *buf;
+	int len;
+	int stream;
+};
+
+struct replayStream {
+	char name[REPLAY_MAX_NAME];
+	int type;
+	int frames;
+};
+
+struct replayResult {
+	double ns;
+	unsigned long long cycles;
+};
+
+struct replayFrame *frames = NULL;
+int frameCount = 0;
+int frameCapacity = 0;
+int skippedFrames = 0;
+
+struct replayStream streams[REPLAY_MAX_STREAMS];
+int streamCount = 0;
+
+int *order = NULL;		// frame indexes for each run
+
+double benchmark_now() {
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (double) ts.tv_sec * 1e9 + (double) ts.tv_nsec;
+}
+
+// returns the time stamp counter, or 0 if it is not available on this platform
+unsigned long long benchmark_cycles() {
+#if defined(_MSC_VER) || defined(__i386__) || defined(__x86_64__)
+	return __rdtsc();
+#else
+	return 0;
+#endif
+}
+
+CTYPE_INT32U read32(const unsigned char *buf, int swap) {
+	CTYPE_INT32U value;
+
+	memcpy(&value, buf, 4);
+	if (swap) {
+		value = ((value & 0xFF) << 24) | ((value & 0xFF00) << 8) | ((value >> 8) & 0xFF00) | (value >> 24);
+	}
+
+	return value;
+}
+
+// skips a BER tag and length, and returns a pointer to the value, or NULL if the tag does not match
+unsigned char *ber_enter(unsigned char *buf, unsigned char *end, unsigned char tag, int *length) {
+	int lengthFieldSize = 0;
+
+	if (buf == NULL || buf + 2 > end || buf[0] != tag) {
+		return NULL;
+	}
+
+	lengthFieldSize = getLengthFieldSize(buf[1]);
+	if (buf + 1 + lengthFieldSize > end) {
+		return NULL;
+	}
+
+	*length = decodeLength(&buf[1]);
+	return &buf[1 + lengthFieldSize];
+}
+
+// finds the control block name: gocbRef for GOOSE, or the svID of the first ASDU for SV
+void replay_stream_name(char *name, unsigned char *pdu, unsigned char *end, int type, int appID) {
+	unsigned char *value = NULL;
+	int length = 0;
+
+	if (type == REPLAY_TYPE_GOOSE) {
+		value = ber_enter(ber_enter(pdu, end, ASN1_TAG_SEQUENCE, &length), end, GSE_TAG_GOCBREF, &length);
+	}
+	else {
+		unsigned char *asdus = ber_enter(pdu, end, 0x60, &length);
+		unsigned char *noASDU = ber_enter(asdus, end, 0x80, &length);
+
+		if (noASDU != NULL) {
+			asdus = noASDU + length;
+			if (asdus < end && asdus[0] == 0x81) {		// optional security field
+				unsigned char *security = ber_enter(asdus, end, 0x81, &length);
+				asdus = (security != NULL) ? security + length : NULL;
+			}
+			value = ber_enter(ber_enter(ber_enter(asdus, end, 0xA2, &length), end, 0x30, &length), end, 0x80, &length);
+		}
+	}
+
+	if (value != NULL && value + length <= end && length < REPLAY_MAX_NAME - 6) {
+		sprintf(name, "%s %.*s", type == REPLAY_TYPE_GOOSE ? "GSE" : "SV ", length, (char *) value);
+	}
+	else {
+		sprintf(name, "%s APPID 0x%04X", type == REPLAY_TYPE_GOOSE ? "GSE" : "SV ", appID);
+	}
+}
+
+int replay_find_stream(const char *name, int type) {
+	int i = 0;
+
+	for (i = 0; i < streamCount; i++) {
+		if (strcmp(streams[i].name, name) == 0) {
+			return i;
+		}
+	}
+
+	if (streamCount == REPLAY_MAX_STREAMS) {
+		return -1;
+	}
+
+	strcpy(streams[streamCount].name, name);
+	streams[streamCount].type = type;
+	streams[streamCount].frames = 0;
+
+	return streamCount++;
+}
+
+// copies a GOOSE or SV frame from the capture into the frame list
+void replay_add_frame(const unsigned char *data, int len) {
+	unsigned char *buf = NULL;
+	char name[REPLAY_MAX_NAME];
+	int offset = 12;
+	int etherType = 0;
+	int type = 0;
+	int stream = 0;
+
+	if (len < offset + 2) {
+		skippedFrames++;
+		return;
+	}
+
+	etherType = (data[offset] << 8) | data[offset + 1];
+	if (etherType == 0x8100 && len >= offset + 6) {
+		offset += 4;
+		etherType = (data[offset] << 8) | data[offset + 1];
+	}
+
+	if (etherType == 0x88B8) {
+		type = REPLAY_TYPE_GOOSE;
+	}
+	else if (etherType == 0x88BA) {
+		type = REPLAY_TYPE_SV;
+	}
+	else {
+		skippedFrames++;
+		return;
+	}
+
+	if (len < offset + 10) {
+		skippedFrames++;
+		return;
+	}
+
+	buf = (unsigned char *) malloc(len);
+	memcpy(buf, data, len);
+
+	replay_stream_name(name, &buf[offset + 10], &buf[len], type, (buf[offset + 2] << 8) | buf[offset + 3]);
+	stream = replay_find_stream(name, type);
+	if (stream < 0) {
+		free(buf);
+		skippedFrames++;
+		return;
+	}
+
+	if (frameCount == frameCapacity) {
+		frameCapacity = (frameCapacity == 0) ? 1024 : frameCapacity * 2;
+		frames = (struct replayFrame *) realloc(frames, frameCapacity * sizeof(struct replayFrame));
+	}
+
+	frames[frameCount].buf = buf;
+	frames[frameCount].len = len;
+	frames[frameCount].stream = stream;
+	frameCount++;
+	streams[stream].frames++;
+}
+
+int replay_parse_pcap(const unsigned char *data, long size) {
+	CTYPE_INT32U magic = read32(data, 0);
+	int swap = (magic != PCAP_MAGIC && magic != PCAP_MAGIC_NS);
+	long offset = 24;
+
+	while (offset + 16 <= size) {
+		CTYPE_INT32U capturedLength = read32(&data[offset + 8], swap);
+
+		offset += 16;
+		if (offset + (long) capturedLength > size) {
+			break;
+		}
+
+		replay_add_frame(&data[offset], (int) capturedLength);
+		offset += capturedLength;
+	}
+
+	return 0;
+}
+
+int replay_parse_pcapng(const unsigned char *data, long size) {
+	long offset = 0;
+	int swap = 0;
+
+	while (offset + 12 <= size) {
+		CTYPE_INT32U blockType = read32(&data[offset], swap);
+		CTYPE_INT32U blockLength = 0;
+
+		if (blockType == PCAPNG_BLOCK_SHB) {
+			// byte order magic 0x1A2B3C4D
+			swap = (data[offset + 8] == 0x4D) != PLATFORM_LITTLE_ENDIAN;
+		}
+
+		blockLength = read32(&data[offset + 4], swap);
+		if (blockLength < 12 || offset + (long) blockLength > size) {
+			return -1;
+		}
+
+		if (blockType == PCAPNG_BLOCK_EPB || blockType == PCAPNG_BLOCK_PACKET) {
+			CTYPE_INT32U capturedLength = read32(&data[offset + 20], swap);
+
+			if (28 + capturedLength <= blockLength) {
+				replay_add_frame(&data[offset + 28], (int) capturedLength);
+			}
+		}
+		else if (blockType == PCAPNG_BLOCK_SPB) {
+			// the captured length is the smaller of the packet length and the block data length
+			CTYPE_INT32U capturedLength = read32(&data[offset + 8], swap);
+
+			if (capturedLength > blockLength - 16) {
+				capturedLength = blockLength - 16;
+			}
+			replay_add_frame(&data[offset + 12], (int) capturedLength);
+		}
+
+		offset += blockLength;
+	}
+
+	return 0;
+}
+
+int replay_load(const char *fileName) {
+	unsigned char *data = NULL;
+	long size = 0;
+	int ret = -1;
+#ifdef _WIN32
+	FILE *f = fopen(fileName, "rb");
+
+	if (f == NULL) {
+		return -1;
+	}
+	fseek(f, 0, SEEK_END);
+	size = ftell(f);
+	fseek(f, 0, SEEK_SET);
+	data = (unsigned char *) malloc(size);
+	if (fread(data, 1, size, f) != (size_t) size) {
+		size = 0;
+	}
+	fclose(f);
+#else
+	struct stat st;
+	int fd = open(fileName, O_RDONLY);
+
+	if (fd < 0) {
+		return -1;
+	}
+	if (fstat(fd, &st) != 0 || st.st_size == 0) {
+		close(fd);
+		return -1;
+	}
+	size = (long) st.st_size;
+	data = (unsigned char *) mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if (data == MAP_FAILED) {
+		return -1;
+	}
+#endif
+
+	if (size >= 24) {
+		CTYPE_INT32U magic = read32(data, 0);
+
+		if (magic == PCAPNG_BLOCK_SHB) {
+			ret = replay_parse_pcapng(data, size);
+		}
+		else if (magic == PCAP_MAGIC || magic == PCAP_MAGIC_NS || read32(data, 1) == PCAP_MAGIC || read32(data, 1) == PCAP_MAGIC_NS) {
+			ret = replay_parse_pcap(data, size);
+		}
+	}
+
+#ifdef _WIN32
+	free(data);
+#else
+	munmap(data, size);
+#endif
+
+	return ret;
+}
+
+// decodes the frames in order[], repeats times; returns the mean time per frame
+struct replayResult replay_run(int count, int repeats) {
+	struct replayResult result;
+	double start = 0.0;
+	unsigned long long startCycles = 0;
+	int n = 0;
+	int i = 0;
+
+	for (i = 0; i < count; i++) {		// warm up caches and branch predictors
+		gse_sv_packet_filter(frames[order[i]].buf, frames[order[i]].len);
+	}
+
+	start = benchmark_now();
+	startCycles = benchmark_cycles();
+	for (n = 0; n < repeats; n++) {
+		for (i = 0; i < count; i++) {
+			gse_sv_packet_filter(frames[order[i]].buf, frames[order[i]].len);
+		}
+	}
+	result.cycles = benchmark_cycles() - startCycles;
+	result.ns = benchmark_now() - start;
+
+	result.ns /= (double) count * repeats;
+	result.cycles /= (unsigned long long) count * repeats;
+
+	return result;
+}
+
+void replay_report(const char *name, int count, struct replayResult result) {
+	if (count == 0) {
+		return;
+	}
+
+	printf("%-48.48s %9d %12.0f %9.1f", name, count, 1e9 / result.ns, result.ns);
+	if (result.cycles > 0) {
+		printf(" %9llu\n", result.cycles);
+	}
+	else {
+		printf(" %9s\n", "n/a");
+	}
+}
+
+int main(int argc, char **argv) {
+	int repeats = REPLAY_DEFAULT_REPEATS;
+	int count = 0;
+	int type = 0;
+	int s = 0;
+	int i = 0;
+
+	if (argc < 2) {
+		fprintf(stderr, "usage: %s <capture.pcap | capture.pcapng> [repeats]\n", argv[0]);
+		return 1;
+	}
+	if (argc > 2) {
+		repeats = atoi(argv[2]);
+		if (repeats <= 0) {
+			repeats = 1;
+		}
+	}
+
+	initialise_iec61850();
+
+	if (replay_load(argv[1]) != 0) {
+		fprintf(stderr, "Unable to read %s as a pcap or pcapng file\n", argv[1]);
+		return 1;
+	}
+	if (frameCount == 0) {
+		fprintf(stderr, "No GOOSE or SV frames in %s\n", argv[1]);
+		return 1;
+	}
+
+	printf("%d GOOSE and SV frames (%d other frames skipped), %d control blocks, %d repeats\n\n", frameCount, skippedFrames, streamCount, repeats);
+	printf("%-48s %9s %12s %9s %9s\n", "", "frames", "frames/s", "ns/frame", "cycles");
+
+	order = (int *) malloc(frameCount * sizeof(int));
+
+	// whole capture, in order
+	for (i = 0; i < frameCount; i++) {
+		order[i] = i;
+	}
+	replay_report("all", frameCount, replay_run(frameCount, repeats));
+
+	// by frame type
+	for (type = REPLAY_TYPE_GOOSE; type <= REPLAY_TYPE_SV; type++) {
+		count = 0;
+		for (i = 0; i < frameCount; i++) {
+			if (streams[frames[i].stream].type == type) {
+				order[count++] = i;
+			}
+		}
+		if (count > 0) {
+			replay_report(type == REPLAY_TYPE_GOOSE ? "GOOSE" : "SV", count, replay_run(count, repeats));
+		}
+	}
+
+	// by control block
+	printf("\n");
+	for (s = 0; s < streamCount; s++) {
+		count = 0;
+		for (i = 0; i < frameCount; i++) {
+			if (frames[i].stream == s) {
+				order[count++] = i;
+			}
+		}
+		replay_report(streams[s].name, count, replay_run(count, repeats));
+	}
+
+	for (i = 0; i < frameCount; i++) {
+		free(frames[i].buf);
+	}
+	free(frames);
+	free(order);
+
+	return 0;
+}
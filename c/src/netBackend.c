@@ -0,0 +1,433 @@
+/**
+ * Rapid-prototyping protection schemes with IEC 61850
+ *
+ * Copyright (c) 2014 Steven Blair
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+
+#include "netBackend.h"
+#include "latency.h"
+#include "capture.h"
+
+#ifdef _WIN32
+	#define WPCAP
+	#define HAVE_REMOTE
+	#define WIN32_LEAN_AND_MEAN
+#endif
+#include <pcap.h>
+
+#if (PACKET_RING_SUPPORTED == 1 || REALTIME_PROFILE_SUPPORTED == 1) && defined(__linux__)
+#include <errno.h>
+#include <poll.h>
+#include <sys/socket.h>
+#endif
+#if REALTIME_PROFILE_SUPPORTED == 1 && defined(__linux__)
+#include <string.h>
+#include <arpa/inet.h>
+#include <net/if.h>
+#include <linux/if_packet.h>
+#include <linux/if_ether.h>
+#include <unistd.h>
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define NET_BACKEND_BARRIER()		_ReadWriteBarrier()		// x86 does not reorder stores with other stores
+#else
+#define NET_BACKEND_BARRIER()		__sync_synchronize()
+#endif
+
+struct netLoopbackSlot {
+	int len;
+	unsigned char buf[NET_LOOPBACK_FRAME_SIZE];
+};
+
+struct netLoopback {
+	volatile CTYPE_INT32U head;		// only modified by the transmitting thread
+	volatile CTYPE_INT32U tail;		// only modified by the receiving thread
+	unsigned long long drops;
+	struct netLoopbackSlot slots[NET_LOOPBACK_SLOTS];
+};
+
+static char errbuf[PCAP_ERRBUF_SIZE];
+static int pcapNonBlocking = 0;
+static struct netLoopback loopback;
+
+struct netBackend *netBackend = &netBackendPcap;
+
+int net_backend_send(struct netBackend *backend, const unsigned char *buf, int len) {
+	struct netFrame frame;
+	int sent = 0;
+
+	frame.buf = buf;
+	frame.len = len;
+	sent = backend->txBatch(backend, &frame, 1);
+
+	// frames are recorded after sending, so that the recorder does not delay transmission
+	if (sent > 0) {
+		CAPTURE_FRAME(buf, len, CAPTURE_SENT);
+	}
+
+	return sent;
+}
+
+
+// libpcap
+static void net_pcap_handler(u_char *param, const struct pcap_pkthdr *header, const u_char *pkt_data) {
+	LATENCY_FRAME_RECEIVED(&header->ts);
+	CAPTURE_RECEIVE_TIME((unsigned long long) header->ts.tv_sec * 1000000000ULL + (unsigned long long) header->ts.tv_usec * 1000ULL);
+	gse_sv_packet_filter((unsigned char *) pkt_data, header->caplen);
+}
+
+static int net_pcap_open(struct netBackend *backend, const char *source) {
+	pcap_t *fp = pcap_open_live(source,		// name of the device
+								65536,		// portion of the packet to capture. It doesn't matter in this case
+								1,			// promiscuous mode (nonzero means promiscuous)
+								1,			// read timeout
+								errbuf		// error buffer
+								);
+
+	if (fp == NULL) {
+		fprintf(stderr, "\nUnable to open the adapter. %s is not supported by WinPcap\n", source);
+		return -1;
+	}
+
+	backend->state = fp;
+	backend->fd = pcap_fileno(fp);
+	pcapNonBlocking = 0;
+
+	return 0;
+}
+
+static int net_pcap_rx_batch(struct netBackend *backend, int timeout) {
+	int ret = 0;
+
+	// a zero timeout returns immediately if no frames are waiting, for busy-polling receive loops
+	if ((timeout == 0) != pcapNonBlocking) {
+		pcapNonBlocking = (timeout == 0);
+		pcap_setnonblock((pcap_t *) backend->state, pcapNonBlocking, errbuf);
+	}
+
+	// pcap_dispatch() waits for up to the read timeout given to pcap_open_live()
+	do {
+		ret = pcap_dispatch((pcap_t *) backend->state, NET_BACKEND_RX_BATCH, net_pcap_handler, NULL);
+
+		// libpcap fails to read while transmit timestamps are waiting on the socket's error queue (see latency.h)
+		if (ret == -1 && LATENCY_TRANSMIT_DRAIN(backend->fd) > 0) {
+			ret = 0;
+		}
+	} while (ret == 0 && timeout < 0);
+
+	return ret;
+}
+
+static int net_pcap_tx_batch(struct netBackend *backend, const struct netFrame *frames, int count) {
+	int sent = 0;
+	int i = 0;
+
+	for (i = 0; i < count; i++) {
+		if (pcap_sendpacket((pcap_t *) backend->state, frames[i].buf, frames[i].len) == 0) {
+			sent++;
+		}
+	}
+
+	return sent;
+}
+
+static void net_pcap_close(struct netBackend *backend) {
+	if (backend->state != NULL) {
+		pcap_close((pcap_t *) backend->state);
+		backend->state = NULL;
+	}
+	backend->fd = -1;
+}
+
+struct netBackend netBackendPcap = {"pcap", net_pcap_open, net_pcap_rx_batch, net_pcap_tx_batch, net_pcap_close, -1, NULL};
+
+
+// pcap file replay
+static void net_pcap_file_handler(u_char *param, const struct pcap_pkthdr *header, const u_char *pkt_data) {
+	// the capture timestamps are not used for latency measurements, because they are historical
+	gse_sv_packet_filter((unsigned char *) pkt_data, header->caplen);
+}
+
+static int net_pcap_file_open(struct netBackend *backend, const char *source) {
+	pcap_t *fp = pcap_open_offline(source, errbuf);
+
+	if (fp == NULL) {
+		fprintf(stderr, "Unable to open %s: %s\n", source, errbuf);
+		return -1;
+	}
+
+	backend->state = fp;
+	backend->fd = -1;
+
+	return 0;
+}
+
+static int net_pcap_file_rx_batch(struct netBackend *backend, int timeout) {
+	int ret = pcap_dispatch((pcap_t *) backend->state, NET_BACKEND_RX_BATCH, net_pcap_file_handler, NULL);
+
+	return (ret == 0) ? -2 : ret;
+}
+
+static int net_discard_tx_batch(struct netBackend *backend, const struct netFrame *frames, int count) {
+	return count;
+}
+
+struct netBackend netBackendPcapFile = {"pcap-file", net_pcap_file_open, net_pcap_file_rx_batch, net_discard_tx_batch, net_pcap_close, -1, NULL};
+
+
+// in-memory loopback
+static int net_loopback_open(struct netBackend *backend, const char *source) {
+	loopback.head = 0;
+	loopback.tail = 0;
+	loopback.drops = 0;
+
+	backend->state = &loopback;
+	backend->fd = -1;
+
+	return 0;
+}
+
+static int net_loopback_rx_batch(struct netBackend *backend, int timeout) {
+	CTYPE_INT32U head = loopback.head;
+	CTYPE_INT32U tail = loopback.tail;
+	int frames = 0;
+
+	NET_BACKEND_BARRIER();		// slots are read after head
+
+	while (tail != head && frames < NET_BACKEND_RX_BATCH) {
+		struct netLoopbackSlot *slot = &loopback.slots[tail & (NET_LOOPBACK_SLOTS - 1)];
+
+		gse_sv_packet_filter(slot->buf, slot->len);
+		tail++;
+		frames++;
+	}
+
+	NET_BACKEND_BARRIER();		// slots are released after they have been read
+	loopback.tail = tail;
+
+	return frames;
+}
+
+static int net_loopback_tx_batch(struct netBackend *backend, const struct netFrame *frames, int count) {
+	CTYPE_INT32U head = loopback.head;
+	CTYPE_INT32U tail = loopback.tail;
+	int sent = 0;
+	int i = 0;
+
+	NET_BACKEND_BARRIER();
+
+	for (i = 0; i < count; i++) {
+		struct netLoopbackSlot *slot = &loopback.slots[head & (NET_LOOPBACK_SLOTS - 1)];
+
+		if (head - tail >= NET_LOOPBACK_SLOTS || frames[i].len > NET_LOOPBACK_FRAME_SIZE) {
+			loopback.drops++;
+			continue;
+		}
+
+		memcpy(slot->buf, frames[i].buf, frames[i].len);
+		slot->len = frames[i].len;
+		head++;
+		sent++;
+	}
+
+	NET_BACKEND_BARRIER();		// slots are published before head
+	loopback.head = head;
+
+	return sent;
+}
+
+static void net_loopback_close(struct netBackend *backend) {
+	backend->state = NULL;
+}
+
+unsigned long long net_loopback_drops() {
+	return loopback.drops;
+}
+
+struct netBackend netBackendLoopback = {"loopback", net_loopback_open, net_loopback_rx_batch, net_loopback_tx_batch, net_loopback_close, -1, NULL};
+
+
+#if (PACKET_RING_SUPPORTED == 1 || REALTIME_PROFILE_SUPPORTED == 1) && defined(__linux__)
+// AF_PACKET sockets are bound to the interface, so frames can be sent without a destination address
+static int net_socket_tx_batch(struct netBackend *backend, const struct netFrame *frames, int count) {
+	int sent = 0;
+	int i = 0;
+
+	for (i = 0; i < count; i++) {
+		if (send(backend->fd, frames[i].buf, frames[i].len, 0) == frames[i].len) {
+			sent++;
+		}
+	}
+
+	return sent;
+}
+#endif
+
+
+// TPACKET_V3 ring
+#if PACKET_RING_SUPPORTED == 1 && defined(__linux__)
+static struct packetRing ring;
+
+static int net_packet_ring_open(struct netBackend *backend, const char *source) {
+	if (packet_ring_open(&ring, source) != 0) {
+		fprintf(stderr, "Unable to open TPACKET_V3 receive ring on %s\n", source);
+		return -1;
+	}
+
+	backend->state = &ring;
+	backend->fd = ring.fd;
+
+	return 0;
+}
+
+static int net_packet_ring_rx_batch(struct netBackend *backend, int timeout) {
+	return packet_ring_poll(&ring, timeout);
+}
+
+static void net_packet_ring_close(struct netBackend *backend) {
+	packet_ring_close(&ring);
+	backend->state = NULL;
+	backend->fd = -1;
+}
+
+struct netBackend netBackendPacketRing = {"packet-ring", net_packet_ring_open, net_packet_ring_rx_batch, net_socket_tx_batch, net_packet_ring_close, -1, NULL};
+
+
+// TPACKET_V3 rings in a PACKET_FANOUT group
+static unsigned long long fanoutFrames = 0;
+
+static int net_packet_fanout_open(struct netBackend *backend, const char *source) {
+	if (packet_ring_start_workers(source, packetRingWorkerCount) != 0) {
+		fprintf(stderr, "Unable to start %d PACKET_FANOUT receive threads on %s\n", packetRingWorkerCount, source);
+		return -1;
+	}
+
+	fanoutFrames = 0;
+	backend->state = packet_ring_get_worker(0);
+	backend->fd = packet_ring_get_worker(0)->fd;
+
+	return 0;
+}
+
+static int net_packet_fanout_rx_batch(struct netBackend *backend, int timeout) {
+	unsigned long long frames = packet_ring_wait_workers(fanoutFrames, timeout);
+	int decoded = (int) (frames - fanoutFrames);
+	fanoutFrames = frames;
+
+	return decoded;
+}
+
+static void net_packet_fanout_close(struct netBackend *backend) {
+	packet_ring_stop_workers();
+	backend->state = NULL;
+	backend->fd = -1;
+}
+
+struct netBackend netBackendPacketFanout = {"packet-fanout", net_packet_fanout_open, net_packet_fanout_rx_batch, net_socket_tx_batch, net_packet_fanout_close, -1, NULL};
+#endif
+
+
+// AF_PACKET socket without a ring
+#if REALTIME_PROFILE_SUPPORTED == 1 && defined(__linux__)
+static unsigned char rawSocketBuf[NET_RAW_SOCKET_FRAME_SIZE];
+
+static int net_raw_socket_open(struct netBackend *backend, const char *source) {
+	struct sockaddr_ll addr;
+	struct packet_mreq mreq;
+	int ifindex = (int) if_nametoindex(source);
+	int fd = -1;
+
+	if (ifindex == 0 || (fd = socket(AF_PACKET, SOCK_RAW, htons(ETH_P_ALL))) < 0) {
+		fprintf(stderr, "Unable to open AF_PACKET socket on %s\n", source);
+		return -1;
+	}
+
+	memset(&addr, 0, sizeof(addr));
+	addr.sll_family = AF_PACKET;
+	addr.sll_protocol = htons(ETH_P_ALL);
+	addr.sll_ifindex = ifindex;
+	if (bind(fd, (struct sockaddr *) &addr, sizeof(addr)) != 0) {
+		fprintf(stderr, "Unable to bind AF_PACKET socket to %s\n", source);
+		close(fd);
+		return -1;
+	}
+
+	// GSE and SV use multicast destination addresses, which are not received unless in promiscuous mode
+	memset(&mreq, 0, sizeof(mreq));
+	mreq.mr_ifindex = ifindex;
+	mreq.mr_type = PACKET_MR_PROMISC;
+	setsockopt(fd, SOL_PACKET, PACKET_ADD_MEMBERSHIP, &mreq, sizeof(mreq));
+
+	backend->state = NULL;
+	backend->fd = fd;
+
+	return 0;
+}
+
+static int net_raw_socket_rx_batch(struct netBackend *backend, int timeout) {
+	int frames = 0;
+	int len = 0;
+
+	// a zero timeout only tries to read, so that busy-polling receive loops do not make a poll() call for every frame
+	if (timeout != 0) {
+		struct pollfd pfd;
+		int ret = 0;
+
+		pfd.fd = backend->fd;
+		pfd.events = POLLIN;
+		pfd.revents = 0;
+
+		ret = poll(&pfd, 1, timeout);
+		if (ret <= 0) {
+			return (ret == 0 || errno == EINTR) ? 0 : -1;
+		}
+
+		// otherwise, transmit timestamps waiting on the socket's error queue (see latency.h) would wake every poll()
+		if ((pfd.revents & POLLERR) != 0) {
+			LATENCY_TRANSMIT_POLL(backend->fd);
+		}
+	}
+
+	while (frames < NET_BACKEND_RX_BATCH) {
+		len = (int) recv(backend->fd, rawSocketBuf, sizeof(rawSocketBuf), MSG_DONTWAIT);
+		if (len <= 0) {
+			if (len < 0 && frames == 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+				return -1;
+			}
+			break;
+		}
+
+		LATENCY_FRAME_RECEIVED(NULL);
+		gse_sv_packet_filter(rawSocketBuf, len);
+		frames++;
+	}
+
+	return frames;
+}
+
+static void net_raw_socket_close(struct netBackend *backend) {
+	if (backend->fd >= 0) {
+		close(backend->fd);
+	}
+	backend->fd = -1;
+}
+
+struct netBackend netBackendRawSocket = {"raw-socket", net_raw_socket_open, net_raw_socket_rx_batch, net_socket_tx_batch, net_raw_socket_close, -1, NULL};
+#endif
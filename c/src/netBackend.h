@@ -0,0 +1,113 @@
+/**
+ * Rapid-prototyping protection schemes with IEC 61850
+ *
+ * Copyright (c) 2014 Steven Blair
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+
+#ifndef NET_BACKEND_H
+#define NET_BACKEND_H
+
+#ifdef __cplusplus /* If this is a C++ compiler, use C linkage */
+extern "C" {
+#endif
+
+#include "ctypes.h"
+#include "packetRing.h"
+
+#define NET_BACKEND_RX_BATCH		64		// maximum frames per rxBatch() call, for backends which read one frame at a time
+#define NET_LOOPBACK_SLOTS			256		// must be a power of two
+#define NET_LOOPBACK_FRAME_SIZE		2048
+#define NET_RAW_SOCKET_FRAME_SIZE	2048
+
+struct netFrame {
+	const unsigned char *buf;
+	int len;
+};
+
+// Network I/O backend. All received frames are passed to gse_sv_packet_filter().
+struct netBackend {
+	const char *name;
+
+	/**
+	 * Opens the backend. source is a network interface name, or a file name for the pcap file backend. Returns 0 on
+	 * success, or -1 on failure.
+	 */
+	int (*open)(struct netBackend *backend, const char *source);
+
+	/**
+	 * Processes a batch of received frames, waiting for up to timeout ms (or indefinitely, if timeout is negative) for
+	 * the first frame. Returns the number of frames processed, 0 on timeout, -1 on error, or -2 when there are no more
+	 * frames to replay.
+	 */
+	int (*rxBatch)(struct netBackend *backend, int timeout);
+
+	/**
+	 * Transmits count frames. Returns the number of frames sent.
+	 */
+	int (*txBatch)(struct netBackend *backend, const struct netFrame *frames, int count);
+
+	void (*close)(struct netBackend *backend);
+
+	int fd;			// socket used for transmission, for kernel transmit timestamps; -1 if there is none
+	void *state;
+};
+
+// libpcap (or WinPcap) on a network interface; available on all platforms
+extern struct netBackend netBackendPcap;
+
+// replays the frames in a pcap file, as fast as possible; transmitted frames are discarded
+extern struct netBackend netBackendPcapFile;
+
+// transmitted frames are received in the same process, through a lock-free single-producer single-consumer queue;
+// rxBatch() never waits, and frames are dropped if the queue is full
+extern struct netBackend netBackendLoopback;
+
+#if PACKET_RING_SUPPORTED == 1 && defined(__linux__)
+// TPACKET_V3 receive ring, with transmission on the same AF_PACKET socket; state points to the struct packetRing
+extern struct netBackend netBackendPacketRing;
+
+// packetRingWorkerCount receive threads in a PACKET_FANOUT group, steered by APPID (see packet_ring_start_workers());
+// rxBatch() only waits, and returns the number of frames decoded by all workers since the previous call
+extern struct netBackend netBackendPacketFanout;
+#endif
+
+#if REALTIME_PROFILE_SUPPORTED == 1 && defined(__linux__)
+// AF_PACKET socket without a ring: one system call per frame, but each frame can be read as soon as it is received,
+// whereas TPACKET_V3 blocks are only handed over when full or after PACKET_RING_BLOCK_TIMEOUT; for real-time
+// receive loops which busy-poll (see realtime.h)
+extern struct netBackend netBackendRawSocket;
+#endif
+
+// backend used by interface.c and the generated interface_* functions
+extern struct netBackend *netBackend;
+
+/**
+ * Transmits a single frame. Returns 1 if the frame was sent, or 0 otherwise.
+ */
+int net_backend_send(struct netBackend *backend, const unsigned char *buf, int len);
+
+/**
+ * Returns the number of frames dropped by netBackendLoopback because its queue was full.
+ */
+unsigned long long net_loopback_drops();
+
+#ifdef __cplusplus /* If this is a C++ compiler, end C linkage */
+}
+#endif
+
+#endif
@@ -0,0 +1,118 @@
+/**
+ * Rapid-prototyping protection schemes with IEC 61850
+ *
+ * Copyright (c) 2014 Steven Blair
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef NET_ORDER_H
+#define NET_ORDER_H
+
+#ifdef __cplusplus /* If this is a C++ compiler, use C linkage */
+extern "C" {
+#endif
+
+#include <string.h>
+#include "ctypes.h"
+
+// Typed loads and stores of big-endian (network order) values, for fixed-size fields in packet buffers. Buffers may be
+// unaligned: memcpy() of a constant size is compiled to a single unaligned load or store where the platform allows it,
+// and the byte swap to a single instruction.
+
+#if defined(__GNUC__)
+#define NET_INLINE				static __inline__
+#define NET_BSWAP16(x)			__builtin_bswap16(x)
+#define NET_BSWAP32(x)			__builtin_bswap32(x)
+#define NET_BSWAP64(x)			__builtin_bswap64(x)
+#elif defined(_MSC_VER)
+#include <stdlib.h>
+#define NET_INLINE				static __inline
+#define NET_BSWAP16(x)			_byteswap_ushort(x)
+#define NET_BSWAP32(x)			_byteswap_ulong(x)
+#define NET_BSWAP64(x)			_byteswap_uint64(x)
+#else
+#define NET_INLINE				static
+#define NET_BSWAP16(x)			((unsigned short) ((((x) & 0x00FFU) << 8) | (((x) & 0xFF00U) >> 8)))
+#define NET_BSWAP32(x)			((((x) & 0x000000FFUL) << 24) | (((x) & 0x0000FF00UL) << 8) | (((x) & 0x00FF0000UL) >> 8) | (((x) & 0xFF000000UL) >> 24))
+#define NET_BSWAP64(x)			((((unsigned long long) NET_BSWAP32((unsigned int) (x))) << 32) | (unsigned long long) NET_BSWAP32((unsigned int) ((x) >> 32)))
+#endif
+
+#if PLATFORM_LITTLE_ENDIAN == 1
+#define NET_ORDER16(x)			NET_BSWAP16(x)
+#define NET_ORDER32(x)			NET_BSWAP32(x)
+#define NET_ORDER64(x)			NET_BSWAP64(x)
+#else
+#define NET_ORDER16(x)			(x)
+#define NET_ORDER32(x)			(x)
+#define NET_ORDER64(x)			(x)
+#endif
+
+NET_INLINE void net_store16(unsigned char *buf, unsigned short value) {
+	value = NET_ORDER16(value);
+	memcpy(buf, &value, 2);
+}
+NET_INLINE void net_store32(unsigned char *buf, unsigned int value) {
+	value = NET_ORDER32(value);
+	memcpy(buf, &value, 4);
+}
+NET_INLINE void net_store64(unsigned char *buf, unsigned long long value) {
+	value = NET_ORDER64(value);
+	memcpy(buf, &value, 8);
+}
+NET_INLINE void net_store_float32(unsigned char *buf, float value) {
+	unsigned int bits;
+	memcpy(&bits, &value, 4);
+	net_store32(buf, bits);
+}
+NET_INLINE void net_store_float64(unsigned char *buf, double value) {
+	unsigned long long bits;
+	memcpy(&bits, &value, 8);
+	net_store64(buf, bits);
+}
+
+NET_INLINE unsigned short net_load16(const unsigned char *buf) {
+	unsigned short value;
+	memcpy(&value, buf, 2);
+	return NET_ORDER16(value);
+}
+NET_INLINE unsigned int net_load32(const unsigned char *buf) {
+	unsigned int value;
+	memcpy(&value, buf, 4);
+	return NET_ORDER32(value);
+}
+NET_INLINE unsigned long long net_load64(const unsigned char *buf) {
+	unsigned long long value;
+	memcpy(&value, buf, 8);
+	return NET_ORDER64(value);
+}
+NET_INLINE float net_load_float32(const unsigned char *buf) {
+	unsigned int bits = net_load32(buf);
+	float value;
+	memcpy(&value, &bits, 4);
+	return value;
+}
+NET_INLINE double net_load_float64(const unsigned char *buf) {
+	unsigned long long bits = net_load64(buf);
+	double value;
+	memcpy(&value, &bits, 8);
+	return value;
+}
+
+#ifdef __cplusplus /* If this is a C++ compiler, end C linkage */
+}
+#endif
+
+#endif
@@ -0,0 +1,380 @@
+/**
+ * Rapid-prototyping protection schemes with IEC 61850
+ *
+ * Copyright (c) 2014 Steven Blair
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+
+#include "packetRing.h"
+
+#if PACKET_RING_SUPPORTED == 1 && defined(__linux__)
+
+#include <string.h>
+#include <errno.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/mman.h>
+#include <sys/eventfd.h>
+#include <arpa/inet.h>
+#include <net/if.h>
+#include <linux/if_packet.h>
+#include <linux/if_ether.h>
+#include <linux/filter.h>
+#include <pthread.h>
+#include "latency.h"
+#include "capture.h"
+
+struct packetRingWorker {
+	struct packetRing ring;
+	pthread_t thread;
+};
+
+int packetRingWorkerCount = PACKET_RING_DEFAULT_WORKERS;
+
+static struct packetRingWorker workers[PACKET_RING_MAX_WORKERS];
+static int workersOpened = 0;
+static int workersStarted = 0;
+static volatile int workersRunning = 0;
+static int workersEvent = -1;				// signalled by a worker which decodes frames while workersWaiting is set
+static int workersWaiting = 0;
+
+static struct tpacket_block_desc *packet_ring_block(struct packetRing *ring, unsigned int index) {
+	return (struct tpacket_block_desc *) (ring->map + (unsigned long) index * ring->blockSize);
+}
+
+// block_status is written by the kernel; the barrier ensures the frames are not read before the status
+static int packet_ring_block_ready(struct tpacket_block_desc *block) {
+	int ready = (*(volatile CTYPE_INT32U *) &block->hdr.bh1.block_status & TP_STATUS_USER) != 0;
+
+	__sync_synchronize();
+	return ready;
+}
+
+static void packet_ring_release_block(struct tpacket_block_desc *block) {
+	__sync_synchronize();
+	*(volatile CTYPE_INT32U *) &block->hdr.bh1.block_status = TP_STATUS_KERNEL;
+}
+
+// fanout is the PACKET_FANOUT option value, or 0 if the socket should receive all frames
+static int packet_ring_open_socket(struct packetRing *ring, const char *interfaceName, int fanout) {
+	int version = TPACKET_V3;
+	struct tpacket_req3 req;
+	struct sockaddr_ll addr;
+	struct packet_mreq mreq;
+	int ifindex = (int) if_nametoindex(interfaceName);
+
+	memset(ring, 0, sizeof(struct packetRing));
+	ring->fd = -1;
+
+	if (ifindex == 0) {
+		return -1;
+	}
+
+	ring->fd = socket(AF_PACKET, SOCK_RAW, htons(ETH_P_ALL));
+	if (ring->fd < 0) {
+		return -1;
+	}
+
+	if (setsockopt(ring->fd, SOL_PACKET, PACKET_VERSION, &version, sizeof(version)) != 0) {
+		packet_ring_close(ring);
+		return -1;
+	}
+
+	memset(&req, 0, sizeof(req));
+	req.tp_block_size = PACKET_RING_BLOCK_SIZE;
+	req.tp_block_nr = PACKET_RING_BLOCK_COUNT;
+	req.tp_frame_size = PACKET_RING_FRAME_SIZE;
+	req.tp_frame_nr = (PACKET_RING_BLOCK_SIZE / PACKET_RING_FRAME_SIZE) * PACKET_RING_BLOCK_COUNT;
+	req.tp_retire_blk_tov = PACKET_RING_BLOCK_TIMEOUT;
+	if (setsockopt(ring->fd, SOL_PACKET, PACKET_RX_RING, &req, sizeof(req)) != 0) {
+		packet_ring_close(ring);
+		return -1;
+	}
+
+	ring->blockSize = req.tp_block_size;
+	ring->blockCount = req.tp_block_nr;
+	ring->mapSize = req.tp_block_size * req.tp_block_nr;
+	ring->map = (unsigned char *) mmap(NULL, ring->mapSize, PROT_READ | PROT_WRITE, MAP_SHARED, ring->fd, 0);
+	if (ring->map == MAP_FAILED) {
+		ring->map = NULL;
+		packet_ring_close(ring);
+		return -1;
+	}
+
+	memset(&addr, 0, sizeof(addr));
+	addr.sll_family = AF_PACKET;
+	addr.sll_protocol = htons(ETH_P_ALL);
+	addr.sll_ifindex = ifindex;
+	if (bind(ring->fd, (struct sockaddr *) &addr, sizeof(addr)) != 0) {
+		packet_ring_close(ring);
+		return -1;
+	}
+
+	// GSE and SV use multicast destination addresses, which are not received unless in promiscuous mode
+	memset(&mreq, 0, sizeof(mreq));
+	mreq.mr_ifindex = ifindex;
+	mreq.mr_type = PACKET_MR_PROMISC;
+	setsockopt(ring->fd, SOL_PACKET, PACKET_ADD_MEMBERSHIP, &mreq, sizeof(mreq));
+
+	// the socket must be bound before joining a fanout group
+	if (fanout != 0 && setsockopt(ring->fd, SOL_PACKET, PACKET_FANOUT, &fanout, sizeof(fanout)) != 0) {
+		packet_ring_close(ring);
+		return -1;
+	}
+
+	return 0;
+}
+
+int packet_ring_open(struct packetRing *ring, const char *interfaceName) {
+	return packet_ring_open_socket(ring, interfaceName, 0);
+}
+
+void packet_ring_close(struct packetRing *ring) {
+	if (ring->map != NULL) {
+		munmap(ring->map, ring->mapSize);
+		ring->map = NULL;
+	}
+	if (ring->fd >= 0) {
+		close(ring->fd);
+		ring->fd = -1;
+	}
+}
+
+static int packet_ring_process_block(struct tpacket_block_desc *block) {
+	struct tpacket3_hdr *frame = (struct tpacket3_hdr *) ((unsigned char *) block + block->hdr.bh1.offset_to_first_pkt);
+	int frames = (int) block->hdr.bh1.num_pkts;
+	int i = 0;
+
+	for (i = 0; i < frames; i++) {
+		LATENCY_FRAME_RECEIVED_NS((unsigned long long) frame->tp_sec * 1000000000ULL + frame->tp_nsec);
+		CAPTURE_RECEIVE_TIME((unsigned long long) frame->tp_sec * 1000000000ULL + frame->tp_nsec);
+		gse_sv_packet_filter((unsigned char *) frame + frame->tp_mac, (int) frame->tp_snaplen);
+
+		frame = (struct tpacket3_hdr *) ((unsigned char *) frame + frame->tp_next_offset);
+	}
+
+	return frames;
+}
+
+int packet_ring_poll(struct packetRing *ring, int timeout) {
+	struct tpacket_block_desc *block = packet_ring_block(ring, ring->currentBlock);
+	unsigned int processed = 0;
+	int frames = 0;
+
+	if (!packet_ring_block_ready(block)) {
+		struct pollfd pfd;
+		int ret = 0;
+
+		// a zero timeout only checks the block status, without a system call, so that the ring can be spun on
+		if (timeout == 0) {
+			return 0;
+		}
+
+		pfd.fd = ring->fd;
+		pfd.events = POLLIN | POLLERR;
+		pfd.revents = 0;
+
+		ret = poll(&pfd, 1, timeout);
+		if (ret < 0) {
+			return (errno == EINTR) ? 0 : -1;
+		}
+
+		// otherwise, transmit timestamps waiting on the socket's error queue (see latency.h) would wake every poll()
+		if ((pfd.revents & POLLERR) != 0) {
+			LATENCY_TRANSMIT_POLL(ring->fd);
+		}
+		if (ret == 0 || !packet_ring_block_ready(block)) {
+			return 0;
+		}
+	}
+
+	// at most one pass around the ring, so that the caller regains control under continuous traffic
+	while (processed < ring->blockCount && packet_ring_block_ready(block)) {
+		frames += packet_ring_process_block(block);
+		packet_ring_release_block(block);
+
+		processed++;
+		ring->currentBlock = (ring->currentBlock + 1) % ring->blockCount;
+		block = packet_ring_block(ring, ring->currentBlock);
+	}
+
+	__atomic_add_fetch(&ring->frames, (unsigned long long) frames, __ATOMIC_SEQ_CST);
+	ring->blocks += processed;
+
+	return frames;
+}
+
+void packet_ring_get_stats(struct packetRing *ring, struct packetRingStats *stats) {
+	struct tpacket_stats_v3 kernelStats;
+	socklen_t len = sizeof(kernelStats);
+	unsigned int i = 0;
+
+	// the kernel resets its counters when they are read, so they are accumulated here
+	memset(&kernelStats, 0, sizeof(kernelStats));
+	if (getsockopt(ring->fd, SOL_PACKET, PACKET_STATISTICS, &kernelStats, &len) == 0) {
+		ring->drops += kernelStats.tp_drops;
+		ring->freezes += kernelStats.tp_freeze_q_cnt;
+	}
+
+	stats->blockCount = ring->blockCount;
+	stats->blocksReady = 0;
+	for (i = 0; i < ring->blockCount; i++) {
+		if (packet_ring_block_ready(packet_ring_block(ring, i))) {
+			stats->blocksReady++;
+		}
+	}
+	stats->frames = __atomic_load_n(&ring->frames, __ATOMIC_SEQ_CST);
+	stats->blocks = ring->blocks;
+	stats->drops = ring->drops;
+	stats->freezes = ring->freezes;
+}
+
+int packet_ring_worker_for_appid(CTYPE_INT16U appID) {
+	return (workersStarted > 0) ? appID % workersStarted : 0;
+}
+
+struct packetRing *packet_ring_get_worker(int worker) {
+	return (worker >= 0 && worker < workersStarted) ? &workers[worker].ring : NULL;
+}
+
+static void *packet_ring_worker_thread(void *arg) {
+	struct packetRingWorker *worker = (struct packetRingWorker *) arg;
+
+	while (workersRunning) {
+		// timeout allows the thread to see that it has been stopped; the waiting thread is only woken if it is waiting,
+		// so that decoding does not need a system call for every block
+		if (packet_ring_poll(&worker->ring, 10) > 0 && __atomic_exchange_n(&workersWaiting, 0, __ATOMIC_SEQ_CST) != 0) {
+			eventfd_write(workersEvent, 1);
+		}
+	}
+
+	return NULL;
+}
+
+static unsigned long long packet_ring_worker_frames() {
+	unsigned long long frames = 0;
+	int i = 0;
+
+	for (i = 0; i < workersStarted; i++) {
+		frames += __atomic_load_n(&workers[i].ring.frames, __ATOMIC_SEQ_CST);
+	}
+
+	return frames;
+}
+
+unsigned long long packet_ring_wait_workers(unsigned long long seen, int timeout) {
+	unsigned long long frames = packet_ring_worker_frames();
+	struct pollfd pfd;
+	eventfd_t value;
+
+	if (frames != seen || timeout == 0 || workersEvent < 0) {
+		return frames;
+	}
+
+	// the frame counters are read again after the flag is set, because a worker only signals if it sees the flag
+	__atomic_store_n(&workersWaiting, 1, __ATOMIC_SEQ_CST);
+	frames = packet_ring_worker_frames();
+	if (frames == seen) {
+		pfd.fd = workersEvent;
+		pfd.events = POLLIN;
+		pfd.revents = 0;
+		if (poll(&pfd, 1, timeout) > 0) {
+			eventfd_read(workersEvent, &value);
+		}
+		frames = packet_ring_worker_frames();
+	}
+	__atomic_store_n(&workersWaiting, 0, __ATOMIC_SEQ_CST);
+
+	return frames;
+}
+
+int packet_ring_start_workers(const char *interfaceName, int count) {
+	// classic BPF steering program: returns APPID % count, for frames with or without a VLAN tag
+	struct sock_filter steering[] = {
+		BPF_STMT(BPF_LD | BPF_H | BPF_ABS, 12),					// EtherType
+		BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, 0x8100, 0, 2),
+		BPF_STMT(BPF_LD | BPF_H | BPF_ABS, 18),					// APPID after a VLAN tag
+		BPF_JUMP(BPF_JMP | BPF_JA, 1, 0, 0),
+		BPF_STMT(BPF_LD | BPF_H | BPF_ABS, 14),					// APPID
+		BPF_STMT(BPF_ALU | BPF_MOD | BPF_K, (CTYPE_INT32U) count),
+		BPF_STMT(BPF_RET | BPF_A, 0)
+	};
+	struct sock_fprog program;
+	int fanout = (getpid() & 0xFFFF) | (PACKET_FANOUT_CBPF << 16);
+	int i = 0;
+
+	if (count < 1 || count > PACKET_RING_MAX_WORKERS || workersOpened > 0) {
+		return -1;
+	}
+
+	for (i = 0; i < count; i++) {
+		if (packet_ring_open_socket(&workers[i].ring, interfaceName, fanout) != 0) {
+			break;
+		}
+
+		// the steering program is shared by the group, so it is set once, when the group is created
+		if (i == 0) {
+			program.len = sizeof(steering) / sizeof(steering[0]);
+			program.filter = steering;
+			if (setsockopt(workers[0].ring.fd, SOL_PACKET, PACKET_FANOUT_DATA, &program, sizeof(program)) != 0) {
+				packet_ring_close(&workers[0].ring);
+				break;
+			}
+		}
+	}
+
+	if (i < count) {
+		while (--i >= 0) {
+			packet_ring_close(&workers[i].ring);
+		}
+		return -1;
+	}
+
+	workersEvent = eventfd(0, EFD_NONBLOCK);
+	workersOpened = count;
+	workersRunning = 1;
+	for (workersStarted = 0; workersStarted < count; workersStarted++) {
+		if (pthread_create(&workers[workersStarted].thread, NULL, packet_ring_worker_thread, &workers[workersStarted]) != 0) {
+			packet_ring_stop_workers();
+			return -1;
+		}
+	}
+
+	return 0;
+}
+
+void packet_ring_stop_workers() {
+	int i = 0;
+
+	workersRunning = 0;
+	for (i = 0; i < workersStarted; i++) {
+		pthread_join(workers[i].thread, NULL);
+	}
+	for (i = 0; i < workersOpened; i++) {
+		packet_ring_close(&workers[i].ring);
+	}
+	if (workersEvent >= 0) {
+		close(workersEvent);
+		workersEvent = -1;
+	}
+
+	workersOpened = 0;
+	workersStarted = 0;
+}
+
+#endif
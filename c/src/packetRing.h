@@ -0,0 +1,118 @@
+/**
+ * Rapid-prototyping protection schemes with IEC 61850
+ *
+ * Copyright (c) 2014 Steven Blair
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+
+#ifndef PACKET_RING_H
+#define PACKET_RING_H
+
+#ifdef __cplusplus /* If this is a C++ compiler, use C linkage */
+extern "C" {
+#endif
+
+#include "ctypes.h"
+
+#if PACKET_RING_SUPPORTED == 1 && defined(__linux__)
+
+#define PACKET_RING_BLOCK_SIZE		(1 << 16)	// must be a multiple of the page size
+#define PACKET_RING_BLOCK_COUNT		64
+#define PACKET_RING_FRAME_SIZE		2048		// only used by the kernel to check the ring geometry
+#define PACKET_RING_BLOCK_TIMEOUT	1			// ms before the kernel hands over a partially-filled block
+#define PACKET_RING_MAX_WORKERS		16
+#define PACKET_RING_DEFAULT_WORKERS	4
+
+// Linux AF_PACKET receive ring, using TPACKET_V3. The kernel writes received frames directly into blocks of memory
+// shared with the process, so a whole block of frames is decoded without any system calls or copies. Transmission
+// still uses libpcap.
+struct packetRing {
+	int fd;
+	unsigned char *map;
+	unsigned int mapSize;
+	unsigned int blockSize;
+	unsigned int blockCount;
+	unsigned int currentBlock;
+	unsigned long long frames;			// updated with __atomic operations, as it is read by other threads
+	unsigned long long blocks;
+	unsigned long long drops;
+	unsigned long long freezes;
+};
+
+struct packetRingStats {
+	unsigned int blockCount;		// size of the ring
+	unsigned int blocksReady;		// filled blocks waiting to be processed (ring occupancy)
+	unsigned long long frames;		// frames passed to gse_sv_packet_filter()
+	unsigned long long blocks;		// blocks processed
+	unsigned long long drops;		// frames dropped by the kernel because the ring was full
+	unsigned long long freezes;		// number of times the ring became full
+};
+
+/**
+ * Opens a TPACKET_V3 receive ring on the named network interface, in promiscuous mode. Returns 0 on success, or -1 if
+ * the ring could not be created (e.g., without CAP_NET_RAW), in which case the caller should fall back to libpcap.
+ */
+int packet_ring_open(struct packetRing *ring, const char *interfaceName);
+void packet_ring_close(struct packetRing *ring);
+
+/**
+ * Waits for up to timeout ms (or indefinitely, if timeout is negative) for a filled block, and then passes every frame
+ * in all filled blocks to gse_sv_packet_filter(). Returns the number of frames processed, 0 on timeout, or -1 on error.
+ * A zero timeout only checks the ring, without a system call.
+ */
+int packet_ring_poll(struct packetRing *ring, int timeout);
+
+/**
+ * Reads the ring occupancy and the kernel drop counters.
+ */
+void packet_ring_get_stats(struct packetRing *ring, struct packetRingStats *stats);
+
+extern int packetRingWorkerCount;		// number of receive threads started by netBackendPacketFanout
+
+/**
+ * Starts count receive threads, each with its own ring in a PACKET_FANOUT group on the named interface. A classic BPF
+ * program steers each frame to worker (APPID % count), so all frames of a control block are decoded by the same
+ * thread. Subscriptions to control blocks with different workers never share a thread, and their inputs need no
+ * locks; datasetDecodeDone() callbacks are called from the worker threads. Returns 0 on success, or -1 on failure
+ * (e.g., kernels before 4.3 do not support PACKET_FANOUT_CBPF).
+ */
+int packet_ring_start_workers(const char *interfaceName, int count);
+void packet_ring_stop_workers();
+
+/**
+ * Waits for up to timeout ms (or indefinitely, if timeout is negative) until the workers have decoded more than seen
+ * frames in total, and returns the total. A zero timeout returns immediately.
+ */
+unsigned long long packet_ring_wait_workers(unsigned long long seen, int timeout);
+
+/**
+ * Returns the worker thread which decodes frames with the given APPID.
+ */
+int packet_ring_worker_for_appid(CTYPE_INT16U appID);
+
+/**
+ * Returns the ring of a worker thread, for packet_ring_get_stats(), or NULL if there is no such worker.
+ */
+struct packetRing *packet_ring_get_worker(int worker);
+
+#endif
+
+#ifdef __cplusplus /* If this is a C++ compiler, end C linkage */
+}
+#endif
+
+#endif
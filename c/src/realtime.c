@@ -0,0 +1,162 @@
+/**
+ * Rapid-prototyping protection schemes with IEC 61850
+ *
+ * Copyright (c) 2014 Steven Blair
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE		// for pthread_setaffinity_np()
+#endif
+
+#include "realtime.h"
+
+#if REALTIME_PROFILE_SUPPORTED == 1 && defined(__linux__)
+
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <malloc.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+
+#ifndef SO_BUSY_POLL
+#define SO_BUSY_POLL				46
+#endif
+
+static void realtime_prefault_stack() {
+	volatile unsigned char stack[REALTIME_STACK_PREFAULT];
+	unsigned int i = 0;
+
+	for (i = 0; i < sizeof(stack); i += 4096) {
+		stack[i] = 0;
+	}
+}
+
+int realtime_lock_memory() {
+	if (mlockall(MCL_CURRENT | MCL_FUTURE) != 0) {
+		perror("mlockall");
+		return -1;
+	}
+
+	// memory which is freed stays in the process, and is never given back with munmap() or sbrk()
+	mallopt(M_TRIM_THRESHOLD, -1);
+	mallopt(M_MMAP_MAX, 0);
+
+	realtime_prefault_stack();
+
+	return 0;
+}
+
+void realtime_prefault(void *buf, unsigned int len) {
+	volatile unsigned char *bytes = (volatile unsigned char *) buf;
+	unsigned int i = 0;
+
+	for (i = 0; i < len; i += 4096) {
+		bytes[i] = bytes[i];
+	}
+	if (len > 0) {
+		bytes[len - 1] = bytes[len - 1];
+	}
+}
+
+int realtime_configure_thread(int cpu, int priority) {
+	int ret = 0;
+
+	if (cpu >= 0) {
+		cpu_set_t cpus;
+
+		CPU_ZERO(&cpus);
+		CPU_SET(cpu, &cpus);
+		if (pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus) != 0) {
+			fprintf(stderr, "Unable to pin thread to CPU %d\n", cpu);
+			ret = -1;
+		}
+	}
+
+	if (priority > 0) {
+		struct sched_param param;
+
+		memset(&param, 0, sizeof(param));
+		param.sched_priority = priority;
+		if (pthread_setschedparam(pthread_self(), SCHED_FIFO, &param) != 0) {
+			fprintf(stderr, "Unable to set SCHED_FIFO priority %d (requires CAP_SYS_NICE)\n", priority);
+			ret = -1;
+		}
+	}
+
+	return ret;
+}
+
+int realtime_enable_busy_poll(int fd, int microseconds) {
+	if (setsockopt(fd, SOL_SOCKET, SO_BUSY_POLL, &microseconds, sizeof(microseconds)) != 0) {
+		perror("SO_BUSY_POLL");
+		return -1;
+	}
+#ifdef SO_PREFER_BUSY_POLL
+	{
+		int prefer = 1;
+		setsockopt(fd, SOL_SOCKET, SO_PREFER_BUSY_POLL, &prefer, sizeof(prefer));	// only available from Linux 5.11
+	}
+#endif
+
+	return 0;
+}
+
+int realtime_apply_rx(const struct realtimeProfile *profile, struct netBackend *backend) {
+	int failures = 0;
+
+	// the thread is pinned first, so that the stack is prefaulted on the CPU (and NUMA node) which will use it
+	if (realtime_configure_thread(profile->rxCpu, profile->rxPriority) != 0) {
+		failures++;
+	}
+	if (profile->lockMemory && realtime_lock_memory() != 0) {
+		failures++;
+	}
+	if (profile->busyPollMicroseconds > 0 && backend->fd >= 0 && realtime_enable_busy_poll(backend->fd, profile->busyPollMicroseconds) != 0) {
+		failures++;
+	}
+
+	return failures;
+}
+
+int realtime_apply_tx(const struct realtimeProfile *profile) {
+	if (profile->lockMemory) {
+		realtime_prefault_stack();
+	}
+
+	return realtime_configure_thread(profile->txCpu, profile->txPriority);
+}
+
+unsigned long long realtime_receive_loop(struct netBackend *backend, volatile int *running) {
+	unsigned long long frames = 0;
+	int ret = 0;
+
+	while (*running) {
+		ret = backend->rxBatch(backend, 0);
+		if (ret < 0) {
+			break;
+		}
+		frames += (unsigned long long) ret;
+	}
+
+	return frames;
+}
+
+#endif
@@ -0,0 +1,99 @@
+/**
+ * Rapid-prototyping protection schemes with IEC 61850
+ *
+ * Copyright (c) 2014 Steven Blair
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+
+#ifndef REALTIME_H
+#define REALTIME_H
+
+#ifdef __cplusplus /* If this is a C++ compiler, use C linkage */
+extern "C" {
+#endif
+
+#include "ctypes.h"
+#include "netBackend.h"
+
+// Real-time runtime profile for the receive and transmit threads on Linux. For a bounded worst-case reaction time, the
+// receive thread must never take a page fault, be migrated, be preempted by ordinary processes, or sleep waiting for
+// an interrupt. The CPUs given here should be isolated from the scheduler (e.g., with isolcpus= and nohz_full=), and
+// SCHED_FIFO requires CAP_SYS_NICE (or a suitable RLIMIT_RTPRIO).
+
+#if REALTIME_PROFILE_SUPPORTED == 1 && defined(__linux__)
+
+#define REALTIME_STACK_PREFAULT		(256 * 1024)	// bytes of stack touched by realtime_lock_memory()
+
+struct realtimeProfile {
+	int lockMemory;					// non-zero to lock and prefault all memory
+	int rxCpu;						// CPU for the receive thread; -1 to leave the thread unpinned
+	int rxPriority;					// SCHED_FIFO priority (1 to 99) of the receive thread; 0 for the default policy
+	int txCpu;						// CPU for the transmit (application) thread; -1 to leave the thread unpinned
+	int txPriority;					// SCHED_FIFO priority of the transmit thread; 0 for the default policy
+	int busyPollMicroseconds;		// SO_BUSY_POLL time for the receive socket, if the driver supports it; 0 to disable
+};
+
+/**
+ * Locks all present and future memory, so that the data model (which is statically allocated), frame buffers and
+ * receive rings are resident, and prefaults REALTIME_STACK_PREFAULT bytes of the calling thread's stack. Freed heap
+ * memory is kept by the process, rather than being returned and faulted in again. Returns 0 on success, or -1 on
+ * failure.
+ */
+int realtime_lock_memory();
+
+/**
+ * Writes to every page of a buffer, so that it is resident before time-critical processing starts. Needed for memory
+ * which is allocated before realtime_lock_memory() is called but not yet used.
+ */
+void realtime_prefault(void *buf, unsigned int len);
+
+/**
+ * Pins the calling thread to a CPU (unless cpu is negative), and sets its scheduling policy to SCHED_FIFO (unless
+ * priority is 0). Returns 0 on success, or -1 if either step failed.
+ */
+int realtime_configure_thread(int cpu, int priority);
+
+/**
+ * Enables busy-polling of the device queue by system calls on a socket, if the kernel supports it. Returns 0 on
+ * success, or -1 on failure.
+ */
+int realtime_enable_busy_poll(int fd, int microseconds);
+
+/**
+ * Applies the memory, receive thread and socket parts of a profile, from the receive thread. Returns 0 on success, or
+ * the number of steps which failed; the remaining steps are still applied.
+ */
+int realtime_apply_rx(const struct realtimeProfile *profile, struct netBackend *backend);
+
+/**
+ * Applies the transmit thread part of a profile, from the transmit thread. Returns 0 on success, or -1 on failure.
+ */
+int realtime_apply_tx(const struct realtimeProfile *profile);
+
+/**
+ * Receives frames by spinning on backend->rxBatch() with a zero timeout, rather than waiting in the kernel, until
+ * *running is cleared or the backend fails. Returns the number of frames processed.
+ */
+unsigned long long realtime_receive_loop(struct netBackend *backend, volatile int *running);
+
+#endif
+
+#ifdef __cplusplus /* If this is a C++ compiler, end C linkage */
+}
+#endif
+
+#endif
@@ -0,0 +1,105 @@
+/**
+ * Rapid-prototyping protection schemes with IEC 61850
+ *
+ * Copyright (c) 2014 Steven Blair
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+
+#ifndef SEQLOCK_H
+#define SEQLOCK_H
+
+#ifdef __cplusplus /* If this is a C++ compiler, use C linkage */
+extern "C" {
+#endif
+
+#include "ctypes.h"
+
+// Sequence locks for subscribed inputs. The receive thread is the only writer, and never waits; readers copy the
+// values, and retry if the sequence number was odd (a write was in progress) or changed during the copy.
+
+#if INPUT_SEQLOCK_SUPPORTED == 1
+
+#if defined(__GNUC__)
+#define SEQLOCK_INLINE				static __inline__
+#define SEQLOCK_BARRIER()			__sync_synchronize()
+#elif defined(_MSC_VER)
+#include <intrin.h>
+#define SEQLOCK_INLINE				static __inline
+#define SEQLOCK_BARRIER()			_ReadWriteBarrier()		// x86 does not reorder loads with loads, or stores with stores
+#else
+#define SEQLOCK_INLINE				static
+#define SEQLOCK_BARRIER()
+#endif
+
+struct seqlock {
+	volatile CTYPE_INT32U sequence;
+};
+
+// if a previous write was not ended (e.g., an SV frame with fewer ASDUs than expected), it is ended first, so that the
+// sequence number is always odd during a write
+SEQLOCK_INLINE void seqlock_write_begin(struct seqlock *lock) {
+	if (lock->sequence & 1) {
+		lock->sequence++;
+	}
+	lock->sequence++;
+	SEQLOCK_BARRIER();
+}
+
+// does nothing if no write is in progress, so that all ASDUs of an SV frame can be published together by ending the
+// write after the last ASDU, or after the frame if it was truncated
+SEQLOCK_INLINE void seqlock_write_end(struct seqlock *lock) {
+	if (lock->sequence & 1) {
+		SEQLOCK_BARRIER();
+		lock->sequence++;
+	}
+}
+
+SEQLOCK_INLINE CTYPE_INT32U seqlock_read_begin(struct seqlock *lock) {
+	CTYPE_INT32U sequence = lock->sequence;
+
+	while (sequence & 1) {
+		sequence = lock->sequence;
+	}
+	SEQLOCK_BARRIER();
+
+	return sequence;
+}
+
+SEQLOCK_INLINE int seqlock_read_retry(struct seqlock *lock, CTYPE_INT32U sequence) {
+	SEQLOCK_BARRIER();
+	return lock->sequence != sequence;
+}
+
+#define SEQLOCK_WRITE_BEGIN(lock)				seqlock_write_begin(lock)
+#define SEQLOCK_WRITE_END(lock)					seqlock_write_end(lock)
+#define SEQLOCK_READ_BEGIN(lock)				seqlock_read_begin(lock)
+#define SEQLOCK_READ_RETRY(lock, sequence)		seqlock_read_retry(lock, sequence)
+
+#else
+
+#define SEQLOCK_WRITE_BEGIN(lock)
+#define SEQLOCK_WRITE_END(lock)
+#define SEQLOCK_READ_BEGIN(lock)				(0)
+#define SEQLOCK_READ_RETRY(lock, sequence)		((void) (sequence), 0)
+
+#endif
+
+#ifdef __cplusplus /* If this is a C++ compiler, end C linkage */
+}
+#endif
+
+#endif
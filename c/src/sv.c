@@ -25,6 +25,117 @@
 #include "svEncode.h"
 
 
+#define SV_FRAME_LENGTH_E1Q1SB1_C1_PerformanceSV				(SV_FRAME_HEADER_LENGTH + 117)
+#define SV_FRAME_DATA_SIZE_E1Q1SB1_C1_PerformanceSV			72
+#define SV_FRAME_SMPCNT_OFFSET_E1Q1SB1_C1_PerformanceSV(asdu)	(SV_FRAME_HEADER_LENGTH + 32 + (asdu) * 102)
+#define SV_FRAME_SMPSYNCH_OFFSET_E1Q1SB1_C1_PerformanceSV(asdu)	(SV_FRAME_HEADER_LENGTH + 42 + (asdu) * 102)
+#define SV_FRAME_DATA_OFFSET_E1Q1SB1_C1_PerformanceSV(asdu)		(SV_FRAME_HEADER_LENGTH + 45 + (asdu) * 102)
+
+static const unsigned char sv_frame_E1Q1SB1_C1_PerformanceSV[SV_FRAME_LENGTH_E1Q1SB1_C1_PerformanceSV] = {
+	0x01, 0x0C, 0xCD, 0x04, 0x00, 0x01, 					// destination MAC address
+	LOCAL_MAC_ADDRESS_BYTES,							// source MAC address
+#if SV_USE_VLAN == 1
+	0x81, 0x00, 0x81, 0x23,							// VLAN tag
+#endif
+	0x88, 0xBA,										// EtherType
+	0x40, 0x00, 0x00, 0x75, 0x00, 0x00, 0x00, 0x00,	// APPID, length, reserved
+	0x60, 0x6B, 0x80, 0x01, 0x01, 0xA2, 0x66,	// savPdu, noASDU, sequence of ASDU
+	0x30, 0x64, 0x80, 0x0B, 0x50, 0x65, 0x72, 0x66, 0x6F, 0x72, 0x6D, 0x61, 0x6E, 0x63, 0x65, 0x82, 0x02, 0x00, 0x00, 0x83, 0x04, 0x00, 0x00, 0x00, 0x01, 0x85, 0x01, 0x01, 0x87, 0x48,	// ASDU 0
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+};
+
+#define SV_FRAME_LENGTH_E1Q1SB1_C1_Volt				(SV_FRAME_HEADER_LENGTH + 113)
+#define SV_FRAME_DATA_SIZE_E1Q1SB1_C1_Volt			28
+#define SV_FRAME_SMPCNT_OFFSET_E1Q1SB1_C1_Volt(asdu)	(SV_FRAME_HEADER_LENGTH + 23 + (asdu) * 49)
+#define SV_FRAME_SMPSYNCH_OFFSET_E1Q1SB1_C1_Volt(asdu)	(SV_FRAME_HEADER_LENGTH + 33 + (asdu) * 49)
+#define SV_FRAME_DATA_OFFSET_E1Q1SB1_C1_Volt(asdu)		(SV_FRAME_HEADER_LENGTH + 36 + (asdu) * 49)
+
+static const unsigned char sv_frame_E1Q1SB1_C1_Volt[SV_FRAME_LENGTH_E1Q1SB1_C1_Volt] = {
+	0x01, 0x0C, 0xCD, 0x04, 0x00, 0x01, 					// destination MAC address
+	LOCAL_MAC_ADDRESS_BYTES,							// source MAC address
+#if SV_USE_VLAN == 1
+	0x81, 0x00, 0x81, 0x23,							// VLAN tag
+#endif
+	0x88, 0xBA,										// EtherType
+	0x40, 0x00, 0x00, 0x71, 0x00, 0x00, 0x00, 0x00,	// APPID, length, reserved
+	0x60, 0x67, 0x80, 0x01, 0x02, 0xA2, 0x62,	// savPdu, noASDU, sequence of ASDU
+	0x30, 0x2F, 0x80, 0x02, 0x31, 0x31, 0x82, 0x02, 0x00, 0x00, 0x83, 0x04, 0x00, 0x00, 0x00, 0x01, 0x85, 0x01, 0x01, 0x87, 0x1C,	// ASDU 0
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x30, 0x2F, 0x80, 0x02, 0x31, 0x31, 0x82, 0x02, 0x00, 0x00, 0x83, 0x04, 0x00, 0x00, 0x00, 0x01, 0x85, 0x01, 0x01, 0x87, 0x1C,	// ASDU 1
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+};
+
+#define SV_FRAME_LENGTH_E1Q1SB1_C1_rmxuCB				(SV_FRAME_HEADER_LENGTH + 771)
+#define SV_FRAME_DATA_SIZE_E1Q1SB1_C1_rmxuCB			24
+#define SV_FRAME_SMPCNT_OFFSET_E1Q1SB1_C1_rmxuCB(asdu)	(SV_FRAME_HEADER_LENGTH + 29 + (asdu) * 47)
+#define SV_FRAME_SMPSYNCH_OFFSET_E1Q1SB1_C1_rmxuCB(asdu)	(SV_FRAME_HEADER_LENGTH + 39 + (asdu) * 47)
+#define SV_FRAME_DATA_OFFSET_E1Q1SB1_C1_rmxuCB(asdu)		(SV_FRAME_HEADER_LENGTH + 42 + (asdu) * 47)
+
+static const unsigned char sv_frame_E1Q1SB1_C1_rmxuCB[SV_FRAME_LENGTH_E1Q1SB1_C1_rmxuCB] = {
+	0x01, 0x0C, 0xCD, 0x04, 0x00, 0x01, 					// destination MAC address
+	LOCAL_MAC_ADDRESS_BYTES,							// source MAC address
+#if SV_USE_VLAN == 1
+	0x81, 0x00, 0x81, 0x23,							// VLAN tag
+#endif
+	0x88, 0xBA,										// EtherType
+	0x40, 0x00, 0x03, 0x03, 0x00, 0x00, 0x00, 0x00,	// APPID, length, reserved
+	0x60, 0x82, 0x02, 0xF7, 0x80, 0x01, 0x10, 0xA2, 0x82, 0x02, 0xF0,	// savPdu, noASDU, sequence of ASDU
+	0x30, 0x2D, 0x80, 0x04, 0x72, 0x6D, 0x78, 0x75, 0x82, 0x02, 0x00, 0x00, 0x83, 0x04, 0x00, 0x00, 0x00, 0x01, 0x85, 0x01, 0x01, 0x87, 0x18,	// ASDU 0
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x30, 0x2D, 0x80, 0x04, 0x72, 0x6D, 0x78, 0x75, 0x82, 0x02, 0x00, 0x00, 0x83, 0x04, 0x00, 0x00, 0x00, 0x01, 0x85, 0x01, 0x01, 0x87, 0x18,	// ASDU 1
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x30, 0x2D, 0x80, 0x04, 0x72, 0x6D, 0x78, 0x75, 0x82, 0x02, 0x00, 0x00, 0x83, 0x04, 0x00, 0x00, 0x00, 0x01, 0x85, 0x01, 0x01, 0x87, 0x18,	// ASDU 2
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x30, 0x2D, 0x80, 0x04, 0x72, 0x6D, 0x78, 0x75, 0x82, 0x02, 0x00, 0x00, 0x83, 0x04, 0x00, 0x00, 0x00, 0x01, 0x85, 0x01, 0x01, 0x87, 0x18,	// ASDU 3
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x30, 0x2D, 0x80, 0x04, 0x72, 0x6D, 0x78, 0x75, 0x82, 0x02, 0x00, 0x00, 0x83, 0x04, 0x00, 0x00, 0x00, 0x01, 0x85, 0x01, 0x01, 0x87, 0x18,	// ASDU 4
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x30, 0x2D, 0x80, 0x04, 0x72, 0x6D, 0x78, 0x75, 0x82, 0x02, 0x00, 0x00, 0x83, 0x04, 0x00, 0x00, 0x00, 0x01, 0x85, 0x01, 0x01, 0x87, 0x18,	// ASDU 5
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x30, 0x2D, 0x80, 0x04, 0x72, 0x6D, 0x78, 0x75, 0x82, 0x02, 0x00, 0x00, 0x83, 0x04, 0x00, 0x00, 0x00, 0x01, 0x85, 0x01, 0x01, 0x87, 0x18,	// ASDU 6
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x30, 0x2D, 0x80, 0x04, 0x72, 0x6D, 0x78, 0x75, 0x82, 0x02, 0x00, 0x00, 0x83, 0x04, 0x00, 0x00, 0x00, 0x01, 0x85, 0x01, 0x01, 0x87, 0x18,	// ASDU 7
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x30, 0x2D, 0x80, 0x04, 0x72, 0x6D, 0x78, 0x75, 0x82, 0x02, 0x00, 0x00, 0x83, 0x04, 0x00, 0x00, 0x00, 0x01, 0x85, 0x01, 0x01, 0x87, 0x18,	// ASDU 8
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x30, 0x2D, 0x80, 0x04, 0x72, 0x6D, 0x78, 0x75, 0x82, 0x02, 0x00, 0x00, 0x83, 0x04, 0x00, 0x00, 0x00, 0x01, 0x85, 0x01, 0x01, 0x87, 0x18,	// ASDU 9
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x30, 0x2D, 0x80, 0x04, 0x72, 0x6D, 0x78, 0x75, 0x82, 0x02, 0x00, 0x00, 0x83, 0x04, 0x00, 0x00, 0x00, 0x01, 0x85, 0x01, 0x01, 0x87, 0x18,	// ASDU 10
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x30, 0x2D, 0x80, 0x04, 0x72, 0x6D, 0x78, 0x75, 0x82, 0x02, 0x00, 0x00, 0x83, 0x04, 0x00, 0x00, 0x00, 0x01, 0x85, 0x01, 0x01, 0x87, 0x18,	// ASDU 11
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x30, 0x2D, 0x80, 0x04, 0x72, 0x6D, 0x78, 0x75, 0x82, 0x02, 0x00, 0x00, 0x83, 0x04, 0x00, 0x00, 0x00, 0x01, 0x85, 0x01, 0x01, 0x87, 0x18,	// ASDU 12
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x30, 0x2D, 0x80, 0x04, 0x72, 0x6D, 0x78, 0x75, 0x82, 0x02, 0x00, 0x00, 0x83, 0x04, 0x00, 0x00, 0x00, 0x01, 0x85, 0x01, 0x01, 0x87, 0x18,	// ASDU 13
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x30, 0x2D, 0x80, 0x04, 0x72, 0x6D, 0x78, 0x75, 0x82, 0x02, 0x00, 0x00, 0x83, 0x04, 0x00, 0x00, 0x00, 0x01, 0x85, 0x01, 0x01, 0x87, 0x18,	// ASDU 14
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x30, 0x2D, 0x80, 0x04, 0x72, 0x6D, 0x78, 0x75, 0x82, 0x02, 0x00, 0x00, 0x83, 0x04, 0x00, 0x00, 0x00, 0x01, 0x85, 0x01, 0x01, 0x87, 0x18,	// ASDU 15
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+};
+
 
 
 
@@ -43,6 +154,21 @@ int sv_update_E1Q1SB1_C1_PerformanceSV(unsigned char *buf) {
 
 	if (++E1Q1SB1.S1.C1.LN0.PerformanceSV.ASDUCount == E1Q1SB1.S1.C1.LN0.PerformanceSV.noASDU) {
 		E1Q1SB1.S1.C1.LN0.PerformanceSV.ASDUCount = 0;
+#if SV_CONSTANT_FRAME_LAYOUT == 1
+		if (E1Q1SB1.S1.C1.LN0.PerformanceSV.ASDU[0].data.size == SV_FRAME_DATA_SIZE_E1Q1SB1_C1_PerformanceSV) {
+			int i = 0;
+			memcpy(buf, sv_frame_E1Q1SB1_C1_PerformanceSV, SV_FRAME_LENGTH_E1Q1SB1_C1_PerformanceSV);
+
+			for (i = 0; i < 1; i++) {
+				net_store16(&buf[SV_FRAME_SMPCNT_OFFSET_E1Q1SB1_C1_PerformanceSV(i)], E1Q1SB1.S1.C1.LN0.PerformanceSV.ASDU[i].smpCnt);
+				buf[SV_FRAME_SMPSYNCH_OFFSET_E1Q1SB1_C1_PerformanceSV(i)] = E1Q1SB1.S1.C1.LN0.PerformanceSV.ASDU[i].smpSynch;
+				memcpy(&buf[SV_FRAME_DATA_OFFSET_E1Q1SB1_C1_PerformanceSV(i)], E1Q1SB1.S1.C1.LN0.PerformanceSV.ASDU[i].data.data, SV_FRAME_DATA_SIZE_E1Q1SB1_C1_PerformanceSV);
+			}
+
+			return SV_FRAME_LENGTH_E1Q1SB1_C1_PerformanceSV;
+		}
+#endif
+
 		return svEncodePacket(&E1Q1SB1.S1.C1.LN0.PerformanceSV, buf);
 	}
 
@@ -63,6 +189,21 @@ int sv_update_E1Q1SB1_C1_Volt(unsigned char *buf) {
 
 	if (++E1Q1SB1.S1.C1.LN0.Volt.ASDUCount == E1Q1SB1.S1.C1.LN0.Volt.noASDU) {
 		E1Q1SB1.S1.C1.LN0.Volt.ASDUCount = 0;
+#if SV_CONSTANT_FRAME_LAYOUT == 1
+		if (E1Q1SB1.S1.C1.LN0.Volt.ASDU[0].data.size == SV_FRAME_DATA_SIZE_E1Q1SB1_C1_Volt) {
+			int i = 0;
+			memcpy(buf, sv_frame_E1Q1SB1_C1_Volt, SV_FRAME_LENGTH_E1Q1SB1_C1_Volt);
+
+			for (i = 0; i < 2; i++) {
+				net_store16(&buf[SV_FRAME_SMPCNT_OFFSET_E1Q1SB1_C1_Volt(i)], E1Q1SB1.S1.C1.LN0.Volt.ASDU[i].smpCnt);
+				buf[SV_FRAME_SMPSYNCH_OFFSET_E1Q1SB1_C1_Volt(i)] = E1Q1SB1.S1.C1.LN0.Volt.ASDU[i].smpSynch;
+				memcpy(&buf[SV_FRAME_DATA_OFFSET_E1Q1SB1_C1_Volt(i)], E1Q1SB1.S1.C1.LN0.Volt.ASDU[i].data.data, SV_FRAME_DATA_SIZE_E1Q1SB1_C1_Volt);
+			}
+
+			return SV_FRAME_LENGTH_E1Q1SB1_C1_Volt;
+		}
+#endif
+
 		return svEncodePacket(&E1Q1SB1.S1.C1.LN0.Volt, buf);
 	}
 
@@ -83,6 +224,21 @@ int sv_update_E1Q1SB1_C1_rmxuCB(unsigned char *buf) {
 
 	if (++E1Q1SB1.S1.C1.LN0.rmxuCB.ASDUCount == E1Q1SB1.S1.C1.LN0.rmxuCB.noASDU) {
 		E1Q1SB1.S1.C1.LN0.rmxuCB.ASDUCount = 0;
+#if SV_CONSTANT_FRAME_LAYOUT == 1
+		if (E1Q1SB1.S1.C1.LN0.rmxuCB.ASDU[0].data.size == SV_FRAME_DATA_SIZE_E1Q1SB1_C1_rmxuCB) {
+			int i = 0;
+			memcpy(buf, sv_frame_E1Q1SB1_C1_rmxuCB, SV_FRAME_LENGTH_E1Q1SB1_C1_rmxuCB);
+
+			for (i = 0; i < 16; i++) {
+				net_store16(&buf[SV_FRAME_SMPCNT_OFFSET_E1Q1SB1_C1_rmxuCB(i)], E1Q1SB1.S1.C1.LN0.rmxuCB.ASDU[i].smpCnt);
+				buf[SV_FRAME_SMPSYNCH_OFFSET_E1Q1SB1_C1_rmxuCB(i)] = E1Q1SB1.S1.C1.LN0.rmxuCB.ASDU[i].smpSynch;
+				memcpy(&buf[SV_FRAME_DATA_OFFSET_E1Q1SB1_C1_rmxuCB(i)], E1Q1SB1.S1.C1.LN0.rmxuCB.ASDU[i].data.data, SV_FRAME_DATA_SIZE_E1Q1SB1_C1_rmxuCB);
+			}
+
+			return SV_FRAME_LENGTH_E1Q1SB1_C1_rmxuCB;
+		}
+#endif
+
 		return svEncodePacket(&E1Q1SB1.S1.C1.LN0.rmxuCB, buf);
 	}
 
@@ -260,36 +260,122 @@ int decode_D1Q1SB4_C1_MMXUResult(unsigned char *buf, CTYPE_INT16U smpCnt, struct
 	return offset;
 }
 
-void svDecodeDataset(unsigned char *dataset, int datasetLength, int ASDU, unsigned char *svID, int svIDLength, CTYPE_INT16U smpCnt) {
+void svDecodeDataset(unsigned char *dataset, int datasetLength, int ASDU, int totalASDUs, unsigned char *svID, int svIDLength, CTYPE_INT16U smpCnt) {
 
-	if (svIDLength == 2 && strncmp((const char *) svID, "11", svIDLength) == 0) {
+	if (svIDLength == 2 && strncmp((const char *) svID, "11", svIDLength) == 0 && ASDU < 2) {
+		if (ASDU == 0) {
+			SEQLOCK_WRITE_BEGIN(&D1Q1SB4.S1.C1.LPHDa_1.sv_inputs_Volt.seqlock);
+		}
 		decode_E1Q1SB1_C1_smv(dataset, smpCnt, &D1Q1SB4.S1.C1.LPHDa_1.sv_inputs_Volt.E1Q1SB1_C1_smv[ASDU]);
 		D1Q1SB4.S1.C1.LPHDa_1.sv_inputs_Volt.smpCnt = smpCnt;
+		if (ASDU == totalASDUs - 1 || ASDU == 1) {
+			SEQLOCK_WRITE_END(&D1Q1SB4.S1.C1.LPHDa_1.sv_inputs_Volt.seqlock);
+			EVENT_QUEUE_SV(D1Q1SB4.S1.C1.LPHDa_1.sv_inputs_Volt.eventQueue, &D1Q1SB4.S1.C1.LPHDa_1.sv_inputs_Volt, "D1Q1SB4.S1.C1.LPHDa_1.sv_inputs_Volt", smpCnt);
+		}
+		if (ASDU == 0) {
+			LATENCY_FRAME_DECODED();
+		}
 		if (D1Q1SB4.S1.C1.LPHDa_1.sv_inputs_Volt.datasetDecodeDone != NULL) {
 			D1Q1SB4.S1.C1.LPHDa_1.sv_inputs_Volt.datasetDecodeDone(smpCnt);
 		}
+		if (ASDU == totalASDUs - 1 || ASDU == 1) {
+			LATENCY_FRAME_DONE(&D1Q1SB4.S1.C1.LPHDa_1.sv_inputs_Volt.latency, "D1Q1SB4.S1.C1.LPHDa_1.sv_inputs_Volt");
+		}
 	}
-	if (svIDLength == 4 && strncmp((const char *) svID, "rmxu", svIDLength) == 0) {
+	if (svIDLength == 4 && strncmp((const char *) svID, "rmxu", svIDLength) == 0 && ASDU < 16) {
+		if (ASDU == 0) {
+			SEQLOCK_WRITE_BEGIN(&D1Q1SB4.S1.C1.exampleMMXU_1.sv_inputs_rmxuCB.seqlock);
+		}
 		decode_E1Q1SB1_C1_rmxu(dataset, smpCnt, &D1Q1SB4.S1.C1.exampleMMXU_1.sv_inputs_rmxuCB.E1Q1SB1_C1_rmxu[ASDU]);
 		D1Q1SB4.S1.C1.exampleMMXU_1.sv_inputs_rmxuCB.smpCnt = smpCnt;
+		if (ASDU == totalASDUs - 1 || ASDU == 15) {
+			SEQLOCK_WRITE_END(&D1Q1SB4.S1.C1.exampleMMXU_1.sv_inputs_rmxuCB.seqlock);
+			EVENT_QUEUE_SV(D1Q1SB4.S1.C1.exampleMMXU_1.sv_inputs_rmxuCB.eventQueue, &D1Q1SB4.S1.C1.exampleMMXU_1.sv_inputs_rmxuCB, "D1Q1SB4.S1.C1.exampleMMXU_1.sv_inputs_rmxuCB", smpCnt);
+		}
+		if (ASDU == 0) {
+			LATENCY_FRAME_DECODED();
+		}
 		if (D1Q1SB4.S1.C1.exampleMMXU_1.sv_inputs_rmxuCB.datasetDecodeDone != NULL) {
 			D1Q1SB4.S1.C1.exampleMMXU_1.sv_inputs_rmxuCB.datasetDecodeDone(smpCnt);
 		}
+		if (ASDU == totalASDUs - 1 || ASDU == 15) {
+			LATENCY_FRAME_DONE(&D1Q1SB4.S1.C1.exampleMMXU_1.sv_inputs_rmxuCB.latency, "D1Q1SB4.S1.C1.exampleMMXU_1.sv_inputs_rmxuCB");
+		}
 	}
 	if (svIDLength == 11 && strncmp((const char *) svID, "Performance", svIDLength) == 0) {
+		SEQLOCK_WRITE_BEGIN(&D1Q1SB4.S1.C1.exampleMMXU_1.sv_inputs_PerformanceSV.seqlock);
 		decode_E1Q1SB1_C1_Performance(dataset, smpCnt, &D1Q1SB4.S1.C1.exampleMMXU_1.sv_inputs_PerformanceSV.E1Q1SB1_C1_Performance);
 		D1Q1SB4.S1.C1.exampleMMXU_1.sv_inputs_PerformanceSV.smpCnt = smpCnt;
+		SEQLOCK_WRITE_END(&D1Q1SB4.S1.C1.exampleMMXU_1.sv_inputs_PerformanceSV.seqlock);
+		EVENT_QUEUE_SV(D1Q1SB4.S1.C1.exampleMMXU_1.sv_inputs_PerformanceSV.eventQueue, &D1Q1SB4.S1.C1.exampleMMXU_1.sv_inputs_PerformanceSV, "D1Q1SB4.S1.C1.exampleMMXU_1.sv_inputs_PerformanceSV", smpCnt);
+		LATENCY_FRAME_DECODED();
 		if (D1Q1SB4.S1.C1.exampleMMXU_1.sv_inputs_PerformanceSV.datasetDecodeDone != NULL) {
 			D1Q1SB4.S1.C1.exampleMMXU_1.sv_inputs_PerformanceSV.datasetDecodeDone(smpCnt);
 		}
+		LATENCY_FRAME_DONE(&D1Q1SB4.S1.C1.exampleMMXU_1.sv_inputs_PerformanceSV.latency, "D1Q1SB4.S1.C1.exampleMMXU_1.sv_inputs_PerformanceSV");
 	}
-	if (svIDLength == 2 && strncmp((const char *) svID, "11", svIDLength) == 0) {
+	if (svIDLength == 2 && strncmp((const char *) svID, "11", svIDLength) == 0 && ASDU < 2) {
+		if (ASDU == 0) {
+			SEQLOCK_WRITE_BEGIN(&D1Q1SB4.S1.C1.RSYNa_1.sv_inputs_Volt.seqlock);
+		}
 		decode_E1Q1SB1_C1_smv(dataset, smpCnt, &D1Q1SB4.S1.C1.RSYNa_1.sv_inputs_Volt.E1Q1SB1_C1_smv[ASDU]);
 		D1Q1SB4.S1.C1.RSYNa_1.sv_inputs_Volt.smpCnt = smpCnt;
+		if (ASDU == totalASDUs - 1 || ASDU == 1) {
+			SEQLOCK_WRITE_END(&D1Q1SB4.S1.C1.RSYNa_1.sv_inputs_Volt.seqlock);
+			EVENT_QUEUE_SV(D1Q1SB4.S1.C1.RSYNa_1.sv_inputs_Volt.eventQueue, &D1Q1SB4.S1.C1.RSYNa_1.sv_inputs_Volt, "D1Q1SB4.S1.C1.RSYNa_1.sv_inputs_Volt", smpCnt);
+		}
+		if (ASDU == 0) {
+			LATENCY_FRAME_DECODED();
+		}
 		if (D1Q1SB4.S1.C1.RSYNa_1.sv_inputs_Volt.datasetDecodeDone != NULL) {
 			D1Q1SB4.S1.C1.RSYNa_1.sv_inputs_Volt.datasetDecodeDone(smpCnt);
 		}
+		if (ASDU == totalASDUs - 1 || ASDU == 1) {
+			LATENCY_FRAME_DONE(&D1Q1SB4.S1.C1.RSYNa_1.sv_inputs_Volt.latency, "D1Q1SB4.S1.C1.RSYNa_1.sv_inputs_Volt");
+		}
 	}
 }
 
+void svDecodeFrameDone() {
+	SEQLOCK_WRITE_END(&D1Q1SB4.S1.C1.LPHDa_1.sv_inputs_Volt.seqlock);
+	SEQLOCK_WRITE_END(&D1Q1SB4.S1.C1.exampleMMXU_1.sv_inputs_rmxuCB.seqlock);
+	SEQLOCK_WRITE_END(&D1Q1SB4.S1.C1.RSYNa_1.sv_inputs_Volt.seqlock);
+}
+
+
+void sv_inputs_snapshot_D1Q1SB4_C1_LPHDa_1_Volt(struct E1Q1SB1_C1_smv *E1Q1SB1_C1_smv, CTYPE_INT16U *smpCnt) {
+	CTYPE_INT32U sequence = 0;
 
+	do {
+		sequence = SEQLOCK_READ_BEGIN(&D1Q1SB4.S1.C1.LPHDa_1.sv_inputs_Volt.seqlock);
+		memcpy(E1Q1SB1_C1_smv, &D1Q1SB4.S1.C1.LPHDa_1.sv_inputs_Volt.E1Q1SB1_C1_smv, sizeof(D1Q1SB4.S1.C1.LPHDa_1.sv_inputs_Volt.E1Q1SB1_C1_smv));
+		*smpCnt = D1Q1SB4.S1.C1.LPHDa_1.sv_inputs_Volt.smpCnt;
+	} while (SEQLOCK_READ_RETRY(&D1Q1SB4.S1.C1.LPHDa_1.sv_inputs_Volt.seqlock, sequence));
+}
+void sv_inputs_snapshot_D1Q1SB4_C1_exampleMMXU_1_rmxuCB(struct E1Q1SB1_C1_rmxu *E1Q1SB1_C1_rmxu, CTYPE_INT16U *smpCnt) {
+	CTYPE_INT32U sequence = 0;
+
+	do {
+		sequence = SEQLOCK_READ_BEGIN(&D1Q1SB4.S1.C1.exampleMMXU_1.sv_inputs_rmxuCB.seqlock);
+		memcpy(E1Q1SB1_C1_rmxu, &D1Q1SB4.S1.C1.exampleMMXU_1.sv_inputs_rmxuCB.E1Q1SB1_C1_rmxu, sizeof(D1Q1SB4.S1.C1.exampleMMXU_1.sv_inputs_rmxuCB.E1Q1SB1_C1_rmxu));
+		*smpCnt = D1Q1SB4.S1.C1.exampleMMXU_1.sv_inputs_rmxuCB.smpCnt;
+	} while (SEQLOCK_READ_RETRY(&D1Q1SB4.S1.C1.exampleMMXU_1.sv_inputs_rmxuCB.seqlock, sequence));
+}
+void sv_inputs_snapshot_D1Q1SB4_C1_exampleMMXU_1_PerformanceSV(struct E1Q1SB1_C1_Performance *E1Q1SB1_C1_Performance, CTYPE_INT16U *smpCnt) {
+	CTYPE_INT32U sequence = 0;
+
+	do {
+		sequence = SEQLOCK_READ_BEGIN(&D1Q1SB4.S1.C1.exampleMMXU_1.sv_inputs_PerformanceSV.seqlock);
+		memcpy(E1Q1SB1_C1_Performance, &D1Q1SB4.S1.C1.exampleMMXU_1.sv_inputs_PerformanceSV.E1Q1SB1_C1_Performance, sizeof(D1Q1SB4.S1.C1.exampleMMXU_1.sv_inputs_PerformanceSV.E1Q1SB1_C1_Performance));
+		*smpCnt = D1Q1SB4.S1.C1.exampleMMXU_1.sv_inputs_PerformanceSV.smpCnt;
+	} while (SEQLOCK_READ_RETRY(&D1Q1SB4.S1.C1.exampleMMXU_1.sv_inputs_PerformanceSV.seqlock, sequence));
+}
+void sv_inputs_snapshot_D1Q1SB4_C1_RSYNa_1_Volt(struct E1Q1SB1_C1_smv *E1Q1SB1_C1_smv, CTYPE_INT16U *smpCnt) {
+	CTYPE_INT32U sequence = 0;
+
+	do {
+		sequence = SEQLOCK_READ_BEGIN(&D1Q1SB4.S1.C1.RSYNa_1.sv_inputs_Volt.seqlock);
+		memcpy(E1Q1SB1_C1_smv, &D1Q1SB4.S1.C1.RSYNa_1.sv_inputs_Volt.E1Q1SB1_C1_smv, sizeof(D1Q1SB4.S1.C1.RSYNa_1.sv_inputs_Volt.E1Q1SB1_C1_smv));
+		*smpCnt = D1Q1SB4.S1.C1.RSYNa_1.sv_inputs_Volt.smpCnt;
+	} while (SEQLOCK_READ_RETRY(&D1Q1SB4.S1.C1.RSYNa_1.sv_inputs_Volt.seqlock, sequence));
+}
@@ -38,7 +38,17 @@ int decode_E1Q1SB1_C1_rmxu(unsigned char *buf, CTYPE_INT16U smpCnt, struct E1Q1S
 int decode_D1Q1SB4_C1_SyckResult(unsigned char *buf, CTYPE_INT16U smpCnt, struct D1Q1SB4_C1_SyckResult *D1Q1SB4_C1_SyckResult);
 int decode_D1Q1SB4_C1_MMXUResult(unsigned char *buf, CTYPE_INT16U smpCnt, struct D1Q1SB4_C1_MMXUResult *D1Q1SB4_C1_MMXUResult);
 
-void svDecodeDataset(unsigned char *dataset, int datasetLength, int ASDU, unsigned char *svID, int svIDLength, CTYPE_INT16U smpCnt);
+void svDecodeDataset(unsigned char *dataset, int datasetLength, int ASDU, int totalASDUs, unsigned char *svID, int svIDLength, CTYPE_INT16U smpCnt);
+
+// ends the publication of inputs from a frame which had fewer ASDUs than it declared, e.g., because it was truncated
+void svDecodeFrameDone();
+
+// consistent copies of subscribed inputs, which may be taken from any thread while frames are being decoded (but not
+// from datasetDecodeDone(), which runs on the decoding thread and can read the inputs directly)
+void sv_inputs_snapshot_D1Q1SB4_C1_LPHDa_1_Volt(struct E1Q1SB1_C1_smv *E1Q1SB1_C1_smv, CTYPE_INT16U *smpCnt);
+void sv_inputs_snapshot_D1Q1SB4_C1_exampleMMXU_1_rmxuCB(struct E1Q1SB1_C1_rmxu *E1Q1SB1_C1_rmxu, CTYPE_INT16U *smpCnt);
+void sv_inputs_snapshot_D1Q1SB4_C1_exampleMMXU_1_PerformanceSV(struct E1Q1SB1_C1_Performance *E1Q1SB1_C1_Performance, CTYPE_INT16U *smpCnt);
+void sv_inputs_snapshot_D1Q1SB4_C1_RSYNa_1_Volt(struct E1Q1SB1_C1_smv *E1Q1SB1_C1_smv, CTYPE_INT16U *smpCnt);
 
 
 
@@ -22,24 +22,83 @@
 #define SV_DECODE_BASIC_H
 
 #include "datatypes.h"
+#include "netOrder.h"
 
 #ifdef __cplusplus /* If this is a C++ compiler, use C linkage */
 extern "C" {
 #endif
 
-int DECODE_CTYPE_FLOAT32(unsigned char *buf, CTYPE_FLOAT32 *value);
-int DECODE_CTYPE_FLOAT64(unsigned char *buf, CTYPE_FLOAT64 *value);
-int DECODE_CTYPE_QUALITY(unsigned char *buf, CTYPE_QUALITY *value);
-int DECODE_CTYPE_TIMESTAMP(unsigned char *buf, CTYPE_TIMESTAMP *value);
-int DECODE_CTYPE_ENUM(unsigned char *buf, CTYPE_ENUM *value);
-int DECODE_CTYPE_INT8(unsigned char *buf, CTYPE_INT8 *value) ;
-int DECODE_CTYPE_INT16(unsigned char *buf, CTYPE_INT16 *value);
-int DECODE_CTYPE_INT32(unsigned char *buf, CTYPE_INT32 *value);
-int DECODE_CTYPE_INT16U(unsigned char *buf, CTYPE_INT16U *value);
-int DECODE_CTYPE_INT32U(unsigned char *buf, CTYPE_INT32U *value);
-int DECODE_CTYPE_VISSTRING255(unsigned char *buf, CTYPE_VISSTRING255 *value);
-int DECODE_CTYPE_BOOLEAN(unsigned char *buf, CTYPE_BOOLEAN *value);
-int DECODE_CTYPE_DBPOS(unsigned char *buf, CTYPE_DBPOS *value);
+// SV decoding of basic types. These are inline so that each field of a generated dataset codec compiles to a single load or store
+NET_INLINE int DECODE_CTYPE_FLOAT32(unsigned char *buf, CTYPE_FLOAT32 *value) {
+	*value = net_load_float32(buf);
+
+	return SV_GET_LENGTH_FLOAT32;
+}
+NET_INLINE int DECODE_CTYPE_FLOAT64(unsigned char *buf, CTYPE_FLOAT64 *value) {
+	*value = net_load_float64(buf);
+
+	return SV_GET_LENGTH_FLOAT64;
+}
+NET_INLINE int DECODE_CTYPE_QUALITY(unsigned char *buf, CTYPE_QUALITY *value) {
+	*value = (CTYPE_QUALITY) net_load32(buf);
+
+	return SV_GET_LENGTH_QUALITY;
+}
+NET_INLINE int DECODE_CTYPE_TIMESTAMP(unsigned char *buf, CTYPE_TIMESTAMP *value) {
+	*value = (CTYPE_TIMESTAMP) net_load64(buf);
+
+	return SV_GET_LENGTH_TIMESTAMP;
+}
+NET_INLINE int DECODE_CTYPE_ENUM(unsigned char *buf, CTYPE_ENUM *value) {
+	*value = (CTYPE_ENUM) net_load32(buf);			// assuming enum is an int - allows any enum type to be used
+
+	return SV_GET_LENGTH_ENUM;
+}
+NET_INLINE int DECODE_CTYPE_INT8(unsigned char *buf, CTYPE_INT8 *value) {
+	*value = (CTYPE_INT8) buf[0];
+
+	return SV_GET_LENGTH_INT8;
+}
+NET_INLINE int DECODE_CTYPE_INT16(unsigned char *buf, CTYPE_INT16 *value) {
+	*value = (CTYPE_INT16) net_load16(buf);
+
+	return SV_GET_LENGTH_INT16;
+}
+NET_INLINE int DECODE_CTYPE_INT32(unsigned char *buf, CTYPE_INT32 *value) {
+	*value = (CTYPE_INT32) net_load32(buf);
+
+	return SV_GET_LENGTH_INT32;
+}
+NET_INLINE int DECODE_CTYPE_INT8U(unsigned char *buf, CTYPE_INT8U *value) {
+	*value = buf[0];
+
+	return SV_GET_LENGTH_INT8U;
+}
+NET_INLINE int DECODE_CTYPE_INT16U(unsigned char *buf, CTYPE_INT16U *value) {
+	*value = net_load16(buf);
+
+	return SV_GET_LENGTH_INT16U;
+}
+NET_INLINE int DECODE_CTYPE_INT32U(unsigned char *buf, CTYPE_INT32U *value) {
+	*value = net_load32(buf);
+
+	return SV_GET_LENGTH_INT32U;
+}
+NET_INLINE int DECODE_CTYPE_VISSTRING255(unsigned char *buf, CTYPE_VISSTRING255 *value) {
+	netmemcpy(value, buf, SV_GET_LENGTH_VISSTRING255);
+
+	return SV_GET_LENGTH_VISSTRING255;
+}
+NET_INLINE int DECODE_CTYPE_BOOLEAN(unsigned char *buf, CTYPE_BOOLEAN *value) {
+	*value = buf[0];
+
+	return SV_GET_LENGTH_BOOLEAN;
+}
+NET_INLINE int DECODE_CTYPE_DBPOS(unsigned char *buf, CTYPE_DBPOS *value) {
+	*value = (CTYPE_DBPOS) net_load32(buf);
+
+	return SV_GET_LENGTH_DBPOS;
+}
 
 #ifdef __cplusplus /* If this is a C++ compiler, end C linkage */
 }
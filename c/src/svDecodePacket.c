@@ -27,7 +27,7 @@
 #include <stddef.h>
 
 
-void svDecodeASDU(unsigned char *buf, int len, int noASDU) {
+void svDecodeASDU(unsigned char *buf, int len, int noASDU, int totalASDUs) {
 	unsigned char tag;	// assumes only one byte is used
 	int lengthFieldSize;
 	int lengthValue;
@@ -54,7 +54,7 @@ void svDecodeASDU(unsigned char *buf, int len, int noASDU) {
 
 				break;
 			case SV_TAG_SMPCNT:
-				ber_decode_integer(&buf[i + 1 + lengthFieldSize], lengthValue, &smpCnt, SV_GET_LENGTH_INT16U);
+				smpCnt = ber_decode_integer_int16u(&buf[i + 1 + lengthFieldSize], lengthValue);
 				break;
 			case SV_TAG_CONFREV:
 
@@ -70,7 +70,7 @@ void svDecodeASDU(unsigned char *buf, int len, int noASDU) {
 				break;
 			case SV_TAG_SEQUENCEOFDATA:
 				if (svID != NULL) {
-					svDecodeDataset(&buf[i + 1 + lengthFieldSize], lengthValue, noASDU, svID, svIDLength, smpCnt);
+					svDecodeDataset(&buf[i + 1 + lengthFieldSize], lengthValue, noASDU, totalASDUs, svID, svIDLength, smpCnt);
 				}
 				break;
 			default:
@@ -105,7 +105,7 @@ void svDecodeAPDU(unsigned char *buf, int len, unsigned int ASDU, unsigned int t
 			svDecodeAPDU(&buf[offsetForSequence], lengthValue, ASDU, totalASDUs);
 			break;
 		case SV_TAG_ASDU:
-			svDecodeASDU(&buf[offsetForSequence], lengthValue, ASDU);
+			svDecodeASDU(&buf[offsetForSequence], lengthValue, ASDU, totalASDUs);
 			ASDU++;
 
 			// process any more ASDUs, until max number
@@ -129,4 +129,5 @@ void svDecode(unsigned char *buf, int len) {
 	unsigned short APDULength = ((buf[offset] << 8) | buf[offset + 1]) - 8;    // must use length in PDU because total bytes (len) may contain CRC
 
 	svDecodeAPDU(&buf[offset + 6], APDULength, 0, 0);    // cuts out frame header
+	svDecodeFrameDone();
 }
@@ -22,24 +22,83 @@
 #define SV_ENCODE_BASIC_H
 
 #include "datatypes.h"
+#include "netOrder.h"
 
 #ifdef __cplusplus /* If this is a C++ compiler, use C linkage */
 extern "C" {
 #endif
 
-int ENCODE_CTYPE_FLOAT32(unsigned char *buf, CTYPE_FLOAT32 *value);
-int ENCODE_CTYPE_FLOAT64(unsigned char *buf, CTYPE_FLOAT64 *value);
-int ENCODE_CTYPE_QUALITY(unsigned char *buf, CTYPE_QUALITY *value);
-int ENCODE_CTYPE_TIMESTAMP(unsigned char *buf, CTYPE_TIMESTAMP *value);
-int ENCODE_CTYPE_ENUM(unsigned char *buf, CTYPE_ENUM *value);
-int ENCODE_CTYPE_INT8(unsigned char *buf, CTYPE_INT8 *value);
-int ENCODE_CTYPE_INT16(unsigned char *buf, CTYPE_INT16 *value);
-int ENCODE_CTYPE_INT32(unsigned char *buf, CTYPE_INT32 *value);
-int ENCODE_CTYPE_INT16U(unsigned char *buf, CTYPE_INT16U *value);
-int ENCODE_CTYPE_INT32U(unsigned char *buf, CTYPE_INT32U *value);
-int ENCODE_CTYPE_VISSTRING255(unsigned char *buf, CTYPE_VISSTRING255 *value);
-int ENCODE_CTYPE_BOOLEAN(unsigned char *buf, CTYPE_BOOLEAN *value);
-int ENCODE_CTYPE_DBPOS(unsigned char *buf, CTYPE_DBPOS *value);
+// SV encoding of basic types. These are inline so that each field of a generated dataset codec compiles to a single load or store
+NET_INLINE int ENCODE_CTYPE_FLOAT32(unsigned char *buf, CTYPE_FLOAT32 *value) {
+	net_store_float32(buf, *value);
+
+	return SV_GET_LENGTH_FLOAT32;
+}
+NET_INLINE int ENCODE_CTYPE_FLOAT64(unsigned char *buf, CTYPE_FLOAT64 *value) {
+	net_store_float64(buf, *value);
+
+	return SV_GET_LENGTH_FLOAT64;
+}
+NET_INLINE int ENCODE_CTYPE_QUALITY(unsigned char *buf, CTYPE_QUALITY *value) {
+	net_store32(buf, *value);				// Quality is stored as 16-bit, but SV encoding is 32-bit
+
+	return SV_GET_LENGTH_QUALITY;
+}
+NET_INLINE int ENCODE_CTYPE_TIMESTAMP(unsigned char *buf, CTYPE_TIMESTAMP *value) {
+	net_store64(buf, (unsigned long long) *value);
+
+	return SV_GET_LENGTH_TIMESTAMP;
+}
+NET_INLINE int ENCODE_CTYPE_ENUM(unsigned char *buf, CTYPE_ENUM *value) {
+	net_store32(buf, (CTYPE_INT32U) *value);			// assuming enum is an int - allows any enum type to be used
+
+	return SV_GET_LENGTH_ENUM;
+}
+NET_INLINE int ENCODE_CTYPE_INT8(unsigned char *buf, CTYPE_INT8 *value) {
+	buf[0] = (unsigned char) *value;
+
+	return SV_GET_LENGTH_INT8;
+}
+NET_INLINE int ENCODE_CTYPE_INT16(unsigned char *buf, CTYPE_INT16 *value) {
+	net_store16(buf, (CTYPE_INT16U) *value);
+
+	return SV_GET_LENGTH_INT16;
+}
+NET_INLINE int ENCODE_CTYPE_INT32(unsigned char *buf, CTYPE_INT32 *value) {
+	net_store32(buf, (CTYPE_INT32U) *value);
+
+	return SV_GET_LENGTH_INT32;
+}
+NET_INLINE int ENCODE_CTYPE_INT8U(unsigned char *buf, CTYPE_INT8U *value) {
+	buf[0] = *value;
+
+	return SV_GET_LENGTH_INT8U;
+}
+NET_INLINE int ENCODE_CTYPE_INT16U(unsigned char *buf, CTYPE_INT16U *value) {
+	net_store16(buf, *value);
+
+	return SV_GET_LENGTH_INT16U;
+}
+NET_INLINE int ENCODE_CTYPE_INT32U(unsigned char *buf, CTYPE_INT32U *value) {
+	net_store32(buf, *value);
+
+	return SV_GET_LENGTH_INT32U;
+}
+NET_INLINE int ENCODE_CTYPE_VISSTRING255(unsigned char *buf, CTYPE_VISSTRING255 *value) {
+	netmemcpy(buf, value, SV_GET_LENGTH_VISSTRING255);
+
+	return SV_GET_LENGTH_VISSTRING255;
+}
+NET_INLINE int ENCODE_CTYPE_BOOLEAN(unsigned char *buf, CTYPE_BOOLEAN *value) {
+	buf[0] = *value;
+
+	return SV_GET_LENGTH_BOOLEAN;
+}
+NET_INLINE int ENCODE_CTYPE_DBPOS(unsigned char *buf, CTYPE_DBPOS *value) {
+	net_store32(buf, (CTYPE_INT32U) *value);
+
+	return SV_GET_LENGTH_DBPOS;
+}
 
 #ifdef __cplusplus /* If this is a C++ compiler, end C linkage */
 }
@@ -35,8 +35,8 @@ int svASDULength(struct svControl *svControl) {
 	len += SV_GET_LENGTH_INT16U + 2;	// smpCnt
 	len += SV_GET_LENGTH_INT32U + 2;	// confRev
 #else
-	len += ber_integer_length((&svControl->ASDU[0].smpCnt), SV_GET_LENGTH_INT16U)/*BER_GET_LENGTH_CTYPE_INT16U(&svControl->ASDU[0].smpCnt)*/ + 2;
-	len += ber_integer_length((&svControl->ASDU[0].confRev), SV_GET_LENGTH_INT32U)/*BER_GET_LENGTH_CTYPE_INT32U(&svControl->ASDU[0].confRev)*/ + 2;
+	len += BER_GET_LENGTH_CTYPE_INT16U(&svControl->ASDU[0].smpCnt) + 2;
+	len += BER_GET_LENGTH_CTYPE_INT32U(&svControl->ASDU[0].confRev) + 2;
 #endif
 	len += SV_GET_LENGTH_BOOLEAN + 2;
 
@@ -86,7 +86,7 @@ int svEncodePacket(struct svControl *svControl, unsigned char *buf) {
 	buf[offset++] = 0x81;	// TPID
 	buf[offset++] = 0x00;
 
-	netmemcpy(&buf[offset], &svControl->ethHeaderData.VLAN_ID, 2);	// TCI
+	net_store16(&buf[offset], svControl->ethHeaderData.VLAN_ID);	// TCI
 	buf[offset] |= (svControl->ethHeaderData.VLAN_PRIORITY << 5);
 	offset += 2;
 #endif
@@ -94,10 +94,10 @@ int svEncodePacket(struct svControl *svControl, unsigned char *buf) {
 	buf[offset++] = 0x88;	// EtherType
 	buf[offset++] = 0xBA;
 
-	netmemcpy(&buf[offset], &svControl->ethHeaderData.APPID, 2);	// APPID
+	net_store16(&buf[offset], svControl->ethHeaderData.APPID);	// APPID
 	offset += 2;
 
-	netmemcpy(&buf[offset], &len, 2);	// length
+	net_store16(&buf[offset], (CTYPE_INT16U) len);	// length
 	offset += 2;
 
 	buf[offset++] = 0x00;	// reserved 1
@@ -109,8 +109,8 @@ int svEncodePacket(struct svControl *svControl, unsigned char *buf) {
 	offset += encodeLength(&buf[offset], svAPDULength(svControl));
 
 	buf[offset++] = SV_TAG_NOASDU;
-	offset += encodeLength(&buf[offset], ber_integer_length(&svControl->noASDU, SV_GET_LENGTH_INT16U));
-	offset += ber_encode_integer(&buf[offset], &svControl->noASDU, ber_integer_length(&svControl->noASDU, SV_GET_LENGTH_INT16U));
+	buf[offset] = ber_encode_integer_int16u(&buf[offset + 1], (CTYPE_INT16U) svControl->noASDU);
+	offset += buf[offset] + 1;
 
 	buf[offset++] = SV_TAG_SEQUENCEOFASDU;
 	offset += encodeLength(&buf[offset], svSeqLength(svControl));
@@ -140,21 +140,21 @@ int svEncodePacket(struct svControl *svControl, unsigned char *buf) {
 		buf[offset++] = SV_TAG_SMPCNT;
 #if SV_FIXED_SMPCNT_CONFREV_SIZE == 1
 		buf[offset++] = SV_GET_LENGTH_INT16U;
-		netmemcpy(&buf[offset], &svControl->ASDU[i].smpCnt, SV_GET_LENGTH_INT16U);
+		net_store16(&buf[offset], svControl->ASDU[i].smpCnt);
 		offset += SV_GET_LENGTH_INT16U;
 #else
-		offset += encodeLength(&buf[offset], ber_integer_length(&svControl->ASDU[i].smpCnt, SV_GET_LENGTH_INT16U));
-		offset += ber_encode_integer(&buf[offset], &svControl->ASDU[i].smpCnt, SV_GET_LENGTH_INT16U);
+		buf[offset] = ber_encode_integer_int16u(&buf[offset + 1], svControl->ASDU[i].smpCnt);	// content is at most 3 bytes, so the length field is one byte
+		offset += buf[offset] + 1;
 #endif
 
 		buf[offset++] = SV_TAG_CONFREV;
 #if SV_FIXED_SMPCNT_CONFREV_SIZE == 1
 		buf[offset++] = SV_GET_LENGTH_INT32U;
-		netmemcpy(&buf[offset], &svControl->ASDU[i].confRev, SV_GET_LENGTH_INT32U);
+		net_store32(&buf[offset], svControl->ASDU[i].confRev);
 		offset += SV_GET_LENGTH_INT32U;
 #else
-		offset += encodeLength(&buf[offset], ber_integer_length(&svControl->ASDU[i].confRev, SV_GET_LENGTH_INT32U));
-		offset += ber_encode_integer(&buf[offset], &svControl->ASDU[i].confRev, SV_GET_LENGTH_INT32U);
+		buf[offset] = ber_encode_integer_int32u(&buf[offset + 1], svControl->ASDU[i].confRev);
+		offset += buf[offset] + 1;
 #endif
 
 #if SV_OPTIONAL_SUPPORTED == 1
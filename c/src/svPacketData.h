@@ -24,10 +24,23 @@
 #include <stdlib.h>
 #include <string.h>
 #include "ctypes.h"
+#include "latency.h"
 
 #define SV_USE_VLAN						1	// set to "1" to insert VLAN tag into SV packets
 #define SV_OPTIONAL_SUPPORTED			0	// set to "1" to enable output of optional items in SV packets (Wireshark does not support these)
 #define SV_FIXED_SMPCNT_CONFREV_SIZE	1	// set to "1" to force smpCnt and confRev field to be fixed size, rather than BER encoded
+#define SV_CONSTANT_FRAME_LAYOUT		1	// set to "1" to publish SV packets from the generated frame image of each control, rather than svEncodePacket()
+
+#if SV_FIXED_SMPCNT_CONFREV_SIZE == 0 || SV_OPTIONAL_SUPPORTED == 1
+#undef SV_CONSTANT_FRAME_LAYOUT
+#define SV_CONSTANT_FRAME_LAYOUT		0	// the generated frame layout assumes fixed-size smpCnt and confRev, and no optional items
+#endif
+
+#if SV_USE_VLAN == 1
+#define SV_FRAME_HEADER_LENGTH			18	// MAC addresses, VLAN tag and EtherType
+#else
+#define SV_FRAME_HEADER_LENGTH			14	// MAC addresses and EtherType
+#endif
 
 #define SV_MAX_DATASET_SIZE 	512//1024
 
@@ -56,6 +69,9 @@ struct svControl {
 	CTYPE_INT16U ASDUCount;				// stores present ASDU count; transmit a packet when equals "noASDU"
 	CTYPE_INT16U sampleCountMaster;
 	int (*update)(unsigned char *buf);	// function pointer to save next ASDU, and possible send SV packet
+#if LATENCY_STATS_SUPPORTED == 1
+	struct latencyStats latency;				// transmit latency of frames sent by this control block
+#endif
 };
 
 #endif
@@ -79,6 +79,9 @@ public class SCDCodeGenerator {
 		CHeader interfaceHeader = new CHeader("interfaceSendPacket.h", "INTERFACE_SEND_PACKET_H");
 
 		dataTypesHeader.addIncludeLocal("ctypes.h");
+		dataTypesHeader.addIncludeLocal("latency.h");
+		dataTypesHeader.addIncludeLocal("seqlock.h");
+		dataTypesHeader.addIncludeLocal("eventQueue.h");
 		svEncodeHeader.addIncludeLocal("svEncodeBasic.h");
 		svEncodeHeader.addIncludeLocal("svPacketData.h");
 		svDecodeHeader.addIncludeLocal("svPacketData.h");
@@ -162,6 +165,11 @@ public class SCDCodeGenerator {
 
 		StringBuilder svDecodeDatasetFunction = new StringBuilder();	// faster than StringBuffer, but not thread-safe
 		StringBuilder gseDecodeDatasetFunction = new StringBuilder();
+		StringBuilder svSnapshotFunctions = new StringBuilder();
+		StringBuilder svFrameDoneFunction = new StringBuilder();
+		StringBuilder svSnapshotPrototypes = new StringBuilder();
+		StringBuilder gseSnapshotFunctions = new StringBuilder();
+		StringBuilder gseSnapshotPrototypes = new StringBuilder();
 		StringBuilder svPacketDataInit = new StringBuilder();
 		StringBuilder gsePacketDataInit = new StringBuilder();
 
@@ -516,6 +524,8 @@ public class SCDCodeGenerator {
 													String svPath = ied.getName() + "." + ap.getName() + "." + ld.getInst() + ".LN0.";
 													
 													iedHeader.appendDatatypes("\t\t\t\tstruct svControl " + svName + ";\n");
+													
+													SVFrameLayout svFrameLayout = new SVFrameLayout(svControl, dataset, dataTypeTemplates, ied.getName() + "_" + ld.getInst() + "_" + svName, map);
 
 													svPacketDataInit.append("\t" + svPath + svName + ".noASDU = " + svControl.getNofASDU() + ";\n");
 													
@@ -536,17 +546,21 @@ public class SCDCodeGenerator {
 																for (int i = 0; i < 6; i++) {
 																	svPacketDataInit.append("\t" + svPath + svName + ".ethHeaderData.destMACAddress[" + i + "] = 0x" + macSplit[i] + ";\n");	// must be big-endian
 																}
+																svFrameLayout.destMACAddress = macSplit;
 															}
 														}
 														else if (p.getType().toString().equals("APPID")) {
 															svPacketDataInit.append("\t" + svPath + svName + ".ethHeaderData.APPID = 0x" + p.getValue() + ";\n");
+															svFrameLayout.APPID = Integer.parseInt(p.getValue(), 16);
 														}
 														else if (p.getType().toString().equals("VLAN-ID")) {
 															svPacketDataInit.append("\t" + svPath + svName + ".ethHeaderData.VLAN_ID = 0x" + p.getValue() + ";\n");
+															svFrameLayout.VLAN_ID = Integer.parseInt(p.getValue(), 16);
 															useDefaultVlanID = false;
 														}
 														else if (p.getType().toString().equals("VLAN-PRIORITY")) {
 															svPacketDataInit.append("\t" + svPath + svName + ".ethHeaderData.VLAN_PRIORITY = 0x" + p.getValue() + ";\n");
+															svFrameLayout.VLAN_PRIORITY = Integer.parseInt(p.getValue(), 16);
 															useDefaultVlanPriority = false;
 														}
 													}
@@ -619,6 +633,10 @@ public class SCDCodeGenerator {
 													
 													svSource.appendFunctions("\tif (++" + svPath + svName + ".ASDUCount == " + svPath + svName + ".noASDU) {\n");
 													svSource.appendFunctions("\t\t" + svPath + svName + ".ASDUCount = 0;\n");
+													if (svFrameLayout.isConstant()) {
+														svSource.appendInstances(svFrameLayout.getDefinitions());
+														svSource.appendFunctions(svFrameLayout.getPublishCode(svPath + svName) + "\n");
+													}
 													svSource.appendFunctions("\t\treturn svEncodePacket(&" + svPath + svName + ", buf);\n");
 													svSource.appendFunctions("\t}\n");
 													svSource.appendFunctions("\n\treturn 0;\n");
@@ -631,7 +649,9 @@ public class SCDCodeGenerator {
 													interfaceSource.appendFunctions("\n" + svUpdateFunctionPrototypeBuf + " {\n");
 													interfaceSource.appendFunctions("\tint len = sv_update_" + ied.getName() + "_" + ld.getInst() + "_" + svName + "(bufOut);\n\n");
 													interfaceSource.appendFunctions("\tif (len > 0) {\n");
-													interfaceSource.appendFunctions("\t\tpcap_sendpacket(fp, bufOut, len);\n");
+													interfaceSource.appendFunctions("\t\tLATENCY_TRANSMIT_START(&" + svPath + svName + ".latency, \"" + svPath + svName + "\");\n");
+													interfaceSource.appendFunctions("\t\tnet_backend_send(netBackend, bufOut, len);\n");
+													interfaceSource.appendFunctions("\t\tLATENCY_TRANSMIT_POLL(netBackend->fd);\n");
 													interfaceSource.appendFunctions("\t}\n\n");
 													interfaceSource.appendFunctions("\treturn len;\n");
 													interfaceSource.appendFunctions("}\n");
@@ -753,7 +773,9 @@ public class SCDCodeGenerator {
 													interfaceSource.appendFunctions("\n" + gseUpdateFunctionPrototypeBuf + " {\n");
 													interfaceSource.appendFunctions("\tint len = gse_send_" + ied.getName() + "_" + ld.getInst() + "_" + gseName + "(bufOut, (CTYPE_BOOLEAN) statusChange, (CTYPE_INT32U) timeAllowedToLive);\n\n");
 													interfaceSource.appendFunctions("\tif (len > 0) {\n");
-													interfaceSource.appendFunctions("\t\tpcap_sendpacket(fp, bufOut, len);\n");
+													interfaceSource.appendFunctions("\t\tLATENCY_TRANSMIT_START(&" + gsePath + gseName + ".latency, \"" + gsePath + gseName + "\");\n");
+													interfaceSource.appendFunctions("\t\tnet_backend_send(netBackend, bufOut, len);\n");
+													interfaceSource.appendFunctions("\t\tLATENCY_TRANSMIT_POLL(netBackend->fd);\n");
 													interfaceSource.appendFunctions("\t}\n\n");
 													interfaceSource.appendFunctions("\treturn len;\n");
 													interfaceSource.appendFunctions("}\n");
@@ -872,7 +894,7 @@ public class SCDCodeGenerator {
 			jsonDataModelIndexSource.appendFunctions("ACSIServer *server" + (i + 1) + ";\n");
 		}
 
-		jsonDataModelIndexSource.appendFunctions("\nvoid init_webservers(mg_handler_t handler, void *(*serve)(void *)) {\n");
+		jsonDataModelIndexSource.appendFunctions("\nvoid init_webservers(mg_handler_t handler, void (*add_server)(ACSIServer *)) {\n");
 		int iedNumber = 1;
 		ieds = root.getSCL().getIED().iterator();
 		while (ieds.hasNext()) {
@@ -893,7 +915,7 @@ public class SCDCodeGenerator {
 			jsonDataModelIndexSource.appendFunctions("\tmg_set_option(server" + iedNumber + "->mg, \"auth_domain\", \"localhost\");\n");
 			jsonDataModelIndexSource.appendFunctions("#endif\n");
 			jsonDataModelIndexSource.appendFunctions("\tmg_add_uri_handler(server" + iedNumber + "->mg, \"/\", handler);\n");
-			jsonDataModelIndexSource.appendFunctions("\tmg_start_thread(serve, server" + iedNumber + "->mg);\n");
+			jsonDataModelIndexSource.appendFunctions("\tadd_server(server" + iedNumber + ");\n");
 			
 			
 			if (ieds.hasNext()) {
@@ -910,7 +932,7 @@ public class SCDCodeGenerator {
 		// process Logical Node Types
 		Iterator<TLNodeType> lnTypes = dataTypeTemplates.getLNodeType().iterator();
 		dataTypesHeader.appendDatatypes("\n\n// logical nodes\n");
-		svDecodeDatasetFunction.append("void svDecodeDataset(unsigned char *dataset, int datasetLength, int ASDU, unsigned char *svID, int svIDLength, CTYPE_INT16U smpCnt) {\n");
+		svDecodeDatasetFunction.append("void svDecodeDataset(unsigned char *dataset, int datasetLength, int ASDU, int totalASDUs, unsigned char *svID, int svIDLength, CTYPE_INT16U smpCnt) {\n");
 		gseDecodeDatasetFunction.append("void gseDecodeDataset(unsigned char *dataset, CTYPE_INT16U datasetLength, unsigned char *gocbRef, CTYPE_INT16U gocbRefLength, CTYPE_INT32U timeAllowedToLive, CTYPE_TIMESTAMP T, CTYPE_INT32U stNum, CTYPE_INT32U sqNum) {\n");
 		
 		while (lnTypes.hasNext()) {
@@ -984,19 +1006,87 @@ public class SCDCodeGenerator {
 																
 																String inputsPath = ied.getName() + "." + ap.getName() + "." + ld.getInst() + "." + ln.getLnType().replaceAll("[^A-Za-z0-9]", "_") + "_" + ln.getInst() + ".sv_inputs_" + svControl.getName() + ".";
 
-																svDecodeDatasetFunction.append("\n\tif (svIDLength == " + svControl.getSmvID().length() + " && strncmp((const char *) svID, \"" + svControl.getSmvID() + "\", svIDLength) == 0) {");
+																String inputsName = ied.getName() + "_" + ld.getInst() + "_" + ln.getLnType().replaceAll("[^A-Za-z0-9]", "_") + "_" + ln.getInst() + "_" + svControl.getName();
+																String seqlock = "&" + inputsPath + "seqlock";
+																String inputs = inputsPath.substring(0, inputsPath.length() - 1);
+
+																if (noASDU > 1) {
+																	// ASDUs beyond the configured number are ignored, rather than overflowing the inputs
+																	svDecodeDatasetFunction.append("\n\tif (svIDLength == " + svControl.getSmvID().length() + " && strncmp((const char *) svID, \"" + svControl.getSmvID() + "\", svIDLength) == 0 && ASDU < " + noASDU + ") {");
+																}
+																else {
+																	svDecodeDatasetFunction.append("\n\tif (svIDLength == " + svControl.getSmvID().length() + " && strncmp((const char *) svID, \"" + svControl.getSmvID() + "\", svIDLength) == 0) {");
+																}
+																if (noASDU > 1) {
+																	// all ASDUs in the frame are published together
+																	svDecodeDatasetFunction.append("\n\t\tif (ASDU == 0) {");
+																	svDecodeDatasetFunction.append("\n\t\t\tSEQLOCK_WRITE_BEGIN(" + seqlock + ");");
+																	svDecodeDatasetFunction.append("\n\t\t}");
+																}
+																else {
+																	svDecodeDatasetFunction.append("\n\t\tSEQLOCK_WRITE_BEGIN(" + seqlock + ");");
+																}
 																svDecodeDatasetFunction.append("\n\t\tdecode_" + datasetName + "(dataset, smpCnt, &" + inputsPath + datasetName + ASDUIndex + ");");
 																svDecodeDatasetFunction.append("\n\t\t" + inputsPath + "smpCnt = smpCnt;");
+																if (noASDU > 1) {
+																	// a frame may have fewer ASDUs than configured; svDecodeFrameDone() ends the write if it is truncated
+																	svDecodeDatasetFunction.append("\n\t\tif (ASDU == totalASDUs - 1 || ASDU == " + (noASDU - 1) + ") {");
+																	svDecodeDatasetFunction.append("\n\t\t\tSEQLOCK_WRITE_END(" + seqlock + ");");
+																	svDecodeDatasetFunction.append("\n\t\t\tEVENT_QUEUE_SV(" + inputsPath + "eventQueue, &" + inputs + ", \"" + inputs + "\", smpCnt);");
+																	svDecodeDatasetFunction.append("\n\t\t}");
+																	svFrameDoneFunction.append("\tSEQLOCK_WRITE_END(" + seqlock + ");\n");
+																}
+																else {
+																	svDecodeDatasetFunction.append("\n\t\tSEQLOCK_WRITE_END(" + seqlock + ");");
+																	svDecodeDatasetFunction.append("\n\t\tEVENT_QUEUE_SV(" + inputsPath + "eventQueue, &" + inputs + ", \"" + inputs + "\", smpCnt);");
+																}
+																if (noASDU > 1) {
+																	// one latency sample per frame, with the decode stamp taken before the first callback
+																	svDecodeDatasetFunction.append("\n\t\tif (ASDU == 0) {");
+																	svDecodeDatasetFunction.append("\n\t\t\tLATENCY_FRAME_DECODED();");
+																	svDecodeDatasetFunction.append("\n\t\t}");
+																}
+																else {
+																	svDecodeDatasetFunction.append("\n\t\tLATENCY_FRAME_DECODED();");
+																}
 																svDecodeDatasetFunction.append("\n\t\tif (" + inputsPath + "datasetDecodeDone != NULL) {");
 																svDecodeDatasetFunction.append("\n\t\t\t" + inputsPath + "datasetDecodeDone(smpCnt);");
 																svDecodeDatasetFunction.append("\n\t\t}");
+																if (noASDU > 1) {
+																	svDecodeDatasetFunction.append("\n\t\tif (ASDU == totalASDUs - 1 || ASDU == " + (noASDU - 1) + ") {");
+																	svDecodeDatasetFunction.append("\n\t\t\tLATENCY_FRAME_DONE(&" + inputsPath + "latency, \"" + inputsPath.substring(0, inputsPath.length() - 1) + "\");");
+																	svDecodeDatasetFunction.append("\n\t\t}");
+																}
+																else {
+																	svDecodeDatasetFunction.append("\n\t\tLATENCY_FRAME_DONE(&" + inputsPath + "latency, \"" + inputsPath.substring(0, inputsPath.length() - 1) + "\");");
+																}
 																svDecodeDatasetFunction.append("\n\t}");
 
 																dataTypesHeader.appendDatatypes("\n\tstruct {");
 																dataTypesHeader.appendDatatypes("\n\t\tstruct " + datasetName + " " + datasetName + noASDUString + ";");
 																dataTypesHeader.appendDatatypes("\n\t\tvoid (*datasetDecodeDone)(CTYPE_INT16U smpCnt);");
 																dataTypesHeader.appendDatatypes("\n\t\tCTYPE_INT16U smpCnt;");
+																dataTypesHeader.appendDatatypes("\n#if LATENCY_STATS_SUPPORTED == 1");
+																dataTypesHeader.appendDatatypes("\n\t\tstruct latencyStats latency;");
+																dataTypesHeader.appendDatatypes("\n#endif");
+																dataTypesHeader.appendDatatypes("\n#if INPUT_SEQLOCK_SUPPORTED == 1");
+																dataTypesHeader.appendDatatypes("\n\t\tstruct seqlock seqlock;");
+																dataTypesHeader.appendDatatypes("\n#endif");
+																dataTypesHeader.appendDatatypes("\n#if EVENT_QUEUE_SUPPORTED == 1");
+																dataTypesHeader.appendDatatypes("\n\t\tstruct eventQueue *eventQueue;");
+																dataTypesHeader.appendDatatypes("\n#endif");
 																dataTypesHeader.appendDatatypes("\n\t} sv_inputs_" + svControl.getName() + ";");
+
+																String snapshotPrototype = "void sv_inputs_snapshot_" + inputsName + "(struct " + datasetName + " *" + datasetName + ", CTYPE_INT16U *smpCnt)";
+																svSnapshotPrototypes.append(snapshotPrototype + ";\n");
+																svSnapshotFunctions.append(snapshotPrototype + " {\n");
+																svSnapshotFunctions.append("\tCTYPE_INT32U sequence = 0;\n\n");
+																svSnapshotFunctions.append("\tdo {\n");
+																svSnapshotFunctions.append("\t\tsequence = SEQLOCK_READ_BEGIN(" + seqlock + ");\n");
+																svSnapshotFunctions.append("\t\tmemcpy(" + datasetName + ", &" + inputsPath + datasetName + ", sizeof(" + inputsPath + datasetName + "));\n");
+																svSnapshotFunctions.append("\t\t*smpCnt = " + inputsPath + "smpCnt;\n");
+																svSnapshotFunctions.append("\t} while (SEQLOCK_READ_RETRY(" + seqlock + ", sequence));\n");
+																svSnapshotFunctions.append("}\n");
 															}
 														}
 														else if (control.eClass() == SclPackage.eINSTANCE.getTGSEControl()) {
@@ -1010,7 +1100,12 @@ public class SCDCodeGenerator {
 																String gocbRef = extRef.getIedName() + extRef.getLdInst() + "/" + ld.getLN0().getLnClass().toString() + "$GO$" + gseControl.getName();
 																String inputsPath = ied.getName() + "." + ap.getName() + "." + ld.getInst() + "." + ((ln.getPrefix() == null) ? "" : ln.getPrefix()) + ln.getLnType().replaceAll("[^A-Za-z0-9]", "_") + "_" + ln.getInst() + ".gse_inputs_" + gseControl.getName() + ".";
 
+																String inputsName = ied.getName() + "_" + ld.getInst() + "_" + ((ln.getPrefix() == null) ? "" : ln.getPrefix()) + ln.getLnType().replaceAll("[^A-Za-z0-9]", "_") + "_" + ln.getInst() + "_" + gseControl.getName();
+																String seqlock = "&" + inputsPath + "seqlock";
+																String inputs = inputsPath.substring(0, inputsPath.length() - 1);
+
 																gseDecodeDatasetFunction.append("\n\tif (gocbRefLength == " + gocbRef.length() + " && strncmp((const char *) gocbRef, \"" + gocbRef + "\", gocbRefLength) == 0) {");
+																gseDecodeDatasetFunction.append("\n\t\tSEQLOCK_WRITE_BEGIN(" + seqlock + ");");
 																gseDecodeDatasetFunction.append("\n\t\tif (stNum != " + inputsPath + "stNum) {");
 																gseDecodeDatasetFunction.append("\n\t\t\tber_decode_" + datasetName + "(dataset, &" + inputsPath + datasetName + ");");
 																gseDecodeDatasetFunction.append("\n\t\t}");
@@ -1018,9 +1113,13 @@ public class SCDCodeGenerator {
 																gseDecodeDatasetFunction.append("\n\t\t" + inputsPath + "T = T;");
 																gseDecodeDatasetFunction.append("\n\t\t" + inputsPath + "stNum = stNum;");
 																gseDecodeDatasetFunction.append("\n\t\t" + inputsPath + "sqNum = sqNum;");
+																gseDecodeDatasetFunction.append("\n\t\tSEQLOCK_WRITE_END(" + seqlock + ");");
+																gseDecodeDatasetFunction.append("\n\t\tEVENT_QUEUE_GSE(" + inputsPath + "eventQueue, &" + inputs + ", \"" + inputs + "\", T, stNum, sqNum);");
+																gseDecodeDatasetFunction.append("\n\t\tLATENCY_FRAME_DECODED();");
 																gseDecodeDatasetFunction.append("\n\t\tif (" + inputsPath + "datasetDecodeDone != NULL) {");
 																gseDecodeDatasetFunction.append("\n\t\t\t" + inputsPath + "datasetDecodeDone(timeAllowedToLive, T, stNum, sqNum);");
 																gseDecodeDatasetFunction.append("\n\t\t}");
+																gseDecodeDatasetFunction.append("\n\t\tLATENCY_FRAME_DONE(&" + inputsPath + "latency, \"" + inputsPath.substring(0, inputsPath.length() - 1) + "\");");
 																gseDecodeDatasetFunction.append("\n\t}");
 
 																dataTypesHeader.appendDatatypes("\n\tstruct {");
@@ -1030,7 +1129,30 @@ public class SCDCodeGenerator {
 																dataTypesHeader.appendDatatypes("\n\t\tCTYPE_TIMESTAMP T;");
 																dataTypesHeader.appendDatatypes("\n\t\tCTYPE_INT32U stNum;");
 																dataTypesHeader.appendDatatypes("\n\t\tCTYPE_INT32U sqNum;");
+																dataTypesHeader.appendDatatypes("\n#if LATENCY_STATS_SUPPORTED == 1");
+																dataTypesHeader.appendDatatypes("\n\t\tstruct latencyStats latency;");
+																dataTypesHeader.appendDatatypes("\n#endif");
+																dataTypesHeader.appendDatatypes("\n#if INPUT_SEQLOCK_SUPPORTED == 1");
+																dataTypesHeader.appendDatatypes("\n\t\tstruct seqlock seqlock;");
+																dataTypesHeader.appendDatatypes("\n#endif");
+																dataTypesHeader.appendDatatypes("\n#if EVENT_QUEUE_SUPPORTED == 1");
+																dataTypesHeader.appendDatatypes("\n\t\tstruct eventQueue *eventQueue;");
+																dataTypesHeader.appendDatatypes("\n#endif");
 																dataTypesHeader.appendDatatypes("\n\t} gse_inputs_" + gseControl.getName() + ";");
+
+																String snapshotPrototype = "void gse_inputs_snapshot_" + inputsName + "(struct " + datasetName + " *" + datasetName + ", CTYPE_INT32U *timeAllowedToLive, CTYPE_TIMESTAMP *T, CTYPE_INT32U *stNum, CTYPE_INT32U *sqNum)";
+																gseSnapshotPrototypes.append(snapshotPrototype + ";\n");
+																gseSnapshotFunctions.append(snapshotPrototype + " {\n");
+																gseSnapshotFunctions.append("\tCTYPE_INT32U sequence = 0;\n\n");
+																gseSnapshotFunctions.append("\tdo {\n");
+																gseSnapshotFunctions.append("\t\tsequence = SEQLOCK_READ_BEGIN(" + seqlock + ");\n");
+																gseSnapshotFunctions.append("\t\tmemcpy(" + datasetName + ", &" + inputsPath + datasetName + ", sizeof(" + inputsPath + datasetName + "));\n");
+																gseSnapshotFunctions.append("\t\t*timeAllowedToLive = " + inputsPath + "timeAllowedToLive;\n");
+																gseSnapshotFunctions.append("\t\t*T = " + inputsPath + "T;\n");
+																gseSnapshotFunctions.append("\t\t*stNum = " + inputsPath + "stNum;\n");
+																gseSnapshotFunctions.append("\t\t*sqNum = " + inputsPath + "sqNum;\n");
+																gseSnapshotFunctions.append("\t} while (SEQLOCK_READ_RETRY(" + seqlock + ", sequence));\n");
+																gseSnapshotFunctions.append("}\n");
 															}
 														}
 													}
@@ -1100,8 +1222,13 @@ public class SCDCodeGenerator {
 		dataTypesHeader.appendFunctionPrototypes("void init_datatypes();\n");
 		svDecodeDatasetFunction.append("\n}\n\n");
 		svDecodeSource.appendFunctions(svDecodeDatasetFunction);
+		svDecodeSource.appendFunctions("void svDecodeFrameDone() {\n");
+		svDecodeSource.appendFunctions(svFrameDoneFunction);
+		svDecodeSource.appendFunctions("}\n\n");
+		svDecodeSource.appendFunctions(svSnapshotFunctions);
 		gseDecodeDatasetFunction.append("\n}\n\n");
 		gseDecodeSource.appendFunctions(gseDecodeDatasetFunction);
+		gseDecodeSource.appendFunctions(gseSnapshotFunctions);
 
 		
 		svSource.appendFunctions("\nvoid init_sv() {\n");
@@ -1116,8 +1243,13 @@ public class SCDCodeGenerator {
 		svEncodeHeader = svEncodeSource.populateHeaderFilePrototypes(svEncodeHeader);
 		gseEncodeHeader = gseEncodeSource.populateHeaderFilePrototypes(gseEncodeHeader);
 		gseDecodeHeader = gseDecodeSource.populateHeaderFilePrototypes(gseDecodeHeader);
-		svDecodeHeader.appendFunctionPrototypes("\nvoid svDecodeDataset(unsigned char *dataset, int datasetLength, int ASDU, unsigned char *svID, int svIDLength, CTYPE_INT16U smpCnt);");
+		svDecodeHeader.appendFunctionPrototypes("\nvoid svDecodeDataset(unsigned char *dataset, int datasetLength, int ASDU, int totalASDUs, unsigned char *svID, int svIDLength, CTYPE_INT16U smpCnt);");
+		svDecodeHeader.appendFunctionPrototypes("\n\n// ends the publication of inputs from a frame which had fewer ASDUs than it declared, e.g., because it was truncated\nvoid svDecodeFrameDone();");
 		gseDecodeHeader.appendFunctionPrototypes("\nvoid gseDecodeDataset(unsigned char *dataset, CTYPE_INT16U datasetLength, unsigned char *gocbRef, CTYPE_INT16U gocbRefLength, CTYPE_INT32U timeAllowedToLive, CTYPE_TIMESTAMP T, CTYPE_INT32U stNum, CTYPE_INT32U sqNum);");
+		svDecodeHeader.appendFunctionPrototypes("\n\n// consistent copies of subscribed inputs, which may be taken from any thread while frames are being decoded (but not\n// from datasetDecodeDone(), which runs on the decoding thread and can read the inputs directly)\n");
+		svDecodeHeader.appendFunctionPrototypes(svSnapshotPrototypes);
+		gseDecodeHeader.appendFunctionPrototypes("\n\n// consistent copies of subscribed inputs, which may be taken from any thread while frames are being decoded (but not\n// from datasetDecodeDone(), which runs on the decoding thread and can read the inputs directly)\n");
+		gseDecodeHeader.appendFunctionPrototypes(gseSnapshotPrototypes);
 		svEncodeHeader.appendFunctionPrototypes("\nint svEncodePacket(struct svControl *svControl, unsigned char *buf);");
 		gseEncodeHeader.appendFunctionPrototypes("int gseEncodePacket(struct gseControl *gseControl, unsigned char *buf);");
 		svHeader.appendFunctionPrototypes("void svDecode(unsigned char *buf, int len);\n");
@@ -0,0 +1,321 @@
+/**
+ * Rapid-prototyping protection schemes with IEC 61850
+ *
+ * Copyright (c) 2014 Steven Blair
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+package rapid61850;
+
+import java.util.HashMap;
+import java.util.Iterator;
+import java.util.Map;
+
+import org.eclipse.emf.ecore.EObject;
+
+import ch.iec._61850._2006.scl.TAbstractDataAttribute;
+import ch.iec._61850._2006.scl.TDAType;
+import ch.iec._61850._2006.scl.TDO;
+import ch.iec._61850._2006.scl.TDOType;
+import ch.iec._61850._2006.scl.TDataSet;
+import ch.iec._61850._2006.scl.TDataTypeTemplates;
+import ch.iec._61850._2006.scl.TFCDA;
+import ch.iec._61850._2006.scl.TSDO;
+import ch.iec._61850._2006.scl.TSampledValueControl;
+
+/**
+ * Pre-calculates the complete frame layout of an SV control block. Everything which defines the layout (svID, noASDU,
+ * dataset size, addressing) is known from the SCD file, so the generated code only needs to store smpCnt, smpSynch and
+ * the samples at constant offsets, and copy the frame image. Assumes SV_FIXED_SMPCNT_CONFREV_SIZE == 1 and
+ * SV_OPTIONAL_SUPPORTED == 0; the VLAN tag is included or omitted by the C preprocessor.
+ */
+public class SVFrameLayout {
+
+	// must match the SV_GET_LENGTH_* values in ctypes.h
+	private static final Map<String, Integer> SV_BASIC_TYPE_LENGTH = new HashMap<String, Integer>();
+	static {
+		SV_BASIC_TYPE_LENGTH.put("CTYPE_FLOAT32", 4);
+		SV_BASIC_TYPE_LENGTH.put("CTYPE_FLOAT64", 8);
+		SV_BASIC_TYPE_LENGTH.put("CTYPE_TIMESTAMP", 8);
+		SV_BASIC_TYPE_LENGTH.put("CTYPE_INT8", 1);
+		SV_BASIC_TYPE_LENGTH.put("CTYPE_INT16", 2);
+		SV_BASIC_TYPE_LENGTH.put("CTYPE_INT32", 4);
+		SV_BASIC_TYPE_LENGTH.put("CTYPE_INT8U", 1);
+		SV_BASIC_TYPE_LENGTH.put("CTYPE_INT16U", 2);
+		SV_BASIC_TYPE_LENGTH.put("CTYPE_INT32U", 4);
+		SV_BASIC_TYPE_LENGTH.put("CTYPE_VISSTRING255", 35);
+		SV_BASIC_TYPE_LENGTH.put("CTYPE_BOOLEAN", 1);
+		SV_BASIC_TYPE_LENGTH.put("CTYPE_ENUM", 4);
+		SV_BASIC_TYPE_LENGTH.put("CTYPE_QUALITY", 4);
+		SV_BASIC_TYPE_LENGTH.put("CTYPE_DBPOS", 4);
+	}
+
+	private static final int SV_SMPCNT_LENGTH = 2;
+	private static final int SV_CONFREV_LENGTH = 4;
+	private static final int SV_SMPSYNCH_LENGTH = 1;
+
+	private TSampledValueControl svControl;
+	private TDataTypeTemplates dataTypeTemplates;
+	private SCDAdditionalMappings map;
+	private String name;
+	private int noASDU;
+
+	public String[] destMACAddress = {"01", "0C", "CD", "04", "00", "00"};
+	public int APPID = 0;
+	public int VLAN_ID = 0;
+	public int VLAN_PRIORITY = 4;
+
+	private int datasetSize;
+	private int asduLength;
+	private int seqLength;
+	private int apduLength;
+
+	public SVFrameLayout(TSampledValueControl svControl, TDataSet dataset, TDataTypeTemplates dataTypeTemplates, String name, SCDAdditionalMappings map) {
+		this.svControl = svControl;
+		this.dataTypeTemplates = dataTypeTemplates;
+		this.map = map;
+		this.name = name;
+		this.noASDU = (int) svControl.getNofASDU();
+
+		this.datasetSize = getEncodedLength(dataset);
+	}
+
+	/**
+	 * Returns true if the frame layout can be fully determined at generation time.
+	 */
+	public boolean isConstant() {
+		return datasetSize > 0 && noASDU <= 127 && svControl.getSmvID().length() <= 127;
+	}
+
+	/**
+	 * Finds the SV-encoded size, in bytes, of any item which may appear in a dataset. Returns -1 if the size is not fixed.
+	 */
+	private int getEncodedLength(EObject obj) {
+		int len = 0;
+
+		if (obj == null) {
+			return -1;
+		}
+		else if (obj instanceof TDataSet) {
+			Iterator<TFCDA> fcdas = ((TDataSet) obj).getFCDA().iterator();
+
+			while (fcdas.hasNext()) {
+				int itemLength = getEncodedLength(map.getDataAttribute(fcdas.next()));
+
+				if (itemLength < 0) {
+					return -1;
+				}
+				len += itemLength;
+			}
+
+			return len;
+		}
+		else if (obj instanceof TDOType || obj instanceof TDAType) {
+			Iterator<EObject> objects = obj.eContents().iterator();
+
+			while (objects.hasNext()) {
+				EObject item = objects.next();
+
+				if (item instanceof TAbstractDataAttribute || item instanceof TDO || item instanceof TSDO) {
+					int itemLength = getEncodedLength(item);
+
+					if (itemLength < 0) {
+						return -1;
+					}
+					len += itemLength;
+				}
+			}
+
+			return len;
+		}
+		else if (obj instanceof TAbstractDataAttribute) {
+			TAbstractDataAttribute da = (TAbstractDataAttribute) obj;
+
+			if (da.getBType().toString().equals("Struct")) {
+				return getEncodedLength(findDAType(da.getType()));
+			}
+			else if (SV_BASIC_TYPE_LENGTH.containsKey(map.getCoderType(da))) {
+				return SV_BASIC_TYPE_LENGTH.get(map.getCoderType(da));
+			}
+		}
+		else if (obj instanceof TDO) {
+			return getEncodedLength(findDOType(((TDO) obj).getType()));
+		}
+		else if (obj instanceof TSDO) {
+			return getEncodedLength(findDOType(((TSDO) obj).getType()));
+		}
+
+		return -1;
+	}
+
+	private TDAType findDAType(String id) {
+		Iterator<TDAType> daTypes = dataTypeTemplates.getDAType().iterator();
+
+		while (daTypes.hasNext()) {
+			TDAType daType = daTypes.next();
+
+			if (daType.getId().equals(id)) {
+				return daType;
+			}
+		}
+
+		return null;
+	}
+
+	private TDOType findDOType(String id) {
+		Iterator<TDOType> doTypes = dataTypeTemplates.getDOType().iterator();
+
+		while (doTypes.hasNext()) {
+			TDOType doType = doTypes.next();
+
+			if (doType.getId().equals(id)) {
+				return doType;
+			}
+		}
+
+		return null;
+	}
+
+	// mirrors getLengthBytes() in encodePacket.c
+	private static int getLengthBytes(int len) {
+		if (len <= 126) {
+			return 1;
+		}
+		else if (len <= 255) {
+			return 2;
+		}
+		else {
+			return 3;
+		}
+	}
+
+	// mirrors encodeLength() in encodePacket.c
+	private static String encodeLength(int len) {
+		if (len <= 126) {
+			return hex(len);
+		}
+		else if (len <= 255) {
+			return "0x81, " + hex(len);
+		}
+		else {
+			return "0x82, " + hex(len >> 8) + ", " + hex(len & 0xFF);
+		}
+	}
+
+	private static String hex(int value) {
+		return String.format("0x%02X", value & 0xFF);
+	}
+
+	private void calculateLengths() {
+		asduLength = svControl.getSmvID().length() + 2;
+		asduLength += SV_SMPCNT_LENGTH + 2;
+		asduLength += SV_CONFREV_LENGTH + 2;
+		asduLength += SV_SMPSYNCH_LENGTH + 2;
+		asduLength += datasetSize + getLengthBytes(datasetSize) + 1;
+
+		seqLength = (asduLength + getLengthBytes(asduLength) + 1) * noASDU;
+		apduLength = seqLength + getLengthBytes(seqLength) + 1 + 3;
+	}
+
+	/**
+	 * Generates the frame image and offset definitions, for the instances section of sv.c.
+	 */
+	public String getDefinitions() {
+		calculateLengths();
+
+		int frameLength = apduLength + getLengthBytes(apduLength) + 9;	// savPdu tag, plus 8 "header" bytes
+		int asduHeaderLength = 1 + getLengthBytes(asduLength);
+		int smpCntOffset = asduHeaderLength + 2 + svControl.getSmvID().length() + 2;
+		int smpSynchOffset = smpCntOffset + SV_SMPCNT_LENGTH + 2 + SV_CONFREV_LENGTH + 2;
+		int dataOffset = smpSynchOffset + SV_SMPSYNCH_LENGTH + 1 + getLengthBytes(datasetSize);
+		int firstASDUOffset = 8 + 1 + getLengthBytes(apduLength) + 3 + 1 + getLengthBytes(seqLength);
+		int asduStride = asduLength + asduHeaderLength;
+		int tci = ((VLAN_PRIORITY & 0x07) << 13) | (VLAN_ID & 0x0FFF);
+		long confRev = svControl.getConfRev();
+		int smpSynch = (svControl.getSmvOpts() != null && svControl.getSmvOpts().isSampleSynchronized()) ? 1 : 0;
+		StringBuilder s = new StringBuilder();
+
+		s.append("\n#define SV_FRAME_LENGTH_" + name + "\t\t\t\t(SV_FRAME_HEADER_LENGTH + " + frameLength + ")\n");
+		s.append("#define SV_FRAME_DATA_SIZE_" + name + "\t\t\t" + datasetSize + "\n");
+		s.append("#define SV_FRAME_SMPCNT_OFFSET_" + name + "(asdu)\t(SV_FRAME_HEADER_LENGTH + " + (firstASDUOffset + smpCntOffset) + " + (asdu) * " + asduStride + ")\n");
+		s.append("#define SV_FRAME_SMPSYNCH_OFFSET_" + name + "(asdu)\t(SV_FRAME_HEADER_LENGTH + " + (firstASDUOffset + smpSynchOffset) + " + (asdu) * " + asduStride + ")\n");
+		s.append("#define SV_FRAME_DATA_OFFSET_" + name + "(asdu)\t\t(SV_FRAME_HEADER_LENGTH + " + (firstASDUOffset + dataOffset) + " + (asdu) * " + asduStride + ")\n\n");
+
+		s.append("static const unsigned char sv_frame_" + name + "[SV_FRAME_LENGTH_" + name + "] = {\n");
+		s.append("\t");
+		for (int i = 0; i < 6; i++) {
+			s.append("0x" + destMACAddress[i].toUpperCase() + ", ");
+		}
+		s.append("\t\t\t\t\t// destination MAC address\n");
+		s.append("\tLOCAL_MAC_ADDRESS_BYTES,\t\t\t\t\t\t\t// source MAC address\n");
+		s.append("#if SV_USE_VLAN == 1\n");
+		s.append("\t0x81, 0x00, " + hex(tci >> 8) + ", " + hex(tci) + ",\t\t\t\t\t\t\t// VLAN tag\n");
+		s.append("#endif\n");
+		s.append("\t0x88, 0xBA,\t\t\t\t\t\t\t\t\t\t// EtherType\n");
+		s.append("\t" + hex(APPID >> 8) + ", " + hex(APPID) + ", " + hex(frameLength >> 8) + ", " + hex(frameLength) + ", 0x00, 0x00, 0x00, 0x00,\t// APPID, length, reserved\n");
+		s.append("\t" + hex(0x60) + ", " + encodeLength(apduLength) + ", " + hex(0x80) + ", 0x01, " + hex(noASDU) + ", " + hex(0xA2) + ", " + encodeLength(seqLength) + ",\t// savPdu, noASDU, sequence of ASDU\n");
+
+		for (int asdu = 0; asdu < noASDU; asdu++) {
+			s.append("\t0x30, " + encodeLength(asduLength) + ", 0x80, " + hex(svControl.getSmvID().length()) + ",");
+			for (int i = 0; i < svControl.getSmvID().length(); i++) {
+				s.append(" " + hex(svControl.getSmvID().charAt(i)) + ",");
+			}
+			s.append(" 0x82, 0x02, 0x00, 0x00, 0x83, 0x04, " + hex((int) (confRev >> 24)) + ", " + hex((int) (confRev >> 16)) + ", " + hex((int) (confRev >> 8)) + ", " + hex((int) confRev) + ",");
+			s.append(" 0x85, 0x01, " + hex(smpSynch) + ", 0x87, " + encodeLength(datasetSize) + ",\t// ASDU " + asdu + "\n");
+
+			for (int i = 0; i < datasetSize; i++) {
+				if (i % 16 == 0) {
+					s.append("\t");
+				}
+				s.append("0x00");
+				if (i < datasetSize - 1 || asdu < noASDU - 1) {
+					s.append(",");
+				}
+				if (i % 16 == 15 || i == datasetSize - 1) {
+					s.append("\n");
+				}
+				else {
+					s.append(" ");
+				}
+			}
+		}
+		s.append("};\n");
+
+		return s.toString();
+	}
+
+	/**
+	 * Generates the code which completes the frame image in buf, given the path to the svControl instance.
+	 */
+	public String getPublishCode(String svControlPath) {
+		StringBuilder s = new StringBuilder();
+
+		s.append("#if SV_CONSTANT_FRAME_LAYOUT == 1\n");
+		s.append("\t\tif (" + svControlPath + ".ASDU[0].data.size == SV_FRAME_DATA_SIZE_" + name + ") {\n");
+		s.append("\t\t\tint i = 0;\n");
+		s.append("\t\t\tmemcpy(buf, sv_frame_" + name + ", SV_FRAME_LENGTH_" + name + ");\n\n");
+		s.append("\t\t\tfor (i = 0; i < " + noASDU + "; i++) {\n");
+		s.append("\t\t\t\tnet_store16(&buf[SV_FRAME_SMPCNT_OFFSET_" + name + "(i)], " + svControlPath + ".ASDU[i].smpCnt);\n");
+		s.append("\t\t\t\tbuf[SV_FRAME_SMPSYNCH_OFFSET_" + name + "(i)] = " + svControlPath + ".ASDU[i].smpSynch;\n");
+		s.append("\t\t\t\tmemcpy(&buf[SV_FRAME_DATA_OFFSET_" + name + "(i)], " + svControlPath + ".ASDU[i].data.data, SV_FRAME_DATA_SIZE_" + name + ");\n");
+		s.append("\t\t\t}\n\n");
+		s.append("\t\t\treturn SV_FRAME_LENGTH_" + name + ";\n");
+		s.append("\t\t}\n");
+		s.append("#endif\n");
+
+		return s.toString();
+	}
+}